@@ -1,8 +1,17 @@
 
 #include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #define GEOS_USE_ONLY_R_API
 #include <geoarrow.h>
@@ -14,996 +23,6745 @@ const char* GeoArrowGEOSVersionGEOS(void) { return GEOSversion(); }
 
 const char* GeoArrowGEOSVersionGeoArrow(void) { return GeoArrowVersion(); }
 
-struct GeoArrowGEOSArrayBuilder {
-  GEOSContextHandle_t handle;
-  struct GeoArrowError error;
-  struct GeoArrowBuilder builder;
-  struct GeoArrowWKTWriter wkt_writer;
-  struct GeoArrowWKBWriter wkb_writer;
-  struct GeoArrowVisitor v;
-  struct GeoArrowCoordView coords_view;
-  double* coords;
-};
+// Returns the ARROW:extension:name of schema or a view with size_bytes -1
+static struct GeoArrowStringView GeoArrowGEOSSchemaExtensionName(
+    const struct ArrowSchema* schema) {
+  struct GeoArrowStringView out;
+  out.data = NULL;
+  out.size_bytes = -1;
 
-GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderCreate(
-    GEOSContextHandle_t handle, struct ArrowSchema* schema,
-    struct GeoArrowGEOSArrayBuilder** out) {
-  struct GeoArrowGEOSArrayBuilder* builder =
-      (struct GeoArrowGEOSArrayBuilder*)malloc(sizeof(struct GeoArrowGEOSArrayBuilder));
-  if (builder == NULL) {
-    *out = NULL;
-    return ENOMEM;
+  const char* metadata = schema->metadata;
+  if (metadata == NULL) {
+    return out;
   }
 
-  memset(builder, 0, sizeof(struct GeoArrowGEOSArrayBuilder));
-  *out = builder;
+  int32_t n_pairs;
+  memcpy(&n_pairs, metadata, sizeof(int32_t));
+  metadata += sizeof(int32_t);
+
+  for (int32_t i = 0; i < n_pairs; i++) {
+    int32_t key_size;
+    memcpy(&key_size, metadata, sizeof(int32_t));
+    metadata += sizeof(int32_t);
+    const char* key = metadata;
+    metadata += key_size;
+
+    int32_t value_size;
+    memcpy(&value_size, metadata, sizeof(int32_t));
+    metadata += sizeof(int32_t);
+
+    if (key_size == 20 && strncmp(key, "ARROW:extension:name", 20) == 0) {
+      out.data = metadata;
+      out.size_bytes = value_size;
+      return out;
+    }
 
-  struct GeoArrowSchemaView schema_view;
-  GEOARROW_RETURN_NOT_OK(GeoArrowSchemaViewInit(&schema_view, schema, &builder->error));
-  switch (schema_view.type) {
-    case GEOARROW_TYPE_WKT:
-      GEOARROW_RETURN_NOT_OK(GeoArrowWKTWriterInit(&builder->wkt_writer));
-      GeoArrowWKTWriterInitVisitor(&builder->wkt_writer, &builder->v);
+    metadata += value_size;
+  }
+
+  return out;
+}
+
+static int GeoArrowGEOSStringViewEquals(struct GeoArrowStringView value,
+                                        const char* expected) {
+  return value.size_bytes == (int64_t)strlen(expected) &&
+         strncmp(value.data, expected, value.size_bytes) == 0;
+}
+
+// Resolves the type of native storage from its structure (rather than its
+// extension metadata), treating large lists like lists. If dimensions are
+// unknown they are inferred from the coordinate field names. The levels whose
+// offsets are 64-bit are set in large_levels.
+static GeoArrowErrorCode GeoArrowGEOSNativeSchemaType(
+    struct ArrowSchema* schema, enum GeoArrowGeometryType geometry_type,
+    enum GeoArrowDimensions dimensions, enum GeoArrowType* out, int* large_levels) {
+  int n_lists;
+  switch (geometry_type) {
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      n_lists = 0;
       break;
-    case GEOARROW_TYPE_WKB:
-      GEOARROW_RETURN_NOT_OK(GeoArrowWKBWriterInit(&builder->wkb_writer));
-      GeoArrowWKBWriterInitVisitor(&builder->wkb_writer, &builder->v);
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+      n_lists = 1;
       break;
-    default:
-      GEOARROW_RETURN_NOT_OK(
-          GeoArrowBuilderInitFromSchema(&builder->builder, schema, &builder->error));
-      GEOARROW_RETURN_NOT_OK(GeoArrowBuilderInitVisitor(&builder->builder, &builder->v));
+    case GEOARROW_GEOMETRY_TYPE_POLYGON:
+    case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+      n_lists = 2;
+      break;
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+      n_lists = 3;
       break;
+    default:
+      return ENOTSUP;
   }
 
-  builder->handle = handle;
-  builder->v.error = &builder->error;
-  return GEOARROW_OK;
-}
-
-static GeoArrowErrorCode GeoArrowGEOSArrayBuilderEnsureCoords(
-    struct GeoArrowGEOSArrayBuilder* builder, uint32_t n_coords, int n_dims) {
-  int64_t n_required = n_coords * n_dims;
-  int64_t n_current = builder->coords_view.n_coords * builder->coords_view.n_values;
-  if (n_required > n_current) {
-    if ((n_current * 2) > n_required) {
-      n_required = n_current * 2;
+  *large_levels = 0;
+  struct ArrowSchema* coord_schema = schema;
+  for (int i = 0; i < n_lists; i++) {
+    if (strcmp(coord_schema->format, "+L") == 0) {
+      *large_levels |= 1 << i;
+    } else if (strcmp(coord_schema->format, "+l") != 0) {
+      return EINVAL;
     }
 
-    builder->coords = (double*)realloc(builder->coords, n_required * sizeof(double));
-    if (builder->coords == NULL) {
-      builder->coords_view.n_coords = 0;
-      return ENOMEM;
+    if (coord_schema->n_children != 1) {
+      return EINVAL;
     }
+
+    coord_schema = coord_schema->children[0];
   }
 
-  builder->coords_view.n_coords = n_coords;
-  builder->coords_view.n_values = n_dims;
-  builder->coords_view.coords_stride = n_dims;
-  for (int i = 0; i < n_dims; i++) {
-    builder->coords_view.values[i] = builder->coords + i;
+  enum GeoArrowCoordType coord_type;
+  int64_t n_dims;
+  const char* last_name;
+  if (strcmp(coord_schema->format, "+s") == 0 && coord_schema->n_children > 0) {
+    coord_type = GEOARROW_COORD_TYPE_SEPARATE;
+    n_dims = coord_schema->n_children;
+    last_name = coord_schema->children[n_dims - 1]->name;
+  } else if (strncmp(coord_schema->format, "+w:", 3) == 0 &&
+             coord_schema->n_children == 1) {
+    coord_type = GEOARROW_COORD_TYPE_INTERLEAVED;
+    n_dims = strtol(coord_schema->format + 3, NULL, 10);
+    last_name = coord_schema->children[0]->name;
+  } else {
+    return EINVAL;
+  }
+
+  if (dimensions == GEOARROW_DIMENSIONS_UNKNOWN) {
+    // "m" for separate or "xym" for interleaved coordinates
+    int has_m = last_name != NULL && strlen(last_name) > 0 &&
+                last_name[strlen(last_name) - 1] == 'm';
+    switch (n_dims) {
+      case 2:
+        dimensions = GEOARROW_DIMENSIONS_XY;
+        break;
+      case 3:
+        dimensions = has_m ? GEOARROW_DIMENSIONS_XYM : GEOARROW_DIMENSIONS_XYZ;
+        break;
+      case 4:
+        dimensions = GEOARROW_DIMENSIONS_XYZM;
+        break;
+      default:
+        return EINVAL;
+    }
   }
 
+  *out = GeoArrowMakeType(geometry_type, dimensions, coord_type);
   return GEOARROW_OK;
 }
 
-void GeoArrowGEOSArrayBuilderDestroy(struct GeoArrowGEOSArrayBuilder* builder) {
-  if (builder->coords != NULL) {
-    free(builder->coords);
+// Resolves the 32-bit equivalent of a schema that uses large types. Returns
+// ENOTSUP for anything else, which geoarrow-c should handle itself.
+static GeoArrowErrorCode GeoArrowGEOSLargeSchemaType(struct ArrowSchema* schema,
+                                                     enum GeoArrowType* out,
+                                                     int* large_levels) {
+  struct GeoArrowStringView extension_name = GeoArrowGEOSSchemaExtensionName(schema);
+  if (GeoArrowGEOSStringViewEquals(extension_name, "geoarrow.wkb") &&
+      strcmp(schema->format, "Z") == 0) {
+    *out = GEOARROW_TYPE_WKB;
+    *large_levels = 1;
+    return GEOARROW_OK;
+  } else if (GeoArrowGEOSStringViewEquals(extension_name, "geoarrow.wkt") &&
+             strcmp(schema->format, "U") == 0) {
+    *out = GEOARROW_TYPE_WKT;
+    *large_levels = 1;
+    return GEOARROW_OK;
   }
 
-  if (builder->builder.private_data != NULL) {
-    GeoArrowBuilderReset(&builder->builder);
+  static const char* kNativeNames[] = {
+      "geoarrow.point",      "geoarrow.linestring",      "geoarrow.polygon",
+      "geoarrow.multipoint", "geoarrow.multilinestring", "geoarrow.multipolygon"};
+  for (int i = 0; i < 6; i++) {
+    if (!GeoArrowGEOSStringViewEquals(extension_name, kNativeNames[i])) {
+      continue;
+    }
+
+    GeoArrowErrorCode result = GeoArrowGEOSNativeSchemaType(
+        schema, (enum GeoArrowGeometryType)(i + 1), GEOARROW_DIMENSIONS_UNKNOWN, out,
+        large_levels);
+    if (result != GEOARROW_OK || *large_levels == 0) {
+      return ENOTSUP;
+    }
+
+    return GEOARROW_OK;
   }
 
-  if (builder->wkt_writer.private_data != NULL) {
-    GeoArrowWKTWriterReset(&builder->wkt_writer);
+  return ENOTSUP;
+}
+
+// Returns the size of binary ARROW:extension:metadata-style metadata
+static int64_t GeoArrowGEOSMetadataSize(const char* metadata) {
+  if (metadata == NULL) {
+    return 0;
   }
 
-  if (builder->wkb_writer.private_data != NULL) {
-    GeoArrowWKBWriterReset(&builder->wkb_writer);
+  int32_t n_pairs;
+  memcpy(&n_pairs, metadata, sizeof(int32_t));
+  int64_t size = sizeof(int32_t);
+  for (int32_t i = 0; i < (n_pairs * 2); i++) {
+    int32_t item_size;
+    memcpy(&item_size, metadata + size, sizeof(int32_t));
+    size += sizeof(int32_t) + item_size;
   }
 
-  free(builder);
+  return size;
 }
 
-const char* GeoArrowGEOSArrayBuilderGetLastError(
-    struct GeoArrowGEOSArrayBuilder* builder) {
-  return builder->error.message;
-}
+static void GeoArrowGEOSSchemaRelease(struct ArrowSchema* schema) {
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    if (schema->children[i]->release != NULL) {
+      schema->children[i]->release(schema->children[i]);
+    }
 
-GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinish(
-    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
-  if (builder->wkt_writer.private_data != NULL) {
-    return GeoArrowWKTWriterFinish(&builder->wkt_writer, out, &builder->error);
-  } else if (builder->wkb_writer.private_data != NULL) {
-    return GeoArrowWKBWriterFinish(&builder->wkb_writer, out, &builder->error);
-  } else if (builder->builder.private_data != NULL) {
-    return GeoArrowBuilderFinish(&builder->builder, out, &builder->error);
-  } else {
-    GeoArrowErrorSet(&builder->error, "Invalid state");
-    return EINVAL;
+    free(schema->children[i]);
   }
+
+  free(schema->children);
+  free((void*)schema->format);
+  free((void*)schema->name);
+  free((void*)schema->metadata);
+  schema->release = NULL;
 }
 
-static GeoArrowErrorCode VisitCoords(struct GeoArrowGEOSArrayBuilder* builder,
-                                     const GEOSCoordSequence* seq,
-                                     struct GeoArrowVisitor* v) {
-  unsigned int size = 0;
-  int result = GEOSCoordSeq_getSize_r(builder->handle, seq, &size);
-  if (result == 0) {
-    GeoArrowErrorSet(v->error, "GEOSCoordSeq_getSize_r() failed");
-    return ENOMEM;
+static char* GeoArrowGEOSStrdup(const char* value) {
+  if (value == NULL) {
+    return NULL;
   }
 
-  if (size == 0) {
-    return GEOARROW_OK;
+  char* out = (char*)malloc(strlen(value) + 1);
+  if (out != NULL) {
+    memcpy(out, value, strlen(value) + 1);
   }
 
-  unsigned int dims = 0;
-  result = GEOSCoordSeq_getDimensions_r(builder->handle, seq, &dims);
-  if (result == 0) {
-    GeoArrowErrorSet(v->error, "GEOSCoordSeq_getDimensions_r() failed");
+  return out;
+}
+
+// Copies src into out, switching string, binary, and list types to their
+// large (if large is nonzero) or 32-bit equivalent
+static GeoArrowErrorCode GeoArrowGEOSSchemaCopy(const struct ArrowSchema* src, int large,
+                                                struct ArrowSchema* out) {
+  memset(out, 0, sizeof(struct ArrowSchema));
+  out->release = &GeoArrowGEOSSchemaRelease;
+
+  const char* format = src->format;
+  if (strcmp(format, "z") == 0 || strcmp(format, "Z") == 0) {
+    format = large ? "Z" : "z";
+  } else if (strcmp(format, "u") == 0 || strcmp(format, "U") == 0) {
+    format = large ? "U" : "u";
+  } else if (strcmp(format, "+l") == 0 || strcmp(format, "+L") == 0) {
+    format = large ? "+L" : "+l";
+  }
+
+  out->format = GeoArrowGEOSStrdup(format);
+  out->name = GeoArrowGEOSStrdup(src->name);
+  out->flags = src->flags;
+  if (out->format == NULL || (src->name != NULL && out->name == NULL)) {
+    out->release(out);
     return ENOMEM;
   }
 
-  // Make sure we have enough space to copy the coordinates into
-  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderEnsureCoords(builder, size, dims));
+  int64_t metadata_size = GeoArrowGEOSMetadataSize(src->metadata);
+  if (metadata_size > 0) {
+    out->metadata = (const char*)malloc(metadata_size);
+    if (out->metadata == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
 
-  // Not sure exactly how M coordinates work in GEOS yet
-  result =
-      GEOSCoordSeq_copyToBuffer_r(builder->handle, seq, builder->coords, dims == 3, 0);
-  if (result == 0) {
-    GeoArrowErrorSet(v->error, "GEOSCoordSeq_copyToBuffer_r() failed");
-    return ENOMEM;
+    memcpy((void*)out->metadata, src->metadata, metadata_size);
   }
 
-  // Call the visitor method
-  GEOARROW_RETURN_NOT_OK(v->coords(v, &builder->coords_view));
+  if (src->n_children > 0) {
+    out->children =
+        (struct ArrowSchema**)calloc(src->n_children, sizeof(struct ArrowSchema*));
+    if (out->children == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
+
+    for (int64_t i = 0; i < src->n_children; i++) {
+      out->children[i] = (struct ArrowSchema*)malloc(sizeof(struct ArrowSchema));
+      if (out->children[i] == NULL) {
+        out->release(out);
+        return ENOMEM;
+      }
+
+      out->n_children++;
+      GeoArrowErrorCode result =
+          GeoArrowGEOSSchemaCopy(src->children[i], large, out->children[i]);
+      if (result != GEOARROW_OK) {
+        out->release(out);
+        return result;
+      }
+    }
+  }
 
   return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode VisitGeometry(struct GeoArrowGEOSArrayBuilder* builder,
-                                       const GEOSGeometry* geom,
-                                       struct GeoArrowVisitor* v) {
-  if (geom == NULL) {
-    GEOARROW_RETURN_NOT_OK(v->null_feat(v));
-    return GEOARROW_OK;
+// Memory for scratch space and output buffers comes from the allocator
+// supplied at creation time or, if that is NULL, from malloc()/realloc()/free()
+static void* GeoArrowGEOSMalloc(struct GeoArrowGEOSAllocator* allocator, int64_t size) {
+  if (allocator == NULL) {
+    return malloc(size);
   }
 
-  int type_id = GEOSGeomTypeId_r(builder->handle, geom);
-  int coord_dimension = GEOSGeom_getCoordinateDimension_r(builder->handle, geom);
+  return allocator->allocate(allocator, size, GEOARROW_GEOS_ALIGNMENT);
+}
 
-  enum GeoArrowGeometryType geoarrow_type = GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-  enum GeoArrowDimensions geoarrow_dims = GEOARROW_DIMENSIONS_UNKNOWN;
+static void GeoArrowGEOSFree(struct GeoArrowGEOSAllocator* allocator, void* ptr,
+                             int64_t size) {
+  if (allocator == NULL) {
+    free(ptr);
+  } else if (ptr != NULL) {
+    allocator->deallocate(allocator, ptr, size, GEOARROW_GEOS_ALIGNMENT);
+  }
+}
 
-  // Not sure how M dimensions work yet
-  switch (coord_dimension) {
-    case 2:
-      geoarrow_dims = GEOARROW_DIMENSIONS_XY;
-      break;
-    case 3:
-      geoarrow_dims = GEOARROW_DIMENSIONS_XYZ;
-      break;
-    default:
-      GeoArrowErrorSet(v->error, "Unexpected GEOSGeom_getCoordinateDimension_r: %d",
-                       coord_dimension);
-      return EINVAL;
+// Like realloc() (i.e., on failure ptr is left as is). Allocators can't grow
+// memory in place, so with one the first min(old_size, new_size) bytes are
+// copied to a new allocation.
+static void* GeoArrowGEOSRealloc(struct GeoArrowGEOSAllocator* allocator, void* ptr,
+                                 int64_t old_size, int64_t new_size) {
+  if (allocator == NULL) {
+    return realloc(ptr, new_size);
   }
 
-  switch (type_id) {
-    case GEOS_POINT:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_POINT;
-      break;
-    case GEOS_LINESTRING:
-    case GEOS_LINEARRING:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_LINESTRING;
-      break;
-    case GEOS_POLYGON:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_POLYGON;
-      break;
-    case GEOS_MULTIPOINT:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTIPOINT;
-      break;
-    case GEOS_MULTILINESTRING:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTILINESTRING;
-      break;
-    case GEOS_MULTIPOLYGON:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON;
-      break;
-    case GEOS_GEOMETRYCOLLECTION:
-      geoarrow_type = GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
-      break;
-    default:
-      GeoArrowErrorSet(v->error, "Unexpected GEOSGeomTypeId: %d", type_id);
-      return EINVAL;
+  void* new_ptr = allocator->allocate(allocator, new_size, GEOARROW_GEOS_ALIGNMENT);
+  if (new_ptr == NULL) {
+    return NULL;
   }
 
-  GEOARROW_RETURN_NOT_OK(v->geom_start(v, geoarrow_type, geoarrow_dims));
+  if (ptr != NULL) {
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    allocator->deallocate(allocator, ptr, old_size, GEOARROW_GEOS_ALIGNMENT);
+  }
 
-  switch (type_id) {
-    case GEOS_POINT:
-    case GEOS_LINESTRING:
-    case GEOS_LINEARRING: {
-      const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, geom);
-      if (seq == NULL) {
-        GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
-        return ENOMEM;
-      }
+  return new_ptr;
+}
 
-      GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
-      break;
-    }
+// A growable buffer whose memory can be handed off to an ArrowArray
+struct GeoArrowGEOSBuffer {
+  uint8_t* data;
+  int64_t size_bytes;
+  int64_t capacity_bytes;
+  struct GeoArrowGEOSAllocator* allocator;
+};
 
-    case GEOS_POLYGON: {
-      if (GEOSisEmpty_r(builder->handle, geom)) {
-        break;
-      }
+static GeoArrowErrorCode GeoArrowGEOSBufferReserve(struct GeoArrowGEOSBuffer* buffer,
+                                                   int64_t additional_bytes) {
+  int64_t min_capacity = buffer->size_bytes + additional_bytes;
+  if (min_capacity <= buffer->capacity_bytes) {
+    return GEOARROW_OK;
+  }
 
-      const GEOSGeometry* ring = GEOSGetExteriorRing_r(builder->handle, geom);
-      if (ring == NULL) {
-        GeoArrowErrorSet(v->error, "GEOSGetExteriorRing_r() failed");
-        return ENOMEM;
-      }
+  int64_t new_capacity = buffer->capacity_bytes * 2;
+  if (new_capacity < min_capacity) {
+    new_capacity = min_capacity;
+  }
 
-      GEOARROW_RETURN_NOT_OK(v->ring_start(v));
-      const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, ring);
-      if (seq == NULL) {
-        GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
-        return ENOMEM;
-      }
+  if (new_capacity < 64) {
+    new_capacity = 64;
+  }
 
-      GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
-      GEOARROW_RETURN_NOT_OK(v->ring_end(v));
+  uint8_t* data = (uint8_t*)GeoArrowGEOSRealloc(buffer->allocator, buffer->data,
+                                                buffer->capacity_bytes, new_capacity);
+  if (data == NULL) {
+    return ENOMEM;
+  }
 
-      int size = GEOSGetNumInteriorRings_r(builder->handle, geom);
-      for (int i = 0; i < size; i++) {
-        ring = GEOSGetInteriorRingN_r(builder->handle, geom, i);
-        if (ring == NULL) {
-          GeoArrowErrorSet(v->error, "GEOSGetInteriorRingN_r() failed");
-          return ENOMEM;
-        }
+  buffer->data = data;
+  buffer->capacity_bytes = new_capacity;
+  return GEOARROW_OK;
+}
 
-        GEOARROW_RETURN_NOT_OK(v->ring_start(v));
-        seq = GEOSGeom_getCoordSeq_r(builder->handle, ring);
-        if (seq == NULL) {
-          GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
-          return ENOMEM;
-        }
+// Like GeoArrowGEOSBufferReserve() but without over-allocating, for when the
+// final size is known
+static GeoArrowErrorCode GeoArrowGEOSBufferReserveExact(struct GeoArrowGEOSBuffer* buffer,
+                                                        int64_t additional_bytes) {
+  int64_t min_capacity = buffer->size_bytes + additional_bytes;
+  if (min_capacity <= buffer->capacity_bytes) {
+    return GEOARROW_OK;
+  }
 
-        GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
-        GEOARROW_RETURN_NOT_OK(v->ring_end(v));
-      }
+  uint8_t* data = (uint8_t*)GeoArrowGEOSRealloc(buffer->allocator, buffer->data,
+                                                buffer->capacity_bytes, min_capacity);
+  if (data == NULL) {
+    return ENOMEM;
+  }
 
+  buffer->data = data;
+  buffer->capacity_bytes = min_capacity;
+  return GEOARROW_OK;
+}
+
+static void GeoArrowGEOSBufferReset(struct GeoArrowGEOSBuffer* buffer) {
+  GeoArrowGEOSFree(buffer->allocator, buffer->data, buffer->capacity_bytes);
+  buffer->data = NULL;
+  buffer->size_bytes = 0;
+  buffer->capacity_bytes = 0;
+}
+
+// Counters kept by readers and builders. Phases are only timed when
+// collect_timings is set.
+struct GeoArrowGEOSPerf {
+  struct GeoArrowGEOSCounters counters;
+  int collect_timings;
+};
+
+static int64_t GeoArrowGEOSClockNs(void) {
+  struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static inline int64_t GeoArrowGEOSPerfStart(const struct GeoArrowGEOSPerf* perf) {
+  return perf->collect_timings ? GeoArrowGEOSClockNs() : 0;
+}
+
+static inline void GeoArrowGEOSPerfStop(struct GeoArrowGEOSPerf* perf, int64_t start,
+                                        int64_t* ns) {
+  if (perf->collect_timings) {
+    *ns += GeoArrowGEOSClockNs() - start;
+  }
+}
+
+static void GeoArrowGEOSCountersAdd(struct GeoArrowGEOSCounters* counters,
+                                    const struct GeoArrowGEOSCounters* other) {
+  counters->n_features += other->n_features;
+  counters->n_coords += other->n_coords;
+  counters->n_geos_objects += other->n_geos_objects;
+  counters->n_scratch_reallocs += other->n_scratch_reallocs;
+  counters->n_coords_reallocs += other->n_coords_reallocs;
+  counters->bytes_produced += other->bytes_produced;
+  counters->ns_total += other->ns_total;
+  counters->ns_parse += other->ns_parse;
+  counters->ns_coords += other->ns_coords;
+  counters->ns_alloc += other->ns_alloc;
+  counters->ns_finish += other->ns_finish;
+}
+
+// Spans are compiled out unless GEOARROW_GEOS_ENABLE_TRACING is defined, in
+// which case they cost a NULL check when no tracer is set. Compiled-out spans
+// still consume their arguments so that callers don't need to.
+#define GEOARROW_GEOS_TRACE_UNUSED(TRACER, NAME, INDEX, SIZE) \
+  do {                                                        \
+    (void)(TRACER);                                           \
+    (void)(NAME);                                             \
+    (void)(INDEX);                                            \
+    (void)(SIZE);                                             \
+  } while (0)
+
+#if defined(GEOARROW_GEOS_ENABLE_TRACING)
+#define GEOARROW_GEOS_TRACE_BEGIN(TRACER, NAME, INDEX, SIZE)                    \
+  do {                                                                          \
+    if ((TRACER) != NULL) {                                                     \
+      (TRACER)->span_begin((TRACER), (NAME), (int64_t)(INDEX), (int64_t)(SIZE)); \
+    }                                                                           \
+  } while (0)
+#define GEOARROW_GEOS_TRACE_END(TRACER, NAME, INDEX, SIZE)                    \
+  do {                                                                        \
+    if ((TRACER) != NULL) {                                                   \
+      (TRACER)->span_end((TRACER), (NAME), (int64_t)(INDEX), (int64_t)(SIZE)); \
+    }                                                                         \
+  } while (0)
+#else
+#define GEOARROW_GEOS_TRACE_BEGIN(TRACER, NAME, INDEX, SIZE) \
+  GEOARROW_GEOS_TRACE_UNUSED(TRACER, NAME, INDEX, SIZE)
+#define GEOARROW_GEOS_TRACE_END(TRACER, NAME, INDEX, SIZE) \
+  GEOARROW_GEOS_TRACE_UNUSED(TRACER, NAME, INDEX, SIZE)
+#endif
+
+// Chrome trace event sink. Events are written as they arrive (under a lock so
+// that workers of parallel calls can share the sink); each thread gets a small
+// integer id the first time it writes an event.
+struct GeoArrowGEOSChromeTracer {
+  FILE* file;
+  pthread_mutex_t lock;
+  int64_t start_ns;
+  int64_t n_events;
+};
+
+#if defined(_MSC_VER)
+#define GEOARROW_GEOS_THREAD_LOCAL __declspec(thread)
+#else
+#define GEOARROW_GEOS_THREAD_LOCAL _Thread_local
+#endif
+
+static int GeoArrowGEOSChromeThreadId(void) {
+  static pthread_mutex_t next_lock = PTHREAD_MUTEX_INITIALIZER;
+  static int next_id = 1;
+  static GEOARROW_GEOS_THREAD_LOCAL int thread_id = 0;
+  if (thread_id == 0) {
+    pthread_mutex_lock(&next_lock);
+    thread_id = next_id++;
+    pthread_mutex_unlock(&next_lock);
+  }
+
+  return thread_id;
+}
+
+static void GeoArrowGEOSChromeTracerWrite(struct GeoArrowGEOSTracer* tracer,
+                                          const char* phase, const char* name,
+                                          int64_t index, int64_t size) {
+  struct GeoArrowGEOSChromeTracer* private_data =
+      (struct GeoArrowGEOSChromeTracer*)tracer->private_data;
+  int64_t ts_ns = GeoArrowGEOSClockNs() - private_data->start_ns;
+  int tid = GeoArrowGEOSChromeThreadId();
+
+  pthread_mutex_lock(&private_data->lock);
+  fprintf(private_data->file,
+          "%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+          "\"args\":{\"index\":%lld,\"size\":%lld}}",
+          private_data->n_events > 0 ? "," : "", name, phase, ts_ns / 1000.0, tid,
+          (long long)index, (long long)size);
+  private_data->n_events++;
+  pthread_mutex_unlock(&private_data->lock);
+}
+
+static void GeoArrowGEOSChromeTracerBegin(struct GeoArrowGEOSTracer* tracer,
+                                          const char* name, int64_t index,
+                                          int64_t size) {
+  GeoArrowGEOSChromeTracerWrite(tracer, "B", name, index, size);
+}
+
+static void GeoArrowGEOSChromeTracerEnd(struct GeoArrowGEOSTracer* tracer,
+                                        const char* name, int64_t index, int64_t size) {
+  GeoArrowGEOSChromeTracerWrite(tracer, "E", name, index, size);
+}
+
+static void GeoArrowGEOSChromeTracerRelease(struct GeoArrowGEOSTracer* tracer) {
+  struct GeoArrowGEOSChromeTracer* private_data =
+      (struct GeoArrowGEOSChromeTracer*)tracer->private_data;
+  fputs("\n]\n", private_data->file);
+  fclose(private_data->file);
+  pthread_mutex_destroy(&private_data->lock);
+  free(private_data);
+  tracer->release = NULL;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSTracerInitChrome(struct GeoArrowGEOSTracer* tracer,
+                                                   const char* path) {
+  struct GeoArrowGEOSChromeTracer* private_data =
+      (struct GeoArrowGEOSChromeTracer*)malloc(sizeof(struct GeoArrowGEOSChromeTracer));
+  if (private_data == NULL) {
+    return ENOMEM;
+  }
+
+  private_data->file = fopen(path, "w");
+  if (private_data->file == NULL) {
+    free(private_data);
+    return errno != 0 ? errno : EINVAL;
+  }
+
+  if (pthread_mutex_init(&private_data->lock, NULL) != 0) {
+    fclose(private_data->file);
+    free(private_data);
+    return ENOMEM;
+  }
+
+  fputs("[", private_data->file);
+  private_data->start_ns = GeoArrowGEOSClockNs();
+  private_data->n_events = 0;
+
+  tracer->span_begin = &GeoArrowGEOSChromeTracerBegin;
+  tracer->span_end = &GeoArrowGEOSChromeTracerEnd;
+  tracer->release = &GeoArrowGEOSChromeTracerRelease;
+  tracer->private_data = private_data;
+  return GEOARROW_OK;
+}
+
+// The index and message of each feature that was replaced by a null in
+// GEOARROW_GEOS_ON_ERROR_NULL mode
+struct GeoArrowGEOSFeatureErrors {
+  int64_t size;
+  int64_t capacity;
+  int64_t* indices;
+  char** messages;
+};
+
+static void GeoArrowGEOSFeatureErrorsClear(struct GeoArrowGEOSFeatureErrors* errors) {
+  for (int64_t i = 0; i < errors->size; i++) {
+    free(errors->messages[i]);
+  }
+
+  errors->size = 0;
+}
+
+static void GeoArrowGEOSFeatureErrorsReset(struct GeoArrowGEOSFeatureErrors* errors) {
+  GeoArrowGEOSFeatureErrorsClear(errors);
+  free(errors->indices);
+  free(errors->messages);
+  memset(errors, 0, sizeof(struct GeoArrowGEOSFeatureErrors));
+}
+
+static GeoArrowErrorCode GeoArrowGEOSFeatureErrorsAppend(
+    struct GeoArrowGEOSFeatureErrors* errors, int64_t index, const char* message) {
+  if (errors->size == errors->capacity) {
+    int64_t new_capacity = errors->capacity == 0 ? 16 : errors->capacity * 2;
+    int64_t* new_indices =
+        (int64_t*)realloc(errors->indices, new_capacity * sizeof(int64_t));
+    if (new_indices == NULL) {
+      return ENOMEM;
+    }
+
+    errors->indices = new_indices;
+    char** new_messages = (char**)realloc(errors->messages, new_capacity * sizeof(char*));
+    if (new_messages == NULL) {
+      return ENOMEM;
+    }
+
+    errors->messages = new_messages;
+    errors->capacity = new_capacity;
+  }
+
+  // Messages are often prefixed with "[i] ", where i is relative to whatever
+  // range was being read; the index is reported separately.
+  while (message[0] == '[' && strstr(message, "] ") != NULL) {
+    message = strstr(message, "] ") + 2;
+  }
+
+  errors->messages[errors->size] = GeoArrowGEOSStrdup(message);
+  if (errors->messages[errors->size] == NULL) {
+    return ENOMEM;
+  }
+
+  errors->indices[errors->size] = index;
+  errors->size++;
+  return GEOARROW_OK;
+}
+
+static int64_t GeoArrowGEOSFeatureErrorsGet(struct GeoArrowGEOSFeatureErrors* errors,
+                                            const int64_t** indices,
+                                            const char* const** messages) {
+  *indices = errors->indices;
+  *messages = (const char* const*)errors->messages;
+  return errors->size;
+}
+
+// An ArrowArray whose buffers and children are owned by the array. Buffers are
+// returned to the allocator they came from when the array is released.
+struct GeoArrowGEOSArrayPrivate {
+  const void* buffers[3];
+  int64_t buffer_sizes[3];
+  struct GeoArrowGEOSAllocator* allocator;
+  struct ArrowArray* children[6];
+  struct ArrowArray child_arrays[6];
+};
+
+static void GeoArrowGEOSArrayRelease(struct ArrowArray* array) {
+  struct GeoArrowGEOSArrayPrivate* private_data =
+      (struct GeoArrowGEOSArrayPrivate*)array->private_data;
+  for (int64_t i = 0; i < array->n_buffers; i++) {
+    GeoArrowGEOSFree(private_data->allocator, (void*)private_data->buffers[i],
+                     private_data->buffer_sizes[i]);
+  }
+
+  for (int64_t i = 0; i < array->n_children; i++) {
+    if (private_data->child_arrays[i].release != NULL) {
+      private_data->child_arrays[i].release(private_data->child_arrays + i);
+    }
+  }
+
+  free(private_data);
+  array->release = NULL;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayInit(struct ArrowArray* out, int64_t n_buffers,
+                                               int64_t n_children,
+                                               struct GeoArrowGEOSAllocator* allocator) {
+  struct GeoArrowGEOSArrayPrivate* private_data =
+      (struct GeoArrowGEOSArrayPrivate*)calloc(1,
+                                               sizeof(struct GeoArrowGEOSArrayPrivate));
+  if (private_data == NULL) {
+    return ENOMEM;
+  }
+
+  private_data->allocator = allocator;
+
+  memset(out, 0, sizeof(struct ArrowArray));
+  out->n_buffers = n_buffers;
+  out->buffers = private_data->buffers;
+  out->n_children = n_children;
+  out->children = private_data->children;
+  for (int64_t i = 0; i < n_children; i++) {
+    private_data->children[i] = private_data->child_arrays + i;
+  }
+
+  out->private_data = private_data;
+  out->release = &GeoArrowGEOSArrayRelease;
+  return GEOARROW_OK;
+}
+
+// Allocates buffer i of an array created by GeoArrowGEOSArrayInit() from the
+// array's allocator
+static void* GeoArrowGEOSArrayAllocateBuffer(struct ArrowArray* array, int64_t i,
+                                             int64_t size) {
+  struct GeoArrowGEOSArrayPrivate* private_data =
+      (struct GeoArrowGEOSArrayPrivate*)array->private_data;
+  void* data = GeoArrowGEOSMalloc(private_data->allocator, size);
+  if (data != NULL) {
+    private_data->buffers[i] = data;
+    private_data->buffer_sizes[i] = size;
+  }
+
+  return data;
+}
+
+// Moves the memory of buffer (which must use the array's allocator) into
+// buffer i of an array created by GeoArrowGEOSArrayInit()
+static void GeoArrowGEOSArraySetBuffer(struct ArrowArray* array, int64_t i,
+                                       struct GeoArrowGEOSBuffer* buffer) {
+  struct GeoArrowGEOSArrayPrivate* private_data =
+      (struct GeoArrowGEOSArrayPrivate*)array->private_data;
+  private_data->buffers[i] = buffer->data;
+  private_data->buffer_sizes[i] = buffer->capacity_bytes;
+  buffer->data = NULL;
+  buffer->size_bytes = 0;
+  buffer->capacity_bytes = 0;
+}
+
+// Returns the size of the buffers of a chunk produced by a builder (i.e., with
+// 32-bit offsets starting at zero): binary and string arrays have three
+// buffers, lists have two and a child, doubles have two and no children, and
+// structs and fixed-size lists have only a validity buffer.
+static int64_t GeoArrowGEOSArraySizeBytes(const struct ArrowArray* array) {
+  int64_t size = array->buffers[0] != NULL ? (array->length + 7) / 8 : 0;
+  if (array->n_buffers >= 2 && array->buffers[1] != NULL) {
+    if (array->n_buffers == 3) {
+      size += ((const int32_t*)array->buffers[1])[array->length];
+    }
+
+    if (array->n_buffers == 3 || array->n_children > 0) {
+      size += (array->length + 1) * sizeof(int32_t);
+    } else {
+      size += array->length * sizeof(double);
+    }
+  }
+
+  for (int64_t i = 0; i < array->n_children; i++) {
+    size += GeoArrowGEOSArraySizeBytes(array->children[i]);
+  }
+
+  return size;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSConcatenateValidity(struct ArrowArray** chunks,
+                                                         int64_t n_chunks,
+                                                         struct ArrowArray* out) {
+  out->null_count = 0;
+  for (int64_t i = 0; i < n_chunks; i++) {
+    out->null_count += chunks[i]->null_count;
+  }
+
+  if (out->null_count == 0) {
+    return GEOARROW_OK;
+  }
+
+  uint8_t* bits =
+      (uint8_t*)GeoArrowGEOSArrayAllocateBuffer(out, 0, (out->length + 7) / 8);
+  if (bits == NULL) {
+    return ENOMEM;
+  }
+
+  memset(bits, 0xff, (out->length + 7) / 8);
+
+  int64_t k = 0;
+  for (int64_t i = 0; i < n_chunks; i++) {
+    const uint8_t* src = (const uint8_t*)chunks[i]->buffers[0];
+    for (int64_t j = 0; j < chunks[i]->length; j++, k++) {
+      if (src != NULL && (src[j / 8] & (1 << (j % 8))) == 0) {
+        bits[k / 8] &= ~(1 << (k % 8));
+      }
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+// Concatenates chunks produced by the geoarrow-c writers (i.e., with an offset
+// of zero and offsets starting at zero) into out, rebasing any string, binary,
+// or list offsets. The layout describes each level from the top: 'B'/'b' for
+// binary/string with 64/32-bit offsets, 'L'/'l' for list with 64/32-bit
+// offsets, 's' for a struct of doubles, 'w' for a fixed-size list of doubles,
+// and 'd' for doubles. The caller must ensure 32-bit offsets can't overflow.
+// The buffers of out are allocated using allocator.
+static GeoArrowErrorCode GeoArrowGEOSConcatenate(struct ArrowArray** chunks,
+                                                 int64_t n_chunks, const char* layout,
+                                                 struct GeoArrowGEOSAllocator* allocator,
+                                                 struct ArrowArray* out) {
+  int64_t n_buffers;
+  int64_t n_children;
+  switch (layout[0]) {
+    case 'B':
+    case 'b':
+      n_buffers = 3;
+      n_children = 0;
+      break;
+    case 'L':
+    case 'l':
+      n_buffers = 2;
+      n_children = 1;
+      break;
+    case 's':
+      n_buffers = 1;
+      n_children = n_chunks > 0 ? chunks[0]->n_children : 0;
+      break;
+    case 'w':
+      n_buffers = 1;
+      n_children = 1;
+      break;
+    default:
+      n_buffers = 2;
+      n_children = 0;
+      break;
+  }
+
+  if (n_children > 4) {
+    return EINVAL;
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayInit(out, n_buffers, n_children, allocator));
+  for (int64_t i = 0; i < n_chunks; i++) {
+    out->length += chunks[i]->length;
+    if (chunks[i]->n_children != n_children) {
+      out->release(out);
+      return EINVAL;
+    }
+  }
+
+  GeoArrowErrorCode result = GeoArrowGEOSConcatenateValidity(chunks, n_chunks, out);
+  if (result != GEOARROW_OK) {
+    out->release(out);
+    return result;
+  }
+
+  if (layout[0] == 'd') {
+    uint8_t* data = (uint8_t*)GeoArrowGEOSArrayAllocateBuffer(
+        out, 1, out->length * sizeof(double) + 1);
+    if (data == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
+
+    for (int64_t i = 0; i < n_chunks; i++) {
+      if (chunks[i]->length > 0) {
+        memcpy(data, chunks[i]->buffers[1], chunks[i]->length * sizeof(double));
+        data += chunks[i]->length * sizeof(double);
+      }
+    }
+
+    return GEOARROW_OK;
+  }
+
+  int64_t last_offset = 0;
+  if (layout[0] == 'B' || layout[0] == 'L') {
+    int64_t* offsets = (int64_t*)GeoArrowGEOSArrayAllocateBuffer(
+        out, 1, (out->length + 1) * sizeof(int64_t));
+    if (offsets == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
+
+    offsets[0] = 0;
+    int64_t k = 0;
+    for (int64_t i = 0; i < n_chunks; i++) {
+      const int32_t* src = (const int32_t*)chunks[i]->buffers[1];
+      int64_t base = offsets[k];
+      for (int64_t j = 0; j < chunks[i]->length; j++) {
+        offsets[++k] = base + src[j + 1];
+      }
+    }
+
+    last_offset = offsets[k];
+  } else if (layout[0] == 'b' || layout[0] == 'l') {
+    int32_t* offsets = (int32_t*)GeoArrowGEOSArrayAllocateBuffer(
+        out, 1, (out->length + 1) * sizeof(int32_t));
+    if (offsets == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
+
+    offsets[0] = 0;
+    int64_t k = 0;
+    for (int64_t i = 0; i < n_chunks; i++) {
+      const int32_t* src = (const int32_t*)chunks[i]->buffers[1];
+      int32_t base = offsets[k];
+      for (int64_t j = 0; j < chunks[i]->length; j++) {
+        offsets[++k] = base + src[j + 1];
+      }
+    }
+
+    last_offset = offsets[k];
+  }
+
+  if (layout[0] == 'B' || layout[0] == 'b') {
+    uint8_t* data = (uint8_t*)GeoArrowGEOSArrayAllocateBuffer(out, 2, last_offset + 1);
+    if (data == NULL) {
+      out->release(out);
+      return ENOMEM;
+    }
+
+    for (int64_t i = 0; i < n_chunks; i++) {
+      if (chunks[i]->length > 0) {
+        int32_t size = ((const int32_t*)chunks[i]->buffers[1])[chunks[i]->length];
+        if (size > 0) {
+          memcpy(data, chunks[i]->buffers[2], size);
+          data += size;
+        }
+      }
+    }
+
+    return GEOARROW_OK;
+  }
+
+  struct ArrowArray** children =
+      (struct ArrowArray**)malloc(n_chunks * sizeof(struct ArrowArray*) + 1);
+  if (children == NULL) {
+    out->release(out);
+    return ENOMEM;
+  }
+
+  for (int64_t child_i = 0; child_i < n_children; child_i++) {
+    for (int64_t i = 0; i < n_chunks; i++) {
+      children[i] = chunks[i]->children[child_i];
+    }
+
+    result = GeoArrowGEOSConcatenate(children, n_chunks, layout + 1, allocator,
+                                     out->children[child_i]);
+    if (result != GEOARROW_OK) {
+      break;
+    }
+  }
+
+  free(children);
+  if (result != GEOARROW_OK) {
+    out->release(out);
+  }
+
+  return result;
+}
+
+typedef void (*GeoArrowGEOSTaskFn)(void* task);
+
+struct GeoArrowGEOSThread {
+  pthread_t thread;
+  int started;
+  GeoArrowGEOSTaskFn fn;
+  void* task;
+};
+
+static void* GeoArrowGEOSThreadRun(void* thread_void) {
+  struct GeoArrowGEOSThread* thread = (struct GeoArrowGEOSThread*)thread_void;
+  thread->fn(thread->task);
+  return NULL;
+}
+
+// Runs fn() on each of n_tasks elements of tasks (each task_size bytes). The
+// first task is run on the calling thread; if a thread can't be started its
+// task is also run on the calling thread so that every task runs exactly once.
+static GeoArrowErrorCode GeoArrowGEOSRunTasks(GeoArrowGEOSTaskFn fn, void* tasks,
+                                              size_t task_size, int n_tasks) {
+  struct GeoArrowGEOSThread* threads =
+      (struct GeoArrowGEOSThread*)malloc(n_tasks * sizeof(struct GeoArrowGEOSThread));
+  if (threads == NULL) {
+    return ENOMEM;
+  }
+
+  for (int i = 0; i < n_tasks; i++) {
+    threads[i].started = 0;
+    threads[i].fn = fn;
+    threads[i].task = (char*)tasks + (i * task_size);
+  }
+
+  for (int i = 1; i < n_tasks; i++) {
+    threads[i].started =
+        pthread_create(&threads[i].thread, NULL, &GeoArrowGEOSThreadRun, threads + i) ==
+        0;
+  }
+
+  for (int i = 0; i < n_tasks; i++) {
+    if (!threads[i].started) {
+      fn(threads[i].task);
+    }
+  }
+
+  for (int i = 1; i < n_tasks; i++) {
+    if (threads[i].started) {
+      pthread_join(threads[i].thread, NULL);
+    }
+  }
+
+  free(threads);
+  return GEOARROW_OK;
+}
+
+// Output written directly to buffers owned by the builder (rather than through
+// the GeoArrowVisitor and a geoarrow-c builder or writer)
+enum GeoArrowGEOSDirect {
+  GEOARROW_GEOS_DIRECT_NONE = 0,
+  GEOARROW_GEOS_DIRECT_NATIVE,
+  GEOARROW_GEOS_DIRECT_WKB
+};
+
+struct GeoArrowGEOSArrayBuilder {
+  GEOSContextHandle_t handle;
+  struct GeoArrowError error;
+  struct GeoArrowBuilder builder;
+  struct GeoArrowWKTWriter wkt_writer;
+  struct GeoArrowWKBWriter wkb_writer;
+  struct GeoArrowVisitor v;
+  struct GeoArrowCoordView coords_view;
+  double* coords;
+  int64_t coords_capacity;
+  // The geoarrow-c writers only produce 32-bit offsets. To produce large
+  // output we seal the writer's output into chunks before its offsets would
+  // overflow and concatenate the chunks (with 64-bit offsets) in Finish().
+  // chunk_size is the largest offset written to the current chunk (exact for
+  // direct output, otherwise an upper bound accumulated while visiting
+  // features); the sizes of sealed chunks are exact.
+  struct ArrowSchema schema;
+  enum GeoArrowType type;
+  enum GeoArrowGEOSLargeOffsets large_offsets;
+  int64_t max_offset;
+  int64_t chunk_length;
+  int64_t chunk_size;
+  int64_t sealed_size;
+  int64_t n_chunks;
+  int64_t chunks_capacity;
+  struct ArrowArray* chunks;
+  int64_t* chunk_sizes;
+  // Chunks are also sealed when they reach a target size and are queued until
+  // they are popped (popped_length features so far) or the builder is finished
+  int64_t max_chunk_rows;
+  int64_t max_chunk_bytes;
+  int64_t popped_length;
+  enum GeoArrowGeometryType geometry_type;
+  enum GeoArrowGEOSOnError on_error;
+  struct GeoArrowGEOSFeatureErrors errors;
+  // Native XY and XYZ output and WKB output are written directly to buffers we
+  // own. Levels below n_offsets are list levels; level n_offsets is the
+  // coordinates (native) or the bytes of the data buffer (WKB).
+  enum GeoArrowGEOSDirect direct;
+  int verify_wkb;
+  int n_offsets;
+  int n_dims;
+  int interleaved;
+  int64_t level_length[4];
+  int64_t null_count;
+  struct GeoArrowGEOSBuffer validity;
+  struct GeoArrowGEOSBuffer offsets[3];
+  struct GeoArrowGEOSBuffer coords_direct[3];
+  struct GeoArrowGEOSBuffer data;
+  // Bounds of each feature (xmin, ymin, [zmin], xmax, ymax, [zmax]) computed
+  // while its coordinates are copied
+  int bounds_dims;
+  double feature_bounds[6];
+  double total_bounds[6];
+  int64_t bounds_length;
+  int64_t bounds_null_count;
+  struct GeoArrowGEOSBuffer bounds_validity;
+  struct GeoArrowGEOSBuffer bounds[6];
+  struct GeoArrowGEOSPerf perf;
+  struct GeoArrowGEOSTracer* tracer;
+  int64_t feature_threshold;
+  // Used for coords, the buffers above, and the output of geoarrow-c writers
+  // (which is copied once finished)
+  struct GeoArrowGEOSAllocator* allocator;
+};
+
+// Prepares the direct buffers for a new chunk (each offset buffer starts
+// with a zero and each coordinate buffer is allocated, even if empty)
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderStartDirect(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  memset(builder->level_length, 0, sizeof(builder->level_length));
+  builder->null_count = 0;
+
+  for (int level = 0; level < builder->n_offsets; level++) {
+    struct GeoArrowGEOSBuffer* buffer = builder->offsets + level;
+    buffer->size_bytes = 0;
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSBufferReserve(buffer, sizeof(int32_t)));
+    memset(buffer->data, 0, sizeof(int32_t));
+    buffer->size_bytes = sizeof(int32_t);
+  }
+
+  if (builder->direct == GEOARROW_GEOS_DIRECT_WKB) {
+    builder->data.size_bytes = 0;
+    return GeoArrowGEOSBufferReserve(&builder->data, 1);
+  }
+
+  int n_coord_buffers = builder->interleaved ? 1 : builder->n_dims;
+  for (int i = 0; i < n_coord_buffers; i++) {
+    builder->coords_direct[i].size_bytes = 0;
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSBufferReserve(builder->coords_direct + i, sizeof(double)));
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishNative(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  struct ArrowArray* array = out;
+  for (int level = 0; level < builder->n_offsets; level++) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayInit(array, 2, 1, builder->allocator));
+    array->length = builder->level_length[level];
+    GeoArrowGEOSArraySetBuffer(array, 1, builder->offsets + level);
+    array = array->children[0];
+  }
+
+  int64_t n_coords = builder->level_length[builder->n_offsets];
+  if (builder->interleaved) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayInit(array, 1, 1, builder->allocator));
+    array->length = n_coords;
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayInit(array->children[0], 2, 0, builder->allocator));
+    array->children[0]->length = n_coords * builder->n_dims;
+    GeoArrowGEOSArraySetBuffer(array->children[0], 1, builder->coords_direct);
+  } else {
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayInit(array, 1, builder->n_dims, builder->allocator));
+    array->length = n_coords;
+    for (int i = 0; i < builder->n_dims; i++) {
+      GEOARROW_RETURN_NOT_OK(
+          GeoArrowGEOSArrayInit(array->children[i], 2, 0, builder->allocator));
+      array->children[i]->length = n_coords;
+      GeoArrowGEOSArraySetBuffer(array->children[i], 1, builder->coords_direct + i);
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishDirectInternal(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  if (builder->direct == GEOARROW_GEOS_DIRECT_WKB) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayInit(out, 3, 0, builder->allocator));
+    out->length = builder->level_length[0];
+    GeoArrowGEOSArraySetBuffer(out, 1, builder->offsets);
+    GeoArrowGEOSArraySetBuffer(out, 2, &builder->data);
+  } else {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderFinishNative(builder, out));
+  }
+
+  out->null_count = builder->null_count;
+  if (builder->null_count > 0) {
+    GeoArrowGEOSArraySetBuffer(out, 0, &builder->validity);
+  } else {
+    GeoArrowGEOSBufferReset(&builder->validity);
+  }
+
+  return GEOARROW_OK;
+}
+
+// Moves the direct buffers into out (with the same layout the geoarrow-c
+// builder would produce) and starts a new chunk
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  struct GeoArrowGEOSBuffer* buffers[] = {
+      builder->offsets,          builder->offsets + 1,       builder->offsets + 2,
+      builder->coords_direct,    builder->coords_direct + 1, builder->coords_direct + 2,
+      &builder->data};
+  int64_t sizes[7];
+  for (int i = 0; i < 7; i++) {
+    sizes[i] = buffers[i]->size_bytes;
+  }
+
+  out->release = NULL;
+  GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderFinishDirectInternal(builder, out);
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSArrayBuilderStartDirect(builder);
+  }
+
+  // With a target chunk size the next chunk will probably need as much memory
+  // as this one, so its buffers are allocated at that size up front
+  int chunked = builder->max_chunk_rows > 0 || builder->max_chunk_bytes > 0;
+  for (int i = 0; chunked && i < 7 && result == GEOARROW_OK; i++) {
+    if (sizes[i] > buffers[i]->size_bytes) {
+      result = GeoArrowGEOSBufferReserveExact(buffers[i],
+                                              sizes[i] - buffers[i]->size_bytes);
+    }
+  }
+
+  if (result != GEOARROW_OK) {
+    if (out->release != NULL) {
+      out->release(out);
+    }
+
+    GeoArrowErrorSet(&builder->error, "Failed to allocate output array");
+  }
+
+  return result;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderCreate(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSArrayBuilder** out) {
+  return GeoArrowGEOSArrayBuilderCreateWithAllocator(handle, schema, NULL, out);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderCreateWithAllocator(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSAllocator* allocator, struct GeoArrowGEOSArrayBuilder** out) {
+  struct GeoArrowGEOSArrayBuilder* builder =
+      (struct GeoArrowGEOSArrayBuilder*)malloc(sizeof(struct GeoArrowGEOSArrayBuilder));
+  if (builder == NULL) {
+    *out = NULL;
+    return ENOMEM;
+  }
+
+  memset(builder, 0, sizeof(struct GeoArrowGEOSArrayBuilder));
+  *out = builder;
+
+  builder->max_offset = INT32_MAX;
+  builder->allocator = allocator;
+  builder->validity.allocator = allocator;
+  builder->data.allocator = allocator;
+  builder->bounds_validity.allocator = allocator;
+  for (int i = 0; i < 3; i++) {
+    builder->offsets[i].allocator = allocator;
+    builder->coords_direct[i].allocator = allocator;
+  }
+  for (int i = 0; i < 6; i++) {
+    builder->bounds[i].allocator = allocator;
+  }
+
+  int large_levels = 0;
+  if (GeoArrowGEOSLargeSchemaType(schema, &builder->type, &large_levels) !=
+      GEOARROW_OK) {
+    struct GeoArrowSchemaView schema_view;
+    GEOARROW_RETURN_NOT_OK(GeoArrowSchemaViewInit(&schema_view, schema, &builder->error));
+    builder->type = schema_view.type;
+  }
+
+  if (large_levels != 0) {
+    builder->large_offsets = GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS;
+  }
+
+  switch (builder->type) {
+    case GEOARROW_TYPE_WKT:
+      GEOARROW_RETURN_NOT_OK(GeoArrowWKTWriterInit(&builder->wkt_writer));
+      GeoArrowWKTWriterInitVisitor(&builder->wkt_writer, &builder->v);
+      break;
+    case GEOARROW_TYPE_WKB:
+      // The visitor-based writer is only used when verifying the direct output
+      GEOARROW_RETURN_NOT_OK(GeoArrowWKBWriterInit(&builder->wkb_writer));
+      GeoArrowWKBWriterInitVisitor(&builder->wkb_writer, &builder->v);
+      builder->direct = GEOARROW_GEOS_DIRECT_WKB;
+      builder->n_offsets = 1;
+      if (GeoArrowGEOSArrayBuilderStartDirect(builder) != GEOARROW_OK) {
+        GeoArrowErrorSet(&builder->error, "Failed to allocate buffers");
+        return ENOMEM;
+      }
+      break;
+    default: {
+      struct GeoArrowArrayView array_view;
+      GEOARROW_RETURN_NOT_OK(GeoArrowArrayViewInitFromType(&array_view, builder->type));
+      builder->geometry_type = array_view.schema_view.geometry_type;
+
+      if (array_view.schema_view.dimensions == GEOARROW_DIMENSIONS_XY ||
+          array_view.schema_view.dimensions == GEOARROW_DIMENSIONS_XYZ) {
+        builder->direct = GEOARROW_GEOS_DIRECT_NATIVE;
+        builder->n_offsets = array_view.n_offsets;
+        builder->n_dims =
+            array_view.schema_view.dimensions == GEOARROW_DIMENSIONS_XYZ ? 3 : 2;
+        builder->interleaved =
+            array_view.schema_view.coord_type == GEOARROW_COORD_TYPE_INTERLEAVED;
+        if (GeoArrowGEOSArrayBuilderStartDirect(builder) != GEOARROW_OK) {
+          GeoArrowErrorSet(&builder->error, "Failed to allocate buffers");
+          return ENOMEM;
+        }
+
+        break;
+      }
+
+      if (large_levels != 0) {
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowBuilderInitFromType(&builder->builder, builder->type));
+      } else {
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowBuilderInitFromSchema(&builder->builder, schema, &builder->error));
+      }
+      GEOARROW_RETURN_NOT_OK(GeoArrowBuilderInitVisitor(&builder->builder, &builder->v));
+      break;
+    }
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSSchemaCopy(schema, large_levels, &builder->schema));
+
+  builder->handle = handle;
+  builder->v.error = &builder->error;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderEnsureCoords(
+    struct GeoArrowGEOSArrayBuilder* builder, uint32_t n_coords, int n_dims) {
+  int64_t n_required = (int64_t)n_coords * n_dims;
+  if (n_required > builder->coords_capacity) {
+    if ((builder->coords_capacity * 2) > n_required) {
+      n_required = builder->coords_capacity * 2;
+    }
+
+    int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+    double* new_coords = (double*)GeoArrowGEOSRealloc(
+        builder->allocator, builder->coords, builder->coords_capacity * sizeof(double),
+        n_required * sizeof(double));
+    GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_alloc);
+    builder->perf.counters.n_coords_reallocs++;
+    if (new_coords == NULL) {
+      builder->coords_view.n_coords = 0;
+      return ENOMEM;
+    }
+
+    builder->coords = new_coords;
+    builder->coords_capacity = n_required;
+  }
+
+  builder->coords_view.n_coords = n_coords;
+  builder->coords_view.n_values = n_dims;
+  builder->coords_view.coords_stride = n_dims;
+  for (int i = 0; i < n_dims; i++) {
+    builder->coords_view.values[i] = builder->coords + i;
+  }
+
+  return GEOARROW_OK;
+}
+
+// Sets bounds to inf/-inf (i.e., the bounds of nothing)
+static void GeoArrowGEOSBoundsInit(double* bounds, int n_dims) {
+  for (int i = 0; i < n_dims; i++) {
+    bounds[i] = INFINITY;
+    bounds[n_dims + i] = -INFINITY;
+  }
+}
+
+// Expands the bounds of the current feature to include n_coords coordinates
+// of n_values values each stored every stride values. The loop for each
+// dimension is branchless so that the compiler can vectorize it; NaN values
+// are ignored.
+static void GeoArrowGEOSArrayBuilderUpdateBounds(struct GeoArrowGEOSArrayBuilder* builder,
+                                                 const double** values, int n_values,
+                                                 int64_t n_coords, int stride) {
+  int n_dims = builder->bounds_dims;
+  for (int i = 0; i < n_dims && i < n_values; i++) {
+    const double* v = values[i];
+    double lo = builder->feature_bounds[i];
+    double hi = builder->feature_bounds[n_dims + i];
+    for (int64_t j = 0; j < n_coords; j++) {
+      double value = v[j * stride];
+      lo = value < lo ? value : lo;
+      hi = value > hi ? value : hi;
+    }
+
+    builder->feature_bounds[i] = lo;
+    builder->feature_bounds[n_dims + i] = hi;
+  }
+}
+
+// Expands the bounds of the current feature to include interleaved coordinates
+static void GeoArrowGEOSArrayBuilderUpdateBoundsInterleaved(
+    struct GeoArrowGEOSArrayBuilder* builder, const double* coords, int64_t n_coords,
+    int n_dims) {
+  const double* values[3] = {coords, coords + 1, coords + 2};
+  GeoArrowGEOSArrayBuilderUpdateBounds(builder, values, n_dims, n_coords, n_dims);
+}
+
+static void GeoArrowGEOSArrayBuilderResetBounds(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  GeoArrowGEOSBoundsInit(builder->total_bounds, builder->bounds_dims);
+  builder->bounds_length = 0;
+  builder->bounds_null_count = 0;
+  builder->bounds_validity.size_bytes = 0;
+  for (int i = 0; i < 6; i++) {
+    builder->bounds[i].size_bytes = 0;
+  }
+}
+
+static void GeoArrowGEOSArrayBuilderResetChunks(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  for (int64_t i = 0; i < builder->n_chunks; i++) {
+    builder->chunks[i].release(builder->chunks + i);
+  }
+
+  builder->n_chunks = 0;
+  builder->chunk_length = 0;
+  builder->chunk_size = 0;
+  builder->sealed_size = 0;
+  builder->popped_length = 0;
+}
+
+void GeoArrowGEOSArrayBuilderDestroy(struct GeoArrowGEOSArrayBuilder* builder) {
+  GeoArrowGEOSFree(builder->allocator, builder->coords,
+                   builder->coords_capacity * sizeof(double));
+
+  GeoArrowGEOSArrayBuilderResetChunks(builder);
+  free(builder->chunk_sizes);
+  if (builder->chunks != NULL) {
+    free(builder->chunks);
+  }
+
+  GeoArrowGEOSFeatureErrorsReset(&builder->errors);
+
+  GeoArrowGEOSBufferReset(&builder->validity);
+  for (int i = 0; i < 3; i++) {
+    GeoArrowGEOSBufferReset(builder->offsets + i);
+    GeoArrowGEOSBufferReset(builder->coords_direct + i);
+  }
+  GeoArrowGEOSBufferReset(&builder->data);
+  GeoArrowGEOSBufferReset(&builder->bounds_validity);
+  for (int i = 0; i < 6; i++) {
+    GeoArrowGEOSBufferReset(builder->bounds + i);
+  }
+
+  if (builder->schema.release != NULL) {
+    builder->schema.release(&builder->schema);
+  }
+
+  if (builder->builder.private_data != NULL) {
+    GeoArrowBuilderReset(&builder->builder);
+  }
+
+  if (builder->wkt_writer.private_data != NULL) {
+    GeoArrowWKTWriterReset(&builder->wkt_writer);
+  }
+
+  if (builder->wkb_writer.private_data != NULL) {
+    GeoArrowWKBWriterReset(&builder->wkb_writer);
+  }
+
+  free(builder);
+}
+
+const char* GeoArrowGEOSArrayBuilderGetLastError(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  return builder->error.message;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetLargeOffsets(
+    struct GeoArrowGEOSArrayBuilder* builder,
+    enum GeoArrowGEOSLargeOffsets large_offsets) {
+  switch (large_offsets) {
+    case GEOARROW_GEOS_LARGE_OFFSETS_NEVER:
+      // Only sealed sizes are exact; Finish() checks the current chunk
+      if (builder->sealed_size > builder->max_offset) {
+        GeoArrowErrorSet(&builder->error,
+                         "Can't disable large offsets for a builder that requires them");
+        return EINVAL;
+      }
+      break;
+    case GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS:
+    case GEOARROW_GEOS_LARGE_OFFSETS_AUTO:
+      break;
+    default:
+      GeoArrowErrorSet(&builder->error, "Unknown large offsets option: %d",
+                       (int)large_offsets);
+      return EINVAL;
+  }
+
+  builder->large_offsets = large_offsets;
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetMaxOffset(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t max_offset) {
+  if (max_offset <= 0 || max_offset > INT32_MAX) {
+    GeoArrowErrorSet(&builder->error, "Max offset must be > 0 and <= INT32_MAX");
+    return EINVAL;
+  }
+
+  if (builder->chunk_length > 0 || builder->n_chunks > 0) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't set the max offset after features have been appended");
+    return EINVAL;
+  }
+
+  builder->max_offset = max_offset;
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSArrayBuilderOutputIsLarge(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  return builder->large_offsets == GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS ||
+         (builder->large_offsets == GEOARROW_GEOS_LARGE_OFFSETS_AUTO &&
+          (builder->sealed_size + builder->chunk_size) > builder->max_offset);
+}
+
+// Returns EOVERFLOW if the output must have 32-bit offsets but size, the exact
+// largest offset of the features appended so far, doesn't fit in them
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderCheckMaxOffset(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t size) {
+  if (size > builder->max_offset &&
+      builder->large_offsets == GEOARROW_GEOS_LARGE_OFFSETS_NEVER) {
+    GeoArrowErrorSet(&builder->error,
+                     "Appending features would overflow 32-bit offsets (see "
+                     "GeoArrowGEOSArrayBuilderSetLargeOffsets())");
+    return EOVERFLOW;
+  }
+
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderGetSchema(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowSchema* out) {
+  GeoArrowErrorCode result = GeoArrowGEOSSchemaCopy(
+      &builder->schema, GeoArrowGEOSArrayBuilderOutputIsLarge(builder), out);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to copy schema");
+  }
+
+  return result;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetOnError(
+    struct GeoArrowGEOSArrayBuilder* builder, enum GeoArrowGEOSOnError on_error) {
+  switch (on_error) {
+    case GEOARROW_GEOS_ON_ERROR_FAIL:
+    case GEOARROW_GEOS_ON_ERROR_NULL:
+      builder->on_error = on_error;
+      return GEOARROW_OK;
+    default:
+      GeoArrowErrorSet(&builder->error, "Unknown on error option: %d", (int)on_error);
+      return EINVAL;
+  }
+}
+
+// The number of features in chunks that have been sealed (including any that
+// were popped), i.e., the output index of the first feature of the current chunk
+static int64_t GeoArrowGEOSArrayBuilderSealedLength(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  int64_t length = builder->popped_length;
+  for (int64_t i = 0; i < builder->n_chunks; i++) {
+    length += builder->chunks[i].length;
+  }
+
+  return length;
+}
+
+int64_t GeoArrowGEOSArrayBuilderGetFeatureErrors(struct GeoArrowGEOSArrayBuilder* builder,
+                                                 const int64_t** indices,
+                                                 const char* const** messages) {
+  return GeoArrowGEOSFeatureErrorsGet(&builder->errors, indices, messages);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetVerifyWKB(
+    struct GeoArrowGEOSArrayBuilder* builder, int verify) {
+  if (builder->direct != GEOARROW_GEOS_DIRECT_WKB) {
+    GeoArrowErrorSet(&builder->error, "Can't verify output that is not WKB");
+    return EINVAL;
+  }
+
+  if (builder->chunk_length > 0 || builder->n_chunks > 0) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't change WKB verification after features have been appended");
+    return EINVAL;
+  }
+
+  builder->verify_wkb = verify != 0;
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, int direct) {
+  // n_dims is only set for native XY and XYZ output
+  if (builder->n_dims == 0) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't change how output that is not native XY or XYZ is written");
+    return EINVAL;
+  }
+
+  if (builder->chunk_length > 0 || builder->n_chunks > 0) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't change how output is written after features have been "
+                     "appended");
+    return EINVAL;
+  }
+
+  if (direct && builder->direct == GEOARROW_GEOS_DIRECT_NONE) {
+    GeoArrowBuilderReset(&builder->builder);
+    builder->builder.private_data = NULL;
+    builder->direct = GEOARROW_GEOS_DIRECT_NATIVE;
+    if (GeoArrowGEOSArrayBuilderStartDirect(builder) != GEOARROW_OK) {
+      GeoArrowErrorSet(&builder->error, "Failed to allocate buffers");
+      return ENOMEM;
+    }
+  } else if (!direct && builder->direct == GEOARROW_GEOS_DIRECT_NATIVE) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowBuilderInitFromType(&builder->builder, builder->type));
+    GEOARROW_RETURN_NOT_OK(GeoArrowBuilderInitVisitor(&builder->builder, &builder->v));
+    builder->v.error = &builder->error;
+    builder->direct = GEOARROW_GEOS_DIRECT_NONE;
+  }
+
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderReserve(
+    struct GeoArrowGEOSArrayBuilder* builder, const struct GeoArrowGEOSSizeStats* stats) {
+  if (builder->direct == GEOARROW_GEOS_DIRECT_NONE) {
+    return GEOARROW_OK;
+  }
+
+  // The number of items to reserve at each level: offsets for list levels,
+  // then coordinates (native) or bytes (WKB). A null point is an empty
+  // coordinate.
+  int64_t n_items[4] = {stats->n_features, 0, 0, 0};
+  if (builder->direct == GEOARROW_GEOS_DIRECT_WKB) {
+    n_items[1] = stats->wkb_size;
+  } else {
+    switch (builder->geometry_type) {
+      case GEOARROW_GEOMETRY_TYPE_POINT:
+        n_items[0] = stats->n_coords + stats->n_null;
+        break;
+      case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+        n_items[1] = stats->n_coords;
+        break;
+      case GEOARROW_GEOMETRY_TYPE_POLYGON:
+        n_items[1] = stats->n_rings;
+        n_items[2] = stats->n_coords;
+        break;
+      case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+        n_items[1] = stats->n_parts;
+        n_items[2] = stats->n_coords;
+        break;
+      case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+        n_items[1] = stats->n_parts;
+        n_items[2] = stats->n_rings;
+        n_items[3] = stats->n_coords;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Features beyond what fits in 32-bit offsets end up in another chunk
+  for (int level = 0; level <= builder->n_offsets; level++) {
+    if (n_items[level] > INT32_MAX) {
+      n_items[level] = INT32_MAX;
+    }
+  }
+
+  GeoArrowErrorCode result = GEOARROW_OK;
+  if (stats->n_null > 0) {
+    int64_t n_bytes = (builder->level_length[0] + n_items[0]) / 8 + 1;
+    result = GeoArrowGEOSBufferReserveExact(&builder->validity,
+                                            n_bytes - builder->validity.size_bytes);
+  }
+
+  for (int level = 0; level < builder->n_offsets && result == GEOARROW_OK; level++) {
+    result = GeoArrowGEOSBufferReserveExact(builder->offsets + level,
+                                            n_items[level] * sizeof(int32_t));
+  }
+
+  int64_t n_last = n_items[builder->n_offsets];
+  if (result == GEOARROW_OK && builder->direct == GEOARROW_GEOS_DIRECT_WKB) {
+    result = GeoArrowGEOSBufferReserveExact(&builder->data, n_last);
+  } else if (result == GEOARROW_OK && builder->interleaved) {
+    result = GeoArrowGEOSBufferReserveExact(builder->coords_direct,
+                                            n_last * builder->n_dims * sizeof(double));
+  } else {
+    for (int i = 0; i < builder->n_dims && result == GEOARROW_OK; i++) {
+      result = GeoArrowGEOSBufferReserveExact(builder->coords_direct + i,
+                                              n_last * sizeof(double));
+    }
+  }
+
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to reserve buffers for %ld features",
+                     (long)stats->n_features);
+  }
+
+  return result;
+}
+
+// Compares a chunk written by the direct WKB serializer against the output of
+// geoarrow-c's WKB writer for the same features
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderVerifyWKB(
+    struct GeoArrowGEOSArrayBuilder* builder, const struct ArrowArray* actual) {
+  struct ArrowArray expected;
+  GEOARROW_RETURN_NOT_OK(
+      GeoArrowWKBWriterFinish(&builder->wkb_writer, &expected, &builder->error));
+
+  int64_t index_offset = GeoArrowGEOSArrayBuilderSealedLength(builder);
+
+  GeoArrowErrorCode result = GEOARROW_OK;
+  if (actual->length != expected.length) {
+    GeoArrowErrorSet(&builder->error,
+                     "Expected %ld WKB features but serialized %ld features",
+                     (long)expected.length, (long)actual->length);
+    result = EINVAL;
+  }
+
+  const uint8_t* actual_validity = (const uint8_t*)actual->buffers[0];
+  const int32_t* actual_offsets = (const int32_t*)actual->buffers[1];
+  const uint8_t* actual_data = (const uint8_t*)actual->buffers[2];
+  const uint8_t* expected_validity = (const uint8_t*)expected.buffers[0];
+  const int32_t* expected_offsets = (const int32_t*)expected.buffers[1] + expected.offset;
+  const uint8_t* expected_data = (const uint8_t*)expected.buffers[2];
+
+  for (int64_t i = 0; result == GEOARROW_OK && i < actual->length; i++) {
+    int actual_valid = actual_validity == NULL || (actual_validity[i / 8] >> (i % 8)) & 1;
+    int64_t j = expected.offset + i;
+    int expected_valid =
+        expected_validity == NULL || (expected_validity[j / 8] >> (j % 8)) & 1;
+    int64_t actual_size = actual_offsets[i + 1] - actual_offsets[i];
+    int64_t expected_size = expected_offsets[i + 1] - expected_offsets[i];
+
+    if (actual_valid != expected_valid) {
+      GeoArrowErrorSet(&builder->error, "[%ld] Expected validity %d but got %d",
+                       (long)(index_offset + i), expected_valid, actual_valid);
+      result = EINVAL;
+    } else if (actual_valid && actual_size != expected_size) {
+      GeoArrowErrorSet(&builder->error, "[%ld] Expected %ld WKB bytes but got %ld",
+                       (long)(index_offset + i), (long)expected_size,
+                       (long)actual_size);
+      result = EINVAL;
+    } else if (actual_valid &&
+               memcmp(actual_data + actual_offsets[i],
+                      expected_data + expected_offsets[i], actual_size) != 0) {
+      GeoArrowErrorSet(&builder->error,
+                       "[%ld] Serialized WKB differs from GeoArrowWKBWriter output",
+                       (long)(index_offset + i));
+      result = EINVAL;
+    }
+  }
+
+  expected.release(&expected);
+  return result;
+}
+
+// Writes the GeoArrowGEOSConcatenate() layout of the builder's output to layout
+// (which must hold at least 8 characters)
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderLayout(
+    struct GeoArrowGEOSArrayBuilder* builder, int large, char* layout) {
+  switch (builder->type) {
+    case GEOARROW_TYPE_WKB:
+    case GEOARROW_TYPE_WKT:
+      strcpy(layout, large ? "B" : "b");
+      return GEOARROW_OK;
+    default: {
+      struct GeoArrowArrayView array_view;
+      GEOARROW_RETURN_NOT_OK(GeoArrowArrayViewInitFromType(&array_view, builder->type));
+      int32_t i = 0;
+      for (; i < array_view.n_offsets; i++) {
+        layout[i] = large ? 'L' : 'l';
+      }
+
+      layout[i++] =
+          array_view.schema_view.coord_type == GEOARROW_COORD_TYPE_SEPARATE ? 's' : 'w';
+      layout[i++] = 'd';
+      layout[i] = '\0';
+      return GEOARROW_OK;
+    }
+  }
+}
+
+// The geoarrow-c writers allocate their output using nanoarrow's allocator, so
+// with an allocator that output is copied into memory from the allocator
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishWriterCopy(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  struct ArrowArray written;
+  GeoArrowErrorCode result;
+  if (builder->wkt_writer.private_data != NULL) {
+    result = GeoArrowWKTWriterFinish(&builder->wkt_writer, &written, &builder->error);
+  } else {
+    result = GeoArrowBuilderFinish(&builder->builder, &written, &builder->error);
+  }
+
+  if (result != GEOARROW_OK || builder->allocator == NULL) {
+    memcpy(out, &written, sizeof(struct ArrowArray));
+    return result;
+  }
+
+  char layout[8];
+  struct ArrowArray* chunks[] = {&written};
+  result = GeoArrowGEOSArrayBuilderLayout(builder, 0, layout);
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSConcatenate(chunks, 1, layout, builder->allocator, out);
+  }
+
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to copy output to allocator");
+  }
+
+  written.release(&written);
+  return result;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishWriterInternal(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  builder->chunk_length = 0;
+  builder->chunk_size = 0;
+
+  if (builder->direct) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderFinishDirect(builder, out));
+    if (builder->verify_wkb) {
+      GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderVerifyWKB(builder, out);
+      if (result != GEOARROW_OK) {
+        out->release(out);
+        return result;
+      }
+    }
+
+    return GEOARROW_OK;
+  } else if (builder->wkt_writer.private_data != NULL ||
+             builder->builder.private_data != NULL) {
+    return GeoArrowGEOSArrayBuilderFinishWriterCopy(builder, out);
+  } else {
+    GeoArrowErrorSet(&builder->error, "Invalid state");
+    return EINVAL;
+  }
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderFinishWriter(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderFinishWriterInternal(builder, out);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_finish);
+  if (result == GEOARROW_OK) {
+    builder->perf.counters.bytes_produced += GeoArrowGEOSArraySizeBytes(out);
+  }
+
+  return result;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderReserveChunks(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t additional) {
+  if ((builder->n_chunks + additional) > builder->chunks_capacity) {
+    int64_t new_capacity =
+        builder->chunks_capacity == 0 ? 4 : builder->chunks_capacity * 2;
+    if (new_capacity < (builder->n_chunks + additional)) {
+      new_capacity = builder->n_chunks + additional;
+    }
+
+    struct ArrowArray* new_chunks = (struct ArrowArray*)realloc(
+        builder->chunks, new_capacity * sizeof(struct ArrowArray));
+    if (new_chunks == NULL) {
+      GeoArrowErrorSet(&builder->error, "Failed to allocate chunks");
+      return ENOMEM;
+    }
+
+    builder->chunks = new_chunks;
+
+    int64_t* new_sizes =
+        (int64_t*)realloc(builder->chunk_sizes, new_capacity * sizeof(int64_t));
+    if (new_sizes == NULL) {
+      GeoArrowErrorSet(&builder->error, "Failed to allocate chunks");
+      return ENOMEM;
+    }
+
+    builder->chunk_sizes = new_sizes;
+    builder->chunks_capacity = new_capacity;
+  }
+
+  return GEOARROW_OK;
+}
+
+// Returns the largest offset in chunk, an array with 32-bit offsets and the
+// given GeoArrowGEOSConcatenate() layout
+static int64_t GeoArrowGEOSChunkLargestOffset(struct ArrowArray* chunk,
+                                              const char* layout) {
+  int64_t largest = 0;
+  for (; *layout == 'l' || *layout == 'b'; layout++) {
+    const int32_t* offsets = (const int32_t*)chunk->buffers[1];
+    if (chunk->length > 0 && offsets[chunk->offset + chunk->length] > largest) {
+      largest = offsets[chunk->offset + chunk->length];
+    }
+
+    if (*layout == 'b') {
+      break;
+    }
+
+    chunk = chunk->children[0];
+  }
+
+  return largest;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderSealChunk(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderReserveChunks(builder, 1));
+  int64_t chunk_size = builder->chunk_size;
+  struct ArrowArray* chunk = builder->chunks + builder->n_chunks;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderFinishWriter(builder, chunk));
+
+  // Output written through the visitor only has a bound until it is finished
+  if (builder->direct == GEOARROW_GEOS_DIRECT_NONE) {
+    char layout[8];
+    GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderLayout(builder, 0, layout);
+    if (result != GEOARROW_OK) {
+      chunk->release(chunk);
+      return result;
+    }
+
+    chunk_size = GeoArrowGEOSChunkLargestOffset(chunk, layout);
+  }
+
+  builder->chunk_sizes[builder->n_chunks] = chunk_size;
+  builder->n_chunks++;
+  builder->sealed_size += chunk_size;
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetChunkSize(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t max_rows, int64_t max_bytes) {
+  if (max_rows < 0 || max_bytes < 0) {
+    GeoArrowErrorSet(&builder->error, "Chunk size limits must be >= 0");
+    return EINVAL;
+  }
+
+  builder->max_chunk_rows = max_rows;
+  builder->max_chunk_bytes = max_bytes;
+  return GEOARROW_OK;
+}
+
+// Returns the memory used by the current chunk's buffers or, for output written
+// by geoarrow-c, the bound on its largest offset (approximately its size)
+static int64_t GeoArrowGEOSArrayBuilderChunkBytes(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  if (builder->direct == GEOARROW_GEOS_DIRECT_NONE) {
+    return builder->chunk_size;
+  }
+
+  int64_t size = builder->validity.size_bytes + builder->data.size_bytes;
+  for (int i = 0; i < 3; i++) {
+    size += builder->offsets[i].size_bytes + builder->coords_direct[i].size_bytes;
+  }
+
+  return size;
+}
+
+static int GeoArrowGEOSArrayBuilderChunkIsFull(struct GeoArrowGEOSArrayBuilder* builder) {
+  return (builder->max_chunk_rows > 0 &&
+          builder->chunk_length >= builder->max_chunk_rows) ||
+         (builder->max_chunk_bytes > 0 &&
+          GeoArrowGEOSArrayBuilderChunkBytes(builder) >= builder->max_chunk_bytes);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderPopChunk(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  if (builder->n_chunks == 0) {
+    out->release = NULL;
+    return GEOARROW_OK;
+  }
+
+  memcpy(out, builder->chunks, sizeof(struct ArrowArray));
+  builder->popped_length += builder->chunks[0].length;
+  builder->sealed_size -= builder->chunk_sizes[0];
+
+  builder->n_chunks--;
+  memmove(builder->chunks, builder->chunks + 1,
+          builder->n_chunks * sizeof(struct ArrowArray));
+  memmove(builder->chunk_sizes, builder->chunk_sizes + 1,
+          builder->n_chunks * sizeof(int64_t));
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinish(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out) {
+  GeoArrowGEOSFeatureErrorsClear(&builder->errors);
+
+  // Decided before sealing to match GeoArrowGEOSArrayBuilderGetSchema()
+  int large = GeoArrowGEOSArrayBuilderOutputIsLarge(builder);
+  if (!large && builder->n_chunks == 0) {
+    builder->popped_length = 0;
+    return GeoArrowGEOSArrayBuilderFinishWriter(builder, out);
+  }
+
+  // Once every chunk is sealed the size of the output is exact
+  GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderSealChunk(builder);
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSArrayBuilderCheckMaxOffset(builder, builder->sealed_size);
+  }
+
+  char layout[8];
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSArrayBuilderLayout(builder, large, layout);
+  }
+
+  if (result != GEOARROW_OK) {
+    GeoArrowGEOSArrayBuilderResetChunks(builder);
+    return result;
+  }
+
+  struct ArrowArray** chunks =
+      (struct ArrowArray**)malloc(builder->n_chunks * sizeof(struct ArrowArray*));
+  if (chunks == NULL) {
+    GeoArrowGEOSArrayBuilderResetChunks(builder);
+    GeoArrowErrorSet(&builder->error, "Failed to allocate chunks");
+    return ENOMEM;
+  }
+
+  for (int64_t i = 0; i < builder->n_chunks; i++) {
+    chunks[i] = builder->chunks + i;
+  }
+
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  result = GeoArrowGEOSConcatenate(chunks, builder->n_chunks, layout,
+                                   builder->allocator, out);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_finish);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to concatenate %ld chunks",
+                     (long)builder->n_chunks);
+  }
+
+  free(chunks);
+  GeoArrowGEOSArrayBuilderResetChunks(builder);
+
+  return result;
+}
+
+// An ArrowArrayStream over chunks moved out of a builder
+struct GeoArrowGEOSChunkStream {
+  struct ArrowSchema schema;
+  struct ArrowArray* chunks;
+  int64_t n_chunks;
+  int64_t next;
+  struct GeoArrowError error;
+};
+
+static int GeoArrowGEOSChunkStreamGetSchema(struct ArrowArrayStream* stream,
+                                            struct ArrowSchema* out) {
+  struct GeoArrowGEOSChunkStream* private_data =
+      (struct GeoArrowGEOSChunkStream*)stream->private_data;
+  int result = GeoArrowGEOSSchemaCopy(&private_data->schema, 0, out);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&private_data->error, "Failed to copy schema");
+  }
+
+  return result;
+}
+
+static int GeoArrowGEOSChunkStreamGetNext(struct ArrowArrayStream* stream,
+                                          struct ArrowArray* out) {
+  struct GeoArrowGEOSChunkStream* private_data =
+      (struct GeoArrowGEOSChunkStream*)stream->private_data;
+  if (private_data->next == private_data->n_chunks) {
+    out->release = NULL;
+    return GEOARROW_OK;
+  }
+
+  memcpy(out, private_data->chunks + private_data->next, sizeof(struct ArrowArray));
+  private_data->chunks[private_data->next].release = NULL;
+  private_data->next++;
+  return GEOARROW_OK;
+}
+
+static const char* GeoArrowGEOSChunkStreamGetLastError(struct ArrowArrayStream* stream) {
+  struct GeoArrowGEOSChunkStream* private_data =
+      (struct GeoArrowGEOSChunkStream*)stream->private_data;
+  return private_data->error.message;
+}
+
+static void GeoArrowGEOSChunkStreamRelease(struct ArrowArrayStream* stream) {
+  struct GeoArrowGEOSChunkStream* private_data =
+      (struct GeoArrowGEOSChunkStream*)stream->private_data;
+  for (int64_t i = private_data->next; i < private_data->n_chunks; i++) {
+    private_data->chunks[i].release(private_data->chunks + i);
+  }
+
+  free(private_data->chunks);
+  if (private_data->schema.release != NULL) {
+    private_data->schema.release(&private_data->schema);
+  }
+
+  free(private_data);
+  stream->release = NULL;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinishStream(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArrayStream* out) {
+  GeoArrowGEOSFeatureErrorsClear(&builder->errors);
+
+  if (builder->chunk_length > 0) {
+    GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderSealChunk(builder);
+    if (result != GEOARROW_OK) {
+      GeoArrowGEOSArrayBuilderResetChunks(builder);
+      return result;
+    }
+  }
+
+  struct GeoArrowGEOSChunkStream* private_data =
+      (struct GeoArrowGEOSChunkStream*)malloc(sizeof(struct GeoArrowGEOSChunkStream));
+  if (private_data == NULL) {
+    GeoArrowGEOSArrayBuilderResetChunks(builder);
+    GeoArrowErrorSet(&builder->error, "Failed to allocate stream");
+    return ENOMEM;
+  }
+
+  if (GeoArrowGEOSSchemaCopy(&builder->schema, 0, &private_data->schema) !=
+      GEOARROW_OK) {
+    free(private_data);
+    GeoArrowGEOSArrayBuilderResetChunks(builder);
+    GeoArrowErrorSet(&builder->error, "Failed to copy schema");
+    return ENOMEM;
+  }
+
+  private_data->chunks = builder->chunks;
+  private_data->n_chunks = builder->n_chunks;
+  private_data->next = 0;
+  private_data->error.message[0] = '\0';
+
+  builder->chunks = NULL;
+  free(builder->chunk_sizes);
+  builder->chunk_sizes = NULL;
+  builder->chunks_capacity = 0;
+  builder->n_chunks = 0;
+  GeoArrowGEOSArrayBuilderResetChunks(builder);
+
+  out->get_schema = &GeoArrowGEOSChunkStreamGetSchema;
+  out->get_next = &GeoArrowGEOSChunkStreamGetNext;
+  out->get_last_error = &GeoArrowGEOSChunkStreamGetLastError;
+  out->release = &GeoArrowGEOSChunkStreamRelease;
+  out->private_data = private_data;
+  return GEOARROW_OK;
+}
+
+void GeoArrowGEOSArrayBuilderSetCollectTimings(struct GeoArrowGEOSArrayBuilder* builder,
+                                               int collect) {
+  builder->perf.collect_timings = collect;
+}
+
+void GeoArrowGEOSArrayBuilderGetCounters(struct GeoArrowGEOSArrayBuilder* builder,
+                                         struct GeoArrowGEOSCounters* out) {
+  memcpy(out, &builder->perf.counters, sizeof(struct GeoArrowGEOSCounters));
+}
+
+void GeoArrowGEOSArrayBuilderResetCounters(struct GeoArrowGEOSArrayBuilder* builder) {
+  memset(&builder->perf.counters, 0, sizeof(struct GeoArrowGEOSCounters));
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetTracer(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSTracer* tracer,
+    int64_t feature_threshold) {
+#if !defined(GEOARROW_GEOS_ENABLE_TRACING)
+  if (tracer != NULL) {
+    GeoArrowErrorSet(&builder->error,
+                     "geoarrow-c-geos was built without GEOARROW_GEOS_ENABLE_TRACING");
+    return ENOTSUP;
+  }
+#endif
+
+  builder->tracer = tracer;
+  builder->feature_threshold = feature_threshold;
+  return GEOARROW_OK;
+}
+
+// Returns an upper bound for the amount by which n_nodes geometries or rings with
+// n_coords coordinates of n_dims dimensions advance the output's largest offset:
+// bytes for WKT and items at any nesting level for native output
+static int64_t GeoArrowGEOSArrayBuilderBound(struct GeoArrowGEOSArrayBuilder* builder,
+                                             int64_t n_nodes, int64_t n_coords,
+                                             int64_t n_dims) {
+  switch (builder->type) {
+    case GEOARROW_TYPE_WKT:
+      // Assumes no more than 17 significant digits plus sign, decimal point,
+      // exponent, and separator for each ordinate
+      return 40 * n_nodes + 32 * n_dims * n_coords;
+    default:
+      return n_nodes + n_coords;
+  }
+}
+
+static GeoArrowErrorCode VisitCoords(struct GeoArrowGEOSArrayBuilder* builder,
+                                     const GEOSCoordSequence* seq,
+                                     struct GeoArrowVisitor* v) {
+  unsigned int size = 0;
+  int result = GEOSCoordSeq_getSize_r(builder->handle, seq, &size);
+  if (result == 0) {
+    GeoArrowErrorSet(v->error, "GEOSCoordSeq_getSize_r() failed");
+    return ENOMEM;
+  }
+
+  if (size == 0) {
+    return GEOARROW_OK;
+  }
+
+  unsigned int dims = 0;
+  result = GEOSCoordSeq_getDimensions_r(builder->handle, seq, &dims);
+  if (result == 0) {
+    GeoArrowErrorSet(v->error, "GEOSCoordSeq_getDimensions_r() failed");
+    return ENOMEM;
+  }
+
+  builder->chunk_size += GeoArrowGEOSArrayBuilderBound(builder, 0, size, dims);
+
+  // Make sure we have enough space to copy the coordinates into
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderEnsureCoords(builder, size, dims));
+
+  // Not sure exactly how M coordinates work in GEOS yet
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  result =
+      GEOSCoordSeq_copyToBuffer_r(builder->handle, seq, builder->coords, dims == 3, 0);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_coords);
+  builder->perf.counters.n_coords += size;
+  if (result == 0) {
+    GeoArrowErrorSet(v->error, "GEOSCoordSeq_copyToBuffer_r() failed");
+    return ENOMEM;
+  }
+
+  GeoArrowGEOSArrayBuilderUpdateBoundsInterleaved(builder, builder->coords, size, dims);
+
+  // Call the visitor method
+  GEOARROW_RETURN_NOT_OK(v->coords(v, &builder->coords_view));
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode VisitGeometry(struct GeoArrowGEOSArrayBuilder* builder,
+                                       const GEOSGeometry* geom,
+                                       struct GeoArrowVisitor* v) {
+  if (geom == NULL) {
+    // Nothing is written, but a chunk limited by bytes still fills up
+    builder->chunk_size++;
+    GEOARROW_RETURN_NOT_OK(v->null_feat(v));
+    return GEOARROW_OK;
+  }
+
+  int type_id = GEOSGeomTypeId_r(builder->handle, geom);
+  int coord_dimension = GEOSGeom_getCoordinateDimension_r(builder->handle, geom);
+
+  enum GeoArrowGeometryType geoarrow_type = GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  enum GeoArrowDimensions geoarrow_dims = GEOARROW_DIMENSIONS_UNKNOWN;
+
+  // Not sure how M dimensions work yet
+  switch (coord_dimension) {
+    case 2:
+      geoarrow_dims = GEOARROW_DIMENSIONS_XY;
+      break;
+    case 3:
+      geoarrow_dims = GEOARROW_DIMENSIONS_XYZ;
+      break;
+    default:
+      GeoArrowErrorSet(v->error, "Unexpected GEOSGeom_getCoordinateDimension_r: %d",
+                       coord_dimension);
+      return EINVAL;
+  }
+
+  switch (type_id) {
+    case GEOS_POINT:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_POINT;
+      break;
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_LINESTRING;
+      break;
+    case GEOS_POLYGON:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_POLYGON;
+      break;
+    case GEOS_MULTIPOINT:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTIPOINT;
+      break;
+    case GEOS_MULTILINESTRING:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTILINESTRING;
+      break;
+    case GEOS_MULTIPOLYGON:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON;
+      break;
+    case GEOS_GEOMETRYCOLLECTION:
+      geoarrow_type = GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+      break;
+    default:
+      GeoArrowErrorSet(v->error, "Unexpected GEOSGeomTypeId: %d", type_id);
+      return EINVAL;
+  }
+
+  // Empty points are written as NaN coordinates, which this also covers
+  builder->chunk_size += GeoArrowGEOSArrayBuilderBound(builder, 1, 0, 0);
+  GEOARROW_RETURN_NOT_OK(v->geom_start(v, geoarrow_type, geoarrow_dims));
+
+  switch (type_id) {
+    case GEOS_POINT:
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING: {
+      const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, geom);
+      if (seq == NULL) {
+        GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
+        return ENOMEM;
+      }
+
+      GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
+      break;
+    }
+
+    case GEOS_POLYGON: {
+      if (GEOSisEmpty_r(builder->handle, geom)) {
+        break;
+      }
+
+      const GEOSGeometry* ring = GEOSGetExteriorRing_r(builder->handle, geom);
+      if (ring == NULL) {
+        GeoArrowErrorSet(v->error, "GEOSGetExteriorRing_r() failed");
+        return ENOMEM;
+      }
+
+      builder->chunk_size += GeoArrowGEOSArrayBuilderBound(builder, 1, 0, 0);
+      GEOARROW_RETURN_NOT_OK(v->ring_start(v));
+      const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, ring);
+      if (seq == NULL) {
+        GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
+        return ENOMEM;
+      }
+
+      GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
+      GEOARROW_RETURN_NOT_OK(v->ring_end(v));
+
+      int size = GEOSGetNumInteriorRings_r(builder->handle, geom);
+      for (int i = 0; i < size; i++) {
+        ring = GEOSGetInteriorRingN_r(builder->handle, geom, i);
+        if (ring == NULL) {
+          GeoArrowErrorSet(v->error, "GEOSGetInteriorRingN_r() failed");
+          return ENOMEM;
+        }
+
+        builder->chunk_size += GeoArrowGEOSArrayBuilderBound(builder, 1, 0, 0);
+        GEOARROW_RETURN_NOT_OK(v->ring_start(v));
+        seq = GEOSGeom_getCoordSeq_r(builder->handle, ring);
+        if (seq == NULL) {
+          GeoArrowErrorSet(v->error, "GEOSGeom_getCoordSeq_r() failed");
+          return ENOMEM;
+        }
+
+        GEOARROW_RETURN_NOT_OK(VisitCoords(builder, seq, v));
+        GEOARROW_RETURN_NOT_OK(v->ring_end(v));
+      }
+
+      break;
+    }
+
+    case GEOS_MULTIPOINT:
+    case GEOS_MULTILINESTRING:
+    case GEOS_MULTIPOLYGON:
+    case GEOS_GEOMETRYCOLLECTION: {
+      int size = GEOSGetNumGeometries_r(builder->handle, geom);
+      for (int i = 0; i < size; i++) {
+        const GEOSGeometry* child = GEOSGetGeometryN_r(builder->handle, geom, i);
+        if (child == NULL) {
+          GeoArrowErrorSet(v->error, "GEOSGetGeometryN_r() failed");
+          return ENOMEM;
+        }
+
+        GEOARROW_RETURN_NOT_OK(VisitGeometry(builder, child, v));
+      }
+
+      break;
+    }
+    default:
+      GeoArrowErrorSet(v->error, "Unexpected GEOSGeomTypeId: %d", type_id);
+      return EINVAL;
+  }
+
+  GEOARROW_RETURN_NOT_OK(v->geom_end(v));
+  return GEOARROW_OK;
+}
+
+static void GeoArrowGEOSCountNodes(GEOSContextHandle_t handle, const GEOSGeometry* geom,
+                                   int64_t* n_nodes, int64_t* n_empty_points) {
+  *n_nodes += 1;
+  switch (GEOSGeomTypeId_r(handle, geom)) {
+    case GEOS_POINT:
+      *n_empty_points += GEOSisEmpty_r(handle, geom) == 1;
+      break;
+    case GEOS_POLYGON:
+      if (GEOSisEmpty_r(handle, geom) == 0) {
+        *n_nodes += 1 + GEOSGetNumInteriorRings_r(handle, geom);
+      }
+      break;
+    case GEOS_MULTIPOINT:
+    case GEOS_MULTILINESTRING:
+    case GEOS_MULTIPOLYGON:
+    case GEOS_GEOMETRYCOLLECTION: {
+      int size = GEOSGetNumGeometries_r(handle, geom);
+      for (int i = 0; i < size; i++) {
+        GeoArrowGEOSCountNodes(handle, GEOSGetGeometryN_r(handle, geom, i), n_nodes,
+                               n_empty_points);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+// Returns an upper bound for the amount by which geom will advance the output's
+// largest offset (WKB output uses the exact GeoArrowGEOSWKBSize()). This is a
+// pass over geom, so it is only used when the current chunk is nearly full.
+static int64_t GeoArrowGEOSArrayBuilderSizeBound(struct GeoArrowGEOSArrayBuilder* builder,
+                                                 const GEOSGeometry* geom) {
+  if (geom == NULL) {
+    return 1;
+  }
+
+  int64_t n_nodes = 0;
+  int64_t n_empty_points = 0;
+  GeoArrowGEOSCountNodes(builder->handle, geom, &n_nodes, &n_empty_points);
+  int64_t n_coords = GEOSGetNumCoordinates_r(builder->handle, geom) + n_empty_points;
+  int64_t n_dims = GEOSGeom_getCoordinateDimension_r(builder->handle, geom);
+  return GeoArrowGEOSArrayBuilderBound(builder, n_nodes, n_coords, n_dims);
+}
+
+// Seals the current chunk if a feature advancing its largest offset by up to size
+// could overflow its 32-bit offsets. A bound that turns out to be too large only
+// costs an extra chunk: EOVERFLOW depends on the exact size of sealed chunks.
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderReserveFeature(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t size) {
+  if ((builder->chunk_size + size) <= builder->max_offset || builder->chunk_length == 0) {
+    return GEOARROW_OK;
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderSealChunk(builder));
+  return GeoArrowGEOSArrayBuilderCheckMaxOffset(builder, builder->sealed_size);
+}
+
+// Returns the largest offset written directly to the current chunk
+static int64_t GeoArrowGEOSArrayBuilderDirectSize(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  int64_t size = 0;
+  for (int i = 1; i <= builder->n_offsets; i++) {
+    if (builder->level_length[i] > size) {
+      size = builder->level_length[i];
+    }
+  }
+
+  return size;
+}
+
+// The geoarrow-c writers can't remove a partially written feature, so in
+// GEOARROW_GEOS_ON_ERROR_NULL mode we check for the things that VisitGeometry()
+// would reject before writing anything (direct output is rolled back instead)
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderCheckGeometry(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom, int top_level) {
+  int coord_dimension = GEOSGeom_getCoordinateDimension_r(builder->handle, geom);
+  if (coord_dimension != 2 && coord_dimension != 3) {
+    GeoArrowErrorSet(&builder->error, "Unexpected GEOSGeom_getCoordinateDimension_r: %d",
+                     coord_dimension);
+    return EINVAL;
+  }
+
+  enum GeoArrowGeometryType geometry_type;
+  int type_id = GEOSGeomTypeId_r(builder->handle, geom);
+  switch (type_id) {
+    case GEOS_POINT:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_POINT;
+      break;
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_LINESTRING;
+      break;
+    case GEOS_POLYGON:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_POLYGON;
+      break;
+    case GEOS_MULTIPOINT:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_MULTIPOINT;
+      break;
+    case GEOS_MULTILINESTRING:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_MULTILINESTRING;
+      break;
+    case GEOS_MULTIPOLYGON:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON;
+      break;
+    case GEOS_GEOMETRYCOLLECTION:
+      geometry_type = GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+      break;
+    default:
+      GeoArrowErrorSet(&builder->error, "Unexpected GEOSGeomTypeId: %d", type_id);
+      return EINVAL;
+  }
+
+  // Native writers accept their own geometry type or, for multi types, the
+  // corresponding single type
+  if (top_level && builder->type != GEOARROW_TYPE_WKB &&
+      builder->type != GEOARROW_TYPE_WKT && geometry_type != builder->geometry_type &&
+      (geometry_type + 3) != builder->geometry_type) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't write geometry type %d to an array of geometry type %d",
+                     (int)geometry_type, (int)builder->geometry_type);
+    return EINVAL;
+  }
+
+  if (geometry_type < GEOARROW_GEOMETRY_TYPE_MULTIPOINT) {
+    return GEOARROW_OK;
+  }
+
+  int size = GEOSGetNumGeometries_r(builder->handle, geom);
+  for (int i = 0; i < size; i++) {
+    const GEOSGeometry* child = GEOSGetGeometryN_r(builder->handle, geom, i);
+    if (child == NULL) {
+      GeoArrowErrorSet(&builder->error, "GEOSGetGeometryN_r() failed");
+      return ENOMEM;
+    }
+
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderCheckGeometry(builder, child, 0));
+  }
+
+  return GEOARROW_OK;
+}
+
+// Appends features directly to the builder's own buffers for native output,
+// copying each GEOSCoordSequence straight into the final coordinate buffers.
+// These mirror VisitGeometry() for the geometry types the output accepts.
+// Linestrings are always written at the last offset level and polygons at the
+// one before it, whether or not they are parts of a multi geometry.
+typedef GeoArrowErrorCode (*GeoArrowGEOSPartAppender)(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom);
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderReserveDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSBuffer* buffer,
+    int64_t additional_bytes) {
+  if ((buffer->size_bytes + additional_bytes) <= buffer->capacity_bytes) {
+    return GEOARROW_OK;
+  }
+
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  GeoArrowErrorCode result = GeoArrowGEOSBufferReserve(buffer, additional_bytes);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_alloc);
+  builder->perf.counters.n_scratch_reallocs++;
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to reserve %ld bytes",
+                     (long)additional_bytes);
+    return ENOMEM;
+  }
+
+  return GEOARROW_OK;
+}
+
+// Sets bit i of bitmap. The bitmap is only allocated once the first null is
+// appended and is extended with all-valid bytes as needed.
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendBit(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSBuffer* bitmap,
+    int64_t i, int valid, int64_t* null_count) {
+  if (valid && bitmap->data == NULL) {
+    return GEOARROW_OK;
+  }
+
+  int64_t n_bytes = i / 8 + 1;
+  if (bitmap->size_bytes < n_bytes) {
+    int64_t n_new = n_bytes - bitmap->size_bytes;
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderReserveDirect(builder, bitmap, n_new));
+    memset(bitmap->data + bitmap->size_bytes, 0xff, n_new);
+    bitmap->size_bytes = n_bytes;
+  }
+
+  if (!valid) {
+    bitmap->data[i / 8] &= (uint8_t) ~(1 << (i % 8));
+    (*null_count)++;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendValidity(
+    struct GeoArrowGEOSArrayBuilder* builder, int valid) {
+  return GeoArrowGEOSArrayBuilderAppendBit(builder, &builder->validity,
+                                           builder->level_length[0], valid,
+                                           &builder->null_count);
+}
+
+// Appends the bounds of the current feature (or a null) to the bounds buffers
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, int valid) {
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendBit(
+      builder, &builder->bounds_validity, builder->bounds_length, valid,
+      &builder->bounds_null_count));
+
+  int n_dims = builder->bounds_dims;
+  for (int i = 0; i < (2 * n_dims); i++) {
+    struct GeoArrowGEOSBuffer* buffer = builder->bounds + i;
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, sizeof(double)));
+    memcpy(buffer->data + buffer->size_bytes, builder->feature_bounds + i,
+           sizeof(double));
+    buffer->size_bytes += sizeof(double);
+  }
+
+  for (int i = 0; valid && i < n_dims; i++) {
+    double* total = builder->total_bounds;
+    double* feature = builder->feature_bounds;
+    total[i] = feature[i] < total[i] ? feature[i] : total[i];
+    total[n_dims + i] = feature[n_dims + i] > total[n_dims + i] ? feature[n_dims + i]
+                                                                : total[n_dims + i];
+  }
+
+  builder->bounds_length++;
+  return GEOARROW_OK;
+}
+
+// Moves the bounds computed by worker to the end of builder's bounds
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderCollectBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSArrayBuilder* worker) {
+  const uint8_t* bits = worker->bounds_validity.data;
+  for (int64_t i = 0; i < worker->bounds_length; i++) {
+    int valid = bits == NULL || (i / 8) >= worker->bounds_validity.size_bytes ||
+                (bits[i / 8] & (1 << (i % 8)));
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendBit(
+        builder, &builder->bounds_validity, builder->bounds_length + i, valid,
+        &builder->bounds_null_count));
+  }
+
+  int n_dims = builder->bounds_dims;
+  for (int i = 0; i < (2 * n_dims); i++) {
+    struct GeoArrowGEOSBuffer* buffer = builder->bounds + i;
+    int64_t n_bytes = worker->bounds[i].size_bytes;
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, n_bytes));
+    if (n_bytes > 0) {
+      memcpy(buffer->data + buffer->size_bytes, worker->bounds[i].data, n_bytes);
+    }
+    buffer->size_bytes += n_bytes;
+  }
+
+  for (int i = 0; i < n_dims; i++) {
+    double* total = builder->total_bounds;
+    const double* other = worker->total_bounds;
+    total[i] = other[i] < total[i] ? other[i] : total[i];
+    total[n_dims + i] = other[n_dims + i] > total[n_dims + i] ? other[n_dims + i]
+                                                              : total[n_dims + i];
+  }
+
+  builder->bounds_length += worker->bounds_length;
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, int n_dims) {
+  if (n_dims != 0 && n_dims != 2 && n_dims != 3) {
+    GeoArrowErrorSet(&builder->error, "Expected 0, 2, or 3 bounds dimensions but got %d",
+                     n_dims);
+    return EINVAL;
+  }
+
+  if (builder->chunk_length > 0 || builder->n_chunks > 0 || builder->bounds_length > 0) {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't change bounds after features have been appended");
+    return EINVAL;
+  }
+
+  builder->bounds_dims = n_dims;
+  GeoArrowGEOSArrayBuilderResetBounds(builder);
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderGetBoundsSchema(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowSchema* out) {
+  static const char* names[2][6] = {{"xmin", "ymin", "xmax", "ymax", NULL, NULL},
+                                    {"xmin", "ymin", "zmin", "xmax", "ymax", "zmax"}};
+  if (builder->bounds_dims == 0) {
+    GeoArrowErrorSet(&builder->error, "Bounds are not computed by this builder");
+    return EINVAL;
+  }
+
+  int n_children = 2 * builder->bounds_dims;
+  memset(out, 0, sizeof(struct ArrowSchema));
+  out->release = &GeoArrowGEOSSchemaRelease;
+  out->format = GeoArrowGEOSStrdup("+s");
+  out->name = GeoArrowGEOSStrdup("");
+  out->flags = ARROW_FLAG_NULLABLE;
+  out->children = (struct ArrowSchema**)calloc(n_children, sizeof(struct ArrowSchema*));
+  if (out->format == NULL || out->name == NULL || out->children == NULL) {
+    out->release(out);
+    GeoArrowErrorSet(&builder->error, "Failed to allocate bounds schema");
+    return ENOMEM;
+  }
+
+  for (int i = 0; i < n_children; i++) {
+    struct ArrowSchema* child =
+        (struct ArrowSchema*)calloc(1, sizeof(struct ArrowSchema));
+    if (child == NULL) {
+      out->release(out);
+      GeoArrowErrorSet(&builder->error, "Failed to allocate bounds schema");
+      return ENOMEM;
+    }
+
+    out->children[i] = child;
+    out->n_children++;
+    child->release = &GeoArrowGEOSSchemaRelease;
+    child->format = GeoArrowGEOSStrdup("g");
+    child->name = GeoArrowGEOSStrdup(names[builder->bounds_dims - 2][i]);
+    child->flags = ARROW_FLAG_NULLABLE;
+    if (child->format == NULL || child->name == NULL) {
+      out->release(out);
+      GeoArrowErrorSet(&builder->error, "Failed to allocate bounds schema");
+      return ENOMEM;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinishBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out,
+    double* total_bounds) {
+  if (builder->bounds_dims == 0) {
+    GeoArrowErrorSet(&builder->error, "Bounds are not computed by this builder");
+    return EINVAL;
+  }
+
+  int n_children = 2 * builder->bounds_dims;
+  if (GeoArrowGEOSArrayInit(out, 1, n_children, builder->allocator) != GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to allocate bounds array");
+    return ENOMEM;
+  }
+
+  for (int i = 0; i < n_children; i++) {
+    if (GeoArrowGEOSArrayInit(out->children[i], 2, 0, builder->allocator) !=
+        GEOARROW_OK) {
+      out->release(out);
+      GeoArrowErrorSet(&builder->error, "Failed to allocate bounds array");
+      return ENOMEM;
+    }
+
+    out->children[i]->length = builder->bounds_length;
+    GeoArrowGEOSArraySetBuffer(out->children[i], 1, builder->bounds + i);
+  }
+
+  out->length = builder->bounds_length;
+  out->null_count = builder->bounds_null_count;
+  if (builder->bounds_null_count > 0) {
+    GeoArrowGEOSArraySetBuffer(out, 0, &builder->bounds_validity);
+  }
+
+  if (total_bounds != NULL) {
+    memcpy(total_bounds, builder->total_bounds, n_children * sizeof(double));
+  }
+
+  GeoArrowGEOSArrayBuilderResetBounds(builder);
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendOffset(
+    struct GeoArrowGEOSArrayBuilder* builder, int level) {
+  struct GeoArrowGEOSBuffer* buffer = builder->offsets + level;
+  GEOARROW_RETURN_NOT_OK(
+      GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, sizeof(int32_t)));
+  int32_t value = (int32_t)builder->level_length[level + 1];
+  memcpy(buffer->data + buffer->size_bytes, &value, sizeof(int32_t));
+  buffer->size_bytes += sizeof(int32_t);
+  builder->level_length[level]++;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendEmptyCoord(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  const double nan = NAN;
+  if (builder->interleaved) {
+    struct GeoArrowGEOSBuffer* buffer = builder->coords_direct;
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderReserveDirect(
+        builder, buffer, builder->n_dims * sizeof(double)));
+    for (int i = 0; i < builder->n_dims; i++) {
+      memcpy(buffer->data + buffer->size_bytes, &nan, sizeof(double));
+      buffer->size_bytes += sizeof(double);
+    }
+  } else {
+    for (int i = 0; i < builder->n_dims; i++) {
+      struct GeoArrowGEOSBuffer* buffer = builder->coords_direct + i;
+      GEOARROW_RETURN_NOT_OK(
+          GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, sizeof(double)));
+      memcpy(buffer->data + buffer->size_bytes, &nan, sizeof(double));
+      buffer->size_bytes += sizeof(double);
+    }
+  }
+
+  builder->level_length[builder->n_offsets]++;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendCoords(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom) {
+  const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, geom);
+  if (seq == NULL) {
+    GeoArrowErrorSet(&builder->error, "GEOSGeom_getCoordSeq_r() failed");
+    return ENOMEM;
+  }
+
+  unsigned int size = 0;
+  if (!GEOSCoordSeq_getSize_r(builder->handle, seq, &size)) {
+    GeoArrowErrorSet(&builder->error, "GEOSCoordSeq_getSize_r() failed");
+    return ENOMEM;
+  }
+
+  if (size == 0) {
+    return GEOARROW_OK;
+  }
+
+  int result;
+  int64_t start;
+  if (builder->interleaved) {
+    struct GeoArrowGEOSBuffer* buffer = builder->coords_direct;
+    int64_t n_bytes = (int64_t)size * builder->n_dims * sizeof(double);
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, n_bytes));
+    double* coords = (double*)(buffer->data + buffer->size_bytes);
+    start = GeoArrowGEOSPerfStart(&builder->perf);
+    result = GEOSCoordSeq_copyToBuffer_r(builder->handle, seq, coords,
+                                         builder->n_dims == 3, 0);
+    GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_coords);
+    buffer->size_bytes += n_bytes;
+    GeoArrowGEOSArrayBuilderUpdateBoundsInterleaved(builder, coords, size,
+                                                    builder->n_dims);
+  } else {
+    double* values[3] = {NULL, NULL, NULL};
+    for (int i = 0; i < builder->n_dims; i++) {
+      struct GeoArrowGEOSBuffer* buffer = builder->coords_direct + i;
+      GEOARROW_RETURN_NOT_OK(
+          GeoArrowGEOSArrayBuilderReserveDirect(builder, buffer, size * sizeof(double)));
+      values[i] = (double*)(buffer->data + buffer->size_bytes);
+      buffer->size_bytes += size * sizeof(double);
+    }
+
+    start = GeoArrowGEOSPerfStart(&builder->perf);
+    result = GEOSCoordSeq_copyToArrays_r(builder->handle, seq, values[0], values[1],
+                                         values[2], NULL);
+    GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_coords);
+    GeoArrowGEOSArrayBuilderUpdateBounds(builder, (const double**)values,
+                                         builder->n_dims, size, 1);
+  }
+
+  if (result == 0) {
+    GeoArrowErrorSet(&builder->error, "Failed to copy coordinates");
+    return ENOMEM;
+  }
+
+  builder->level_length[builder->n_offsets] += size;
+  builder->perf.counters.n_coords += size;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendPoint(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom) {
+  if (GEOSisEmpty_r(builder->handle, geom)) {
+    return GeoArrowGEOSArrayBuilderAppendEmptyCoord(builder);
+  } else {
+    return GeoArrowGEOSArrayBuilderAppendCoords(builder, geom);
+  }
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendLinestring(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom) {
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendCoords(builder, geom));
+  return GeoArrowGEOSArrayBuilderAppendOffset(builder, builder->n_offsets - 1);
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendPolygon(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom) {
+  int level = builder->n_offsets - 2;
+  if (GEOSisEmpty_r(builder->handle, geom)) {
+    return GeoArrowGEOSArrayBuilderAppendOffset(builder, level);
+  }
+
+  const GEOSGeometry* ring = GEOSGetExteriorRing_r(builder->handle, geom);
+  if (ring == NULL) {
+    GeoArrowErrorSet(&builder->error, "GEOSGetExteriorRing_r() failed");
+    return ENOMEM;
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendLinestring(builder, ring));
+
+  int size = GEOSGetNumInteriorRings_r(builder->handle, geom);
+  for (int i = 0; i < size; i++) {
+    ring = GEOSGetInteriorRingN_r(builder->handle, geom, i);
+    if (ring == NULL) {
+      GeoArrowErrorSet(&builder->error, "GEOSGetInteriorRingN_r() failed");
+      return ENOMEM;
+    }
+
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendLinestring(builder, ring));
+  }
+
+  return GeoArrowGEOSArrayBuilderAppendOffset(builder, level);
+}
+
+// Returns the GeoArrow geometry type of a GEOSGeomTypeId_r() value (for error
+// messages that match GeoArrowGEOSArrayBuilderCheckGeometry())
+static int GeoArrowGEOSGeometryTypeFromGEOS(int type_id) {
+  switch (type_id) {
+    case GEOS_POINT:
+      return GEOARROW_GEOMETRY_TYPE_POINT;
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+      return GEOARROW_GEOMETRY_TYPE_LINESTRING;
+    case GEOS_POLYGON:
+      return GEOARROW_GEOMETRY_TYPE_POLYGON;
+    case GEOS_MULTIPOINT:
+      return GEOARROW_GEOMETRY_TYPE_MULTIPOINT;
+    case GEOS_MULTILINESTRING:
+      return GEOARROW_GEOMETRY_TYPE_MULTILINESTRING;
+    case GEOS_MULTIPOLYGON:
+      return GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON;
+    case GEOS_GEOMETRYCOLLECTION:
+      return GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+    default:
+      return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  }
+}
+
+// Appends a multi geometry (or a single geometry as a multi geometry with one
+// part) to a top-level multi array
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendMulti(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom, int type_id,
+    int single_type_id, int multi_type_id, GeoArrowGEOSPartAppender append_part) {
+  if (type_id == single_type_id ||
+      (single_type_id == GEOS_LINESTRING && type_id == GEOS_LINEARRING)) {
+    GEOARROW_RETURN_NOT_OK(append_part(builder, geom));
+  } else if (type_id == multi_type_id) {
+    int size = GEOSGetNumGeometries_r(builder->handle, geom);
+    for (int i = 0; i < size; i++) {
+      const GEOSGeometry* child = GEOSGetGeometryN_r(builder->handle, geom, i);
+      if (child == NULL) {
+        GeoArrowErrorSet(&builder->error, "GEOSGetGeometryN_r() failed");
+        return ENOMEM;
+      }
+
+      GEOARROW_RETURN_NOT_OK(append_part(builder, child));
+    }
+  } else {
+    GeoArrowErrorSet(&builder->error,
+                     "Can't write geometry type %d to an array of geometry type %d",
+                     GeoArrowGEOSGeometryTypeFromGEOS(type_id),
+                     (int)builder->geometry_type);
+    return EINVAL;
+  }
+
+  return GeoArrowGEOSArrayBuilderAppendOffset(builder, 0);
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendNull(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendValidity(builder, 0));
+  if (builder->n_offsets == 0) {
+    return GeoArrowGEOSArrayBuilderAppendEmptyCoord(builder);
+  } else {
+    return GeoArrowGEOSArrayBuilderAppendOffset(builder, 0);
+  }
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom) {
+  if (geom == NULL) {
+    return GeoArrowGEOSArrayBuilderAppendNull(builder);
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendValidity(builder, 1));
+
+  int type_id = GEOSGeomTypeId_r(builder->handle, geom);
+  switch (builder->geometry_type) {
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      if (type_id == GEOS_POINT) {
+        return GeoArrowGEOSArrayBuilderAppendPoint(builder, geom);
+      }
+      break;
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      if (type_id == GEOS_LINESTRING || type_id == GEOS_LINEARRING) {
+        return GeoArrowGEOSArrayBuilderAppendLinestring(builder, geom);
+      }
+      break;
+    case GEOARROW_GEOMETRY_TYPE_POLYGON:
+      if (type_id == GEOS_POLYGON) {
+        return GeoArrowGEOSArrayBuilderAppendPolygon(builder, geom);
+      }
+      break;
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+      return GeoArrowGEOSArrayBuilderAppendMulti(builder, geom, type_id, GEOS_POINT,
+                                                 GEOS_MULTIPOINT,
+                                                 &GeoArrowGEOSArrayBuilderAppendPoint);
+    case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+      return GeoArrowGEOSArrayBuilderAppendMulti(
+          builder, geom, type_id, GEOS_LINESTRING, GEOS_MULTILINESTRING,
+          &GeoArrowGEOSArrayBuilderAppendLinestring);
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+      return GeoArrowGEOSArrayBuilderAppendMulti(builder, geom, type_id, GEOS_POLYGON,
+                                                 GEOS_MULTIPOLYGON,
+                                                 &GeoArrowGEOSArrayBuilderAppendPolygon);
+    default:
+      break;
+  }
+
+  GeoArrowErrorSet(&builder->error,
+                   "Can't write geometry type %d to an array of geometry type %d",
+                   GeoArrowGEOSGeometryTypeFromGEOS(type_id),
+                   (int)builder->geometry_type);
+  return EINVAL;
+}
+
+// Serializes ISO WKB directly from GEOS geometries into the builder's data
+// buffer. The exact size of each feature is computed first so that the data
+// buffer is grown at most once per feature and never checked while writing.
+// Empty points are written as NaN coordinates (like GEOS and geoarrow-c).
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define GEOARROW_GEOS_WKB_ENDIAN 0x00
+#else
+#define GEOARROW_GEOS_WKB_ENDIAN 0x01
+#endif
+
+// Resolves the ISO WKB geometry type code (e.g., 1003 for POLYGON Z) and the
+// number of ordinates per coordinate for geom
+static GeoArrowErrorCode GeoArrowGEOSWKBHeader(GEOSContextHandle_t handle,
+                                                const GEOSGeometry* geom,
+                                                uint32_t* wkb_type, int* n_dims,
+                                                struct GeoArrowError* error) {
+  *n_dims = GEOSGeom_getCoordinateDimension_r(handle, geom);
+  if (*n_dims != 2 && *n_dims != 3) {
+    GeoArrowErrorSet(error, "Unexpected GEOSGeom_getCoordinateDimension_r: %d",
+                     *n_dims);
+    return EINVAL;
+  }
+
+  int type_id = GEOSGeomTypeId_r(handle, geom);
+  switch (type_id) {
+    case GEOS_POINT:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_POINT;
+      break;
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_LINESTRING;
+      break;
+    case GEOS_POLYGON:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_POLYGON;
+      break;
+    case GEOS_MULTIPOINT:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_MULTIPOINT;
+      break;
+    case GEOS_MULTILINESTRING:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_MULTILINESTRING;
+      break;
+    case GEOS_MULTIPOLYGON:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON;
+      break;
+    case GEOS_GEOMETRYCOLLECTION:
+      *wkb_type = GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+      break;
+    default:
+      GeoArrowErrorSet(error, "Unexpected GEOSGeomTypeId: %d", type_id);
+      return EINVAL;
+  }
+
+  if (*n_dims == 3) {
+    *wkb_type += 1000;
+  }
+
+  return GEOARROW_OK;
+}
+
+// Computes the exact number of bytes GeoArrowGEOSArrayBuilderWriteWKB() will
+// write for geom (zero for a null feature)
+static GeoArrowErrorCode GeoArrowGEOSWKBSize(GEOSContextHandle_t handle,
+                                             const GEOSGeometry* geom, int64_t* size,
+                                             struct GeoArrowError* error) {
+  if (geom == NULL) {
+    *size = 0;
+    return GEOARROW_OK;
+  }
+
+  uint32_t wkb_type;
+  int n_dims;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBHeader(handle, geom, &wkb_type, &n_dims, error));
+  int64_t coord_size = n_dims * sizeof(double);
+
+  switch (wkb_type % 1000) {
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      *size = 5 + coord_size;
+      return GEOARROW_OK;
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      *size = 9 + coord_size * GEOSGetNumCoordinates_r(handle, geom);
+      return GEOARROW_OK;
+    case GEOARROW_GEOMETRY_TYPE_POLYGON: {
+      int64_t n_rings = 0;
+      if (!GEOSisEmpty_r(handle, geom)) {
+        n_rings = 1 + GEOSGetNumInteriorRings_r(handle, geom);
+      }
+
+      *size = 9 + 4 * n_rings +
+              coord_size * GEOSGetNumCoordinates_r(handle, geom);
+      return GEOARROW_OK;
+    }
+    default: {
+      *size = 9;
+      int n_parts = GEOSGetNumGeometries_r(handle, geom);
+      for (int i = 0; i < n_parts; i++) {
+        const GEOSGeometry* child = GEOSGetGeometryN_r(handle, geom, i);
+        if (child == NULL) {
+          GeoArrowErrorSet(error, "GEOSGetGeometryN_r() failed");
+          return ENOMEM;
+        }
+
+        int64_t child_size;
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBSize(handle, child, &child_size, error));
+        *size += child_size;
+      }
+
+      return GEOARROW_OK;
+    }
+  }
+}
+
+static inline void GeoArrowGEOSWriteUInt32(uint8_t** cursor, uint32_t value) {
+  memcpy(*cursor, &value, sizeof(uint32_t));
+  *cursor += sizeof(uint32_t);
+}
+
+// Writes the coordinates of geom (optionally preceded by their count). The
+// coordinates in the output aren't aligned, so they are copied through the
+// builder's scratch buffer.
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderWriteWKBCoords(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom, int n_dims,
+    int write_count, uint8_t** cursor) {
+  const GEOSCoordSequence* seq = GEOSGeom_getCoordSeq_r(builder->handle, geom);
+  if (seq == NULL) {
+    GeoArrowErrorSet(&builder->error, "GEOSGeom_getCoordSeq_r() failed");
+    return ENOMEM;
+  }
+
+  unsigned int size = 0;
+  if (!GEOSCoordSeq_getSize_r(builder->handle, seq, &size)) {
+    GeoArrowErrorSet(&builder->error, "GEOSCoordSeq_getSize_r() failed");
+    return ENOMEM;
+  }
+
+  if (write_count) {
+    GeoArrowGEOSWriteUInt32(cursor, size);
+  }
+
+  if (size == 0) {
+    return GEOARROW_OK;
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderEnsureCoords(builder, size, n_dims));
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  int result =
+      GEOSCoordSeq_copyToBuffer_r(builder->handle, seq, builder->coords, n_dims == 3, 0);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_coords);
+  builder->perf.counters.n_coords += size;
+  if (!result) {
+    GeoArrowErrorSet(&builder->error, "GEOSCoordSeq_copyToBuffer_r() failed");
+    return ENOMEM;
+  }
+
+  GeoArrowGEOSArrayBuilderUpdateBoundsInterleaved(builder, builder->coords, size, n_dims);
+  size_t n_bytes = (size_t)size * n_dims * sizeof(double);
+  memcpy(*cursor, builder->coords, n_bytes);
+  *cursor += n_bytes;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderWriteWKB(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom,
+    uint8_t** cursor) {
+  uint32_t wkb_type;
+  int n_dims;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBHeader(builder->handle, geom, &wkb_type, &n_dims,
+                                               &builder->error));
+
+  **cursor = GEOARROW_GEOS_WKB_ENDIAN;
+  *cursor += 1;
+  GeoArrowGEOSWriteUInt32(cursor, wkb_type);
+
+  switch (wkb_type % 1000) {
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      if (GEOSisEmpty_r(builder->handle, geom)) {
+        const double nan = NAN;
+        for (int i = 0; i < n_dims; i++) {
+          memcpy(*cursor, &nan, sizeof(double));
+          *cursor += sizeof(double);
+        }
+
+        return GEOARROW_OK;
+      }
+
+      return GeoArrowGEOSArrayBuilderWriteWKBCoords(builder, geom, n_dims, 0, cursor);
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      return GeoArrowGEOSArrayBuilderWriteWKBCoords(builder, geom, n_dims, 1, cursor);
+    case GEOARROW_GEOMETRY_TYPE_POLYGON: {
+      if (GEOSisEmpty_r(builder->handle, geom)) {
+        GeoArrowGEOSWriteUInt32(cursor, 0);
+        return GEOARROW_OK;
+      }
+
+      int n_interior = GEOSGetNumInteriorRings_r(builder->handle, geom);
+      GeoArrowGEOSWriteUInt32(cursor, 1 + n_interior);
+
+      const GEOSGeometry* ring = GEOSGetExteriorRing_r(builder->handle, geom);
+      if (ring == NULL) {
+        GeoArrowErrorSet(&builder->error, "GEOSGetExteriorRing_r() failed");
+        return ENOMEM;
+      }
+
+      GEOARROW_RETURN_NOT_OK(
+          GeoArrowGEOSArrayBuilderWriteWKBCoords(builder, ring, n_dims, 1, cursor));
+
+      for (int i = 0; i < n_interior; i++) {
+        ring = GEOSGetInteriorRingN_r(builder->handle, geom, i);
+        if (ring == NULL) {
+          GeoArrowErrorSet(&builder->error, "GEOSGetInteriorRingN_r() failed");
+          return ENOMEM;
+        }
+
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowGEOSArrayBuilderWriteWKBCoords(builder, ring, n_dims, 1, cursor));
+      }
+
+      return GEOARROW_OK;
+    }
+    default: {
+      int n_parts = GEOSGetNumGeometries_r(builder->handle, geom);
+      GeoArrowGEOSWriteUInt32(cursor, n_parts);
+      for (int i = 0; i < n_parts; i++) {
+        const GEOSGeometry* child = GEOSGetGeometryN_r(builder->handle, geom, i);
+        if (child == NULL) {
+          GeoArrowErrorSet(&builder->error, "GEOSGetGeometryN_r() failed");
+          return ENOMEM;
+        }
+
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderWriteWKB(builder, child, cursor));
+      }
+
+      return GEOARROW_OK;
+    }
+  }
+}
+
+// Appends a feature whose serialized size (from GeoArrowGEOSWKBSize())
+// is size bytes
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendWKB(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* geom, int64_t size) {
+  if (geom == NULL) {
+    return GeoArrowGEOSArrayBuilderAppendNull(builder);
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendValidity(builder, 1));
+  GEOARROW_RETURN_NOT_OK(
+      GeoArrowGEOSArrayBuilderReserveDirect(builder, &builder->data, size));
+
+  uint8_t* start = builder->data.data + builder->data.size_bytes;
+  uint8_t* cursor = start;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderWriteWKB(builder, geom, &cursor));
+  if ((cursor - start) != size) {
+    GeoArrowErrorSet(&builder->error, "Expected to write %ld WKB bytes but wrote %ld",
+                     (long)size, (long)(cursor - start));
+    return EINVAL;
+  }
+
+  builder->data.size_bytes += size;
+  builder->level_length[1] += size;
+  return GeoArrowGEOSArrayBuilderAppendOffset(builder, 0);
+}
+
+// The sizes of the buffers written directly before a feature, so that a feature
+// that fails part way through can be removed in GEOARROW_GEOS_ON_ERROR_NULL mode
+struct GeoArrowGEOSDirectMark {
+  int64_t level_length[4];
+  int64_t null_count;
+  int64_t validity_size;
+  int64_t offsets_size[3];
+  int64_t coords_size[3];
+  int64_t data_size;
+};
+
+static void GeoArrowGEOSArrayBuilderMark(struct GeoArrowGEOSArrayBuilder* builder,
+                                         struct GeoArrowGEOSDirectMark* mark) {
+  memcpy(mark->level_length, builder->level_length, sizeof(builder->level_length));
+  mark->null_count = builder->null_count;
+  mark->validity_size = builder->validity.size_bytes;
+  for (int i = 0; i < 3; i++) {
+    mark->offsets_size[i] = builder->offsets[i].size_bytes;
+    mark->coords_size[i] = builder->coords_direct[i].size_bytes;
+  }
+  mark->data_size = builder->data.size_bytes;
+}
+
+static void GeoArrowGEOSArrayBuilderRollback(struct GeoArrowGEOSArrayBuilder* builder,
+                                             const struct GeoArrowGEOSDirectMark* mark) {
+  memcpy(builder->level_length, mark->level_length, sizeof(builder->level_length));
+  builder->null_count = mark->null_count;
+  builder->validity.size_bytes = mark->validity_size;
+  for (int i = 0; i < 3; i++) {
+    builder->offsets[i].size_bytes = mark->offsets_size[i];
+    builder->coords_direct[i].size_bytes = mark->coords_size[i];
+  }
+  builder->data.size_bytes = mark->data_size;
+  GeoArrowGEOSBoundsInit(builder->feature_bounds, builder->bounds_dims);
+}
+
+// Records the error in builder->error for the feature about to be appended (as a
+// null) in GEOARROW_GEOS_ON_ERROR_NULL mode
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderRecordError(
+    struct GeoArrowGEOSArrayBuilder* builder) {
+  int64_t index = GeoArrowGEOSArrayBuilderSealedLength(builder) + builder->chunk_length;
+  if (GeoArrowGEOSFeatureErrorsAppend(&builder->errors, index, builder->error.message) !=
+      GEOARROW_OK) {
+    GeoArrowErrorSet(&builder->error, "Failed to record error for feature %ld",
+                     (long)index);
+    return ENOMEM;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderWriteDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* item, int64_t size) {
+  switch (builder->direct) {
+    case GEOARROW_GEOS_DIRECT_WKB:
+      return GeoArrowGEOSArrayBuilderAppendWKB(builder, item, size);
+    case GEOARROW_GEOS_DIRECT_NATIVE:
+      return GeoArrowGEOSArrayBuilderAppendDirect(builder, item);
+    default:
+      return GEOARROW_OK;
+  }
+}
+
+// Appends a single feature to the current chunk
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendFeature(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* item) {
+  // In GEOARROW_GEOS_ON_ERROR_NULL mode, output written directly is rolled back
+  // if the write fails; output written through the visitor is checked first
+  int on_error_null = builder->on_error == GEOARROW_GEOS_ON_ERROR_NULL;
+  if (on_error_null && item != NULL &&
+      (builder->direct == GEOARROW_GEOS_DIRECT_NONE || builder->verify_wkb) &&
+      GeoArrowGEOSArrayBuilderCheckGeometry(builder, item, 1) != GEOARROW_OK) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderRecordError(builder));
+    item = NULL;
+  }
+
+  // The size of a feature is only needed to write WKB. Otherwise, we track the
+  // largest offset after writing and only compute a bound before writing in the
+  // last eighth of the range of the chunk's offsets (assuming that no single
+  // feature needs more than that).
+  int64_t size = 0;
+  if (builder->direct == GEOARROW_GEOS_DIRECT_WKB) {
+    GeoArrowErrorCode result =
+        GeoArrowGEOSWKBSize(builder->handle, item, &size, &builder->error);
+    if (result == EINVAL && on_error_null) {
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderRecordError(builder));
+      item = NULL;
+      size = 0;
+    } else if (result != GEOARROW_OK) {
+      return result;
+    }
+  } else if (builder->chunk_size > builder->max_offset - builder->max_offset / 8) {
+    size = GeoArrowGEOSArrayBuilderSizeBound(builder, item);
+  }
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderReserveFeature(builder, size));
+  GeoArrowGEOSBoundsInit(builder->feature_bounds, builder->bounds_dims);
+
+  if (builder->direct != GEOARROW_GEOS_DIRECT_NONE) {
+    // Only invalid features are written as null: allocation failures still fail
+    struct GeoArrowGEOSDirectMark mark;
+    if (on_error_null) {
+      GeoArrowGEOSArrayBuilderMark(builder, &mark);
+    }
+
+    GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderWriteDirect(builder, item, size);
+    if (result == EINVAL && on_error_null && item != NULL) {
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderRecordError(builder));
+      GeoArrowGEOSArrayBuilderRollback(builder, &mark);
+      item = NULL;
+      result = GeoArrowGEOSArrayBuilderWriteDirect(builder, NULL, 0);
+    }
+
+    GEOARROW_RETURN_NOT_OK(result);
+  }
+
+  if (builder->direct == GEOARROW_GEOS_DIRECT_NONE || builder->verify_wkb) {
+    GEOARROW_RETURN_NOT_OK(builder->v.feat_start(&builder->v));
+    GEOARROW_RETURN_NOT_OK(VisitGeometry(builder, item, &builder->v));
+    GEOARROW_RETURN_NOT_OK(builder->v.feat_end(&builder->v));
+  }
+
+  if (builder->direct != GEOARROW_GEOS_DIRECT_NONE) {
+    builder->chunk_size = GeoArrowGEOSArrayBuilderDirectSize(builder);
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderCheckMaxOffset(
+        builder, builder->sealed_size + builder->chunk_size));
+  }
+
+  if (builder->bounds_dims > 0) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendBounds(builder, item != NULL));
+  }
+
+  builder->chunk_length++;
+  builder->perf.counters.n_features++;
+  return GEOARROW_OK;
+}
+
+#if defined(GEOARROW_GEOS_ENABLE_TRACING)
+// Appends a feature inside its own span if it has more than feature_threshold
+// coordinates
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendFeatureTraced(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry* item) {
+  int64_t size = 0;
+  if (builder->tracer != NULL && builder->feature_threshold > 0 && item != NULL) {
+    size = GEOSGetNumCoordinates_r(builder->handle, item);
+  }
+
+  if (size <= builder->feature_threshold) {
+    return GeoArrowGEOSArrayBuilderAppendFeature(builder, item);
+  }
+
+  int64_t index = GeoArrowGEOSArrayBuilderSealedLength(builder) + builder->chunk_length;
+  GEOARROW_GEOS_TRACE_BEGIN(builder->tracer, "feature", index, size);
+  GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderAppendFeature(builder, item);
+  GEOARROW_GEOS_TRACE_END(builder->tracer, "feature", index, size);
+  return result;
+}
+#else
+#define GeoArrowGEOSArrayBuilderAppendFeatureTraced GeoArrowGEOSArrayBuilderAppendFeature
+#endif
+
+// Appends geom, destroying each geometry after it has been written if owned is
+// non-zero
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendFeatures(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    int owned, size_t* n_appended) {
+  *n_appended = 0;
+
+  for (size_t i = 0; i < geom_size; i++) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderAppendFeatureTraced(builder, geom[i]));
+    *n_appended = i + 1;
+
+    if (owned && geom[i] != NULL) {
+      GEOSGeom_destroy_r(builder->handle, (GEOSGeometry*)geom[i]);
+      geom[i] = NULL;
+    }
+
+    if (GeoArrowGEOSArrayBuilderChunkIsFull(builder)) {
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderSealChunk(builder));
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendInternal(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    int owned, size_t* n_appended) {
+  const char* name =
+      owned ? "GeoArrowGEOSArrayBuilderAppendOwned" : "GeoArrowGEOSArrayBuilderAppend";
+  int64_t index = GeoArrowGEOSArrayBuilderSealedLength(builder) + builder->chunk_length;
+
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(builder->tracer, name, index, geom_size);
+  GeoArrowErrorCode result =
+      GeoArrowGEOSArrayBuilderAppendFeatures(builder, geom, geom_size, owned, n_appended);
+  GEOARROW_GEOS_TRACE_END(builder->tracer, name, index, geom_size);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_total);
+  return result;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppend(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    size_t* n_appended) {
+  return GeoArrowGEOSArrayBuilderAppendInternal(builder, geom, geom_size, 0, n_appended);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppendOwned(
+    struct GeoArrowGEOSArrayBuilder* builder, GEOSGeometry** geom, size_t geom_size,
+    size_t* n_appended) {
+  return GeoArrowGEOSArrayBuilderAppendInternal(builder, (const GEOSGeometry**)geom,
+                                                geom_size, 1, n_appended);
+}
+
+struct GeoArrowGEOSBuildTask {
+  struct GeoArrowGEOSArrayBuilder* builder;
+  GEOSContextHandle_t handle;
+  const GEOSGeometry** geom;
+  size_t offset;
+  size_t length;
+  size_t n_appended;
+  GeoArrowErrorCode result;
+};
+
+static void GeoArrowGEOSBuildTaskRun(void* task_void) {
+  struct GeoArrowGEOSBuildTask* task = (struct GeoArrowGEOSBuildTask*)task_void;
+  task->result = GeoArrowGEOSArrayBuilderAppend(task->builder, task->geom, task->length,
+                                                &task->n_appended);
+  if (task->result == GEOARROW_OK && task->builder->chunk_length > 0) {
+    task->result = GeoArrowGEOSArrayBuilderSealChunk(task->builder);
+  }
+}
+
+// Creates a worker builder with the same output type and options as parent that
+// uses its own GEOS context. Workers always seal chunks before their offsets
+// would overflow; whether the combined output may be large is checked when the
+// chunks are collected by the parent.
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderCreateWorker(
+    struct GeoArrowGEOSArrayBuilder* parent, GEOSContextHandle_t handle,
+    struct GeoArrowGEOSArrayBuilder** out) {
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderCreateWithAllocator(
+      handle, &parent->schema, parent->allocator, out));
+  (*out)->large_offsets = GEOARROW_GEOS_LARGE_OFFSETS_AUTO;
+  (*out)->max_offset = parent->max_offset;
+  (*out)->on_error = parent->on_error;
+  (*out)->verify_wkb = parent->verify_wkb;
+  (*out)->max_chunk_rows = parent->max_chunk_rows;
+  (*out)->max_chunk_bytes = parent->max_chunk_bytes;
+  (*out)->bounds_dims = parent->bounds_dims;
+  (*out)->perf.collect_timings = parent->perf.collect_timings;
+  (*out)->tracer = parent->tracer;
+  (*out)->feature_threshold = parent->feature_threshold;
+  GeoArrowGEOSArrayBuilderResetBounds(*out);
+
+  if (parent->n_dims != 0 && (*out)->direct != parent->direct) {
+    return GeoArrowGEOSArrayBuilderSetDirect(*out,
+                                             parent->direct != GEOARROW_GEOS_DIRECT_NONE);
+  }
+
+  return GEOARROW_OK;
+}
+
+// Moves the chunks of each (successful) task into builder in input order
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderCollectTasks(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSBuildTask* tasks,
+    int n_tasks) {
+  int64_t n_chunks = 0;
+  int64_t size = builder->sealed_size;
+  for (int i = 0; i < n_tasks; i++) {
+    n_chunks += tasks[i].builder->n_chunks;
+    size += tasks[i].builder->sealed_size;
+  }
+
+  // Workers only hold sealed chunks, whose sizes are exact
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderCheckMaxOffset(builder, size));
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderReserveChunks(builder, n_chunks));
+
+  int64_t index = GeoArrowGEOSArrayBuilderSealedLength(builder);
+
+  for (int i = 0; i < n_tasks; i++) {
+    struct GeoArrowGEOSArrayBuilder* worker = tasks[i].builder;
+    struct GeoArrowGEOSFeatureErrors* errors = &worker->errors;
+    for (int64_t j = 0; j < errors->size; j++) {
+      if (GeoArrowGEOSFeatureErrorsAppend(&builder->errors, index + errors->indices[j],
+                                          errors->messages[j]) != GEOARROW_OK) {
+        GeoArrowErrorSet(&builder->error, "Failed to collect feature errors");
+        return ENOMEM;
+      }
+    }
+
+    if (builder->bounds_dims > 0) {
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderCollectBounds(builder, worker));
+    }
+
+    memcpy(builder->chunks + builder->n_chunks, worker->chunks,
+           worker->n_chunks * sizeof(struct ArrowArray));
+    memcpy(builder->chunk_sizes + builder->n_chunks, worker->chunk_sizes,
+           worker->n_chunks * sizeof(int64_t));
+    builder->n_chunks += worker->n_chunks;
+    builder->sealed_size += worker->sealed_size;
+    index += tasks[i].length;
+    worker->n_chunks = 0;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayBuilderAppendParallelInternal(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    int n_threads, size_t* n_appended) {
+  *n_appended = 0;
+  if (geom_size == 0) {
+    return GEOARROW_OK;
+  }
+
+  // A single shard still goes through a worker (run on this thread) so that an
+  // error leaves nothing appended
+  if (n_threads > (int64_t)geom_size) {
+    n_threads = (int)geom_size;
+  } else if (n_threads < 1) {
+    n_threads = 1;
+  }
+
+  // Features appended so far go before the shards
+  if (builder->chunk_length > 0) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayBuilderSealChunk(builder));
+  }
+
+  struct GeoArrowGEOSBuildTask* tasks = (struct GeoArrowGEOSBuildTask*)calloc(
+      n_threads, sizeof(struct GeoArrowGEOSBuildTask));
+  if (tasks == NULL) {
+    GeoArrowErrorSet(&builder->error, "Failed to allocate %d build tasks", n_threads);
+    return ENOMEM;
+  }
+
+  GeoArrowErrorCode result = GEOARROW_OK;
+  int n_tasks = 0;
+  for (; n_tasks < n_threads; n_tasks++) {
+    struct GeoArrowGEOSBuildTask* task = tasks + n_tasks;
+    task->offset = (geom_size * n_tasks) / n_threads;
+    task->length = (geom_size * (n_tasks + 1)) / n_threads - task->offset;
+    task->geom = geom + task->offset;
+
+    task->handle = GEOS_init_r();
+    if (task->handle == NULL) {
+      GeoArrowErrorSet(&builder->error, "GEOS_init_r() failed");
+      result = ENOMEM;
+      break;
+    }
+
+    result = GeoArrowGEOSArrayBuilderCreateWorker(builder, task->handle, &task->builder);
+    if (result != GEOARROW_OK) {
+      // Still count this task so that its GEOS context (and builder, if it was
+      // allocated) are cleaned up below
+      GeoArrowErrorSet(&builder->error, "Failed to initialize build task");
+      n_tasks++;
+      break;
+    }
+  }
+
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSRunTasks(&GeoArrowGEOSBuildTaskRun, tasks,
+                                  sizeof(struct GeoArrowGEOSBuildTask), n_tasks);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&builder->error, "Failed to start build tasks");
+    }
+  }
+
+  for (int i = 0; i < n_tasks && result == GEOARROW_OK; i++) {
+    if (tasks[i].result != GEOARROW_OK) {
+      result = tasks[i].result;
+      GeoArrowErrorSet(&builder->error, "[offset %ld] %s",
+                       (long)(tasks[i].offset + tasks[i].n_appended),
+                       tasks[i].builder->error.message);
+    }
+  }
+
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSArrayBuilderCollectTasks(builder, tasks, n_tasks);
+  }
+
+  if (result == GEOARROW_OK) {
+    *n_appended = geom_size;
+  }
+
+  for (int i = 0; i < n_tasks; i++) {
+    if (tasks[i].builder != NULL) {
+      // The whole call (rather than each worker's) is counted in ns_total
+      tasks[i].builder->perf.counters.ns_total = 0;
+      GeoArrowGEOSCountersAdd(&builder->perf.counters,
+                              &tasks[i].builder->perf.counters);
+      GeoArrowGEOSArrayBuilderDestroy(tasks[i].builder);
+    }
+
+    if (tasks[i].handle != NULL) {
+      GEOS_finish_r(tasks[i].handle);
+    }
+  }
+
+  free(tasks);
+  return result;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppendParallel(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    int n_threads, size_t* n_appended) {
+  int64_t index = GeoArrowGEOSArrayBuilderSealedLength(builder) + builder->chunk_length;
+
+  int64_t start = GeoArrowGEOSPerfStart(&builder->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(builder->tracer, "GeoArrowGEOSArrayBuilderAppendParallel",
+                            index, geom_size);
+  GeoArrowErrorCode result = GeoArrowGEOSArrayBuilderAppendParallelInternal(
+      builder, geom, geom_size, n_threads, n_appended);
+  GEOARROW_GEOS_TRACE_END(builder->tracer, "GeoArrowGEOSArrayBuilderAppendParallel",
+                          index, geom_size);
+  GeoArrowGEOSPerfStop(&builder->perf, start, &builder->perf.counters.ns_total);
+  return result;
+}
+
+// This should really be in nanoarrow and/or geoarrow. Validity is scanned
+// 64 bits at a time so that readers can process runs of valid features
+// without checking each bit (and a missing bitmap is a single run).
+struct GeoArrowGEOSBitmapReader {
+  const uint8_t* bits;
+  int64_t i;
+  int64_t end;
+};
+
+static inline int GeoArrowGEOSCountTrailingZeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long out;
+  _BitScanForward64(&out, x);
+  return (int)out;
+#else
+  int out = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    out++;
+  }
+  return out;
+#endif
+}
+
+static inline void GeoArrowGEOSBitmapReaderInit(
+    struct GeoArrowGEOSBitmapReader* bitmap_reader, const uint8_t* bits, int64_t offset,
+    int64_t length) {
+  bitmap_reader->bits = bits;
+  bitmap_reader->i = offset;
+  bitmap_reader->end = offset + length;
+}
+
+// Returns the (up to) 64 bits starting at the current position in the low
+// bits of the result. Only 64 - (i % 8) of these bits are meaningful.
+static inline uint64_t GeoArrowGEOSBitmapReaderLoad(
+    const struct GeoArrowGEOSBitmapReader* bitmap_reader) {
+  int64_t byte_i = bitmap_reader->i / 8;
+  int64_t n_bytes = (bitmap_reader->end + 7) / 8 - byte_i;
+  uint64_t word = 0;
+  if (n_bytes >= 8) {
+    memcpy(&word, bitmap_reader->bits + byte_i, sizeof(uint64_t));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+  } else {
+    for (int64_t j = 0; j < n_bytes; j++) {
+      word |= (uint64_t)bitmap_reader->bits[byte_i + j] << (8 * j);
+    }
+  }
+
+  return word >> (bitmap_reader->i % 8);
+}
+
+// Advances past (at most max_bits) bits equal to value, returning the number
+// of bits skipped
+static inline int64_t GeoArrowGEOSBitmapReaderSkip(
+    struct GeoArrowGEOSBitmapReader* bitmap_reader, int value, int64_t max_bits) {
+  if ((bitmap_reader->end - bitmap_reader->i) < max_bits) {
+    max_bits = bitmap_reader->end - bitmap_reader->i;
+  }
+
+  int64_t n = 0;
+  while (n < max_bits) {
+    int64_t n_available = 64 - (bitmap_reader->i % 8);
+    uint64_t word = GeoArrowGEOSBitmapReaderLoad(bitmap_reader);
+    if (value) {
+      word = ~word;
+    }
+
+    int64_t run = word == 0 ? 64 : GeoArrowGEOSCountTrailingZeros64(word);
+    if (run > n_available) {
+      run = n_available;
+    }
+
+    if (run > (max_bits - n)) {
+      run = max_bits - n;
+    }
+
+    n += run;
+    bitmap_reader->i += run;
+    if (run < n_available) {
+      break;
+    }
+  }
+
+  return n;
+}
+
+// Sets out to NULL for the run of null features starting at *i, advances *i
+// past them, and returns the end of the run of valid features that follows
+static inline size_t GeoArrowGEOSBitmapReaderNextValidRun(
+    struct GeoArrowGEOSBitmapReader* bitmap_reader, size_t* i, size_t length,
+    GEOSGeometry** out, size_t* n_out) {
+  if (bitmap_reader->bits == NULL) {
+    return length;
+  }
+
+  int64_t n_null = GeoArrowGEOSBitmapReaderSkip(bitmap_reader, 0, length - *i);
+  memset(out + *i, 0, n_null * sizeof(GEOSGeometry*));
+  *n_out += n_null;
+  *i += n_null;
+
+  return *i + GeoArrowGEOSBitmapReaderSkip(bitmap_reader, 1, length - *i);
+}
+
+// A GeoArrowVisitor that constructs GEOS geometries, which lets the reader use
+// GeoArrow's WKB and WKT readers directly on the Arrow buffers.
+#define GEOARROW_GEOS_MAX_NESTING 32
+
+struct GeoArrowGEOSGeometryBuilderLevel {
+  enum GeoArrowGeometryType geometry_type;
+  int has_z;
+  int has_m;
+  int64_t n_geoms;
+  int64_t geoms_capacity;
+  GEOSGeometry** geoms;
+};
+
+struct GeoArrowGEOSGeometryBuilder {
+  GEOSContextHandle_t handle;
+  int level;
+  struct GeoArrowGEOSGeometryBuilderLevel levels[GEOARROW_GEOS_MAX_NESTING];
+  int n_dims;
+  int64_t n_coords;
+  int64_t coords_capacity;
+  double* coords;
+  GEOSGeometry* feat;
+  struct GeoArrowGEOSPerf* perf;
+  struct GeoArrowGEOSAllocator* allocator;
+};
+
+static void GeoArrowGEOSGeometryBuilderResetFeat(
+    struct GeoArrowGEOSGeometryBuilder* builder) {
+  for (int i = 0; i < GEOARROW_GEOS_MAX_NESTING; i++) {
+    struct GeoArrowGEOSGeometryBuilderLevel* level = builder->levels + i;
+    for (int64_t j = 0; j < level->n_geoms; j++) {
+      GEOSGeom_destroy_r(builder->handle, level->geoms[j]);
+    }
+
+    level->n_geoms = 0;
+  }
+
+  if (builder->feat != NULL) {
+    GEOSGeom_destroy_r(builder->handle, builder->feat);
+    builder->feat = NULL;
+  }
+
+  builder->level = -1;
+  builder->n_coords = 0;
+}
+
+static void GeoArrowGEOSGeometryBuilderReset(
+    struct GeoArrowGEOSGeometryBuilder* builder) {
+  GeoArrowGEOSGeometryBuilderResetFeat(builder);
+
+  for (int i = 0; i < GEOARROW_GEOS_MAX_NESTING; i++) {
+    if (builder->levels[i].geoms != NULL) {
+      GeoArrowGEOSFree(builder->allocator, builder->levels[i].geoms,
+                       builder->levels[i].geoms_capacity * sizeof(GEOSGeometry*));
+      builder->levels[i].geoms = NULL;
+      builder->levels[i].geoms_capacity = 0;
+    }
+  }
+
+  if (builder->coords != NULL) {
+    GeoArrowGEOSFree(builder->allocator, builder->coords,
+                     builder->coords_capacity * sizeof(double));
+    builder->coords = NULL;
+    builder->coords_capacity = 0;
+  }
+}
+
+// Transfers ownership of geom to the builder, either as a child of the current
+// level or as the completed feature.
+static GeoArrowErrorCode GeoArrowGEOSGeometryBuilderPush(
+    struct GeoArrowGEOSGeometryBuilder* builder, GEOSGeometry* geom) {
+  if (builder->level < 0) {
+    builder->feat = geom;
+    builder->perf->counters.n_geos_objects++;
+    return GEOARROW_OK;
+  }
+
+  struct GeoArrowGEOSGeometryBuilderLevel* level = builder->levels + builder->level;
+  if (level->n_geoms == level->geoms_capacity) {
+    int64_t new_capacity = level->geoms_capacity * 2;
+    if (new_capacity < 8) {
+      new_capacity = 8;
+    }
+
+    builder->perf->counters.n_scratch_reallocs++;
+    GEOSGeometry** new_geoms = (GEOSGeometry**)GeoArrowGEOSRealloc(
+        builder->allocator, level->geoms, level->geoms_capacity * sizeof(GEOSGeometry*),
+        new_capacity * sizeof(GEOSGeometry*));
+    if (new_geoms == NULL) {
+      GEOSGeom_destroy_r(builder->handle, geom);
+      return ENOMEM;
+    }
+
+    level->geoms = new_geoms;
+    level->geoms_capacity = new_capacity;
+  }
+
+  level->geoms[level->n_geoms++] = geom;
+  builder->perf->counters.n_geos_objects++;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSGeometryBuilderMakeSeq(
+    struct GeoArrowGEOSGeometryBuilder* builder, struct GeoArrowError* error,
+    GEOSCoordSequence** out) {
+  struct GeoArrowGEOSGeometryBuilderLevel* level = builder->levels + builder->level;
+  *out = GEOSCoordSeq_copyFromBuffer_r(builder->handle, builder->coords,
+                                       (unsigned int)builder->n_coords, level->has_z,
+                                       level->has_m);
+  builder->perf->counters.n_coords += builder->n_coords;
+  builder->n_coords = 0;
+  if (*out == NULL) {
+    GeoArrowErrorSet(error, "GEOSCoordSeq_copyFromBuffer_r() failed");
+    return ENOMEM;
+  }
+
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSVisitorFeatStart(struct GeoArrowVisitor* v) {
+  GeoArrowGEOSGeometryBuilderResetFeat(
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data);
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSVisitorNullFeat(struct GeoArrowVisitor* v) { return GEOARROW_OK; }
+
+static int GeoArrowGEOSVisitorGeomStart(struct GeoArrowVisitor* v,
+                                        enum GeoArrowGeometryType geometry_type,
+                                        enum GeoArrowDimensions dimensions) {
+  struct GeoArrowGEOSGeometryBuilder* builder =
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data;
+  if ((builder->level + 1) >= GEOARROW_GEOS_MAX_NESTING) {
+    GeoArrowErrorSet(v->error, "Maximum nesting level (%d) exceeded",
+                     GEOARROW_GEOS_MAX_NESTING);
+    return EINVAL;
+  }
+
+  struct GeoArrowGEOSGeometryBuilderLevel* level = builder->levels + ++builder->level;
+  level->geometry_type = geometry_type;
+  level->n_geoms = 0;
+
+  switch (dimensions) {
+    case GEOARROW_DIMENSIONS_XYZ:
+      level->has_z = 1;
+      level->has_m = 0;
+      builder->n_dims = 3;
+      break;
+    case GEOARROW_DIMENSIONS_XYM:
+      level->has_z = 0;
+      level->has_m = 1;
+      builder->n_dims = 3;
+      break;
+    case GEOARROW_DIMENSIONS_XYZM:
+      level->has_z = 1;
+      level->has_m = 1;
+      builder->n_dims = 4;
+      break;
+    default:
+      level->has_z = 0;
+      level->has_m = 0;
+      builder->n_dims = 2;
+      break;
+  }
+
+  builder->n_coords = 0;
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSVisitorRingStart(struct GeoArrowVisitor* v) {
+  struct GeoArrowGEOSGeometryBuilder* builder =
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data;
+  builder->n_coords = 0;
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSVisitorCoords(struct GeoArrowVisitor* v,
+                                     const struct GeoArrowCoordView* coords) {
+  struct GeoArrowGEOSGeometryBuilder* builder =
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data;
+  int n_dims = builder->n_dims;
+  int64_t n_required = (builder->n_coords + coords->n_coords) * n_dims;
+  if (n_required > builder->coords_capacity) {
+    if ((builder->coords_capacity * 2) > n_required) {
+      n_required = builder->coords_capacity * 2;
+    }
+
+    builder->perf->counters.n_coords_reallocs++;
+    double* new_coords = (double*)GeoArrowGEOSRealloc(
+        builder->allocator, builder->coords, builder->coords_capacity * sizeof(double),
+        n_required * sizeof(double));
+    if (new_coords == NULL) {
+      GeoArrowErrorSet(v->error, "Failed to allocate coordinate buffer");
+      return ENOMEM;
+    }
+
+    builder->coords = new_coords;
+    builder->coords_capacity = n_required;
+  }
+
+  double* out = builder->coords + (builder->n_coords * n_dims);
+  int n_values = coords->n_values < n_dims ? coords->n_values : n_dims;
+  for (int64_t i = 0; i < coords->n_coords; i++) {
+    for (int j = 0; j < n_values; j++) {
+      out[j] = coords->values[j][i * coords->coords_stride];
+    }
+
+    for (int j = n_values; j < n_dims; j++) {
+      out[j] = NAN;
+    }
+
+    out += n_dims;
+  }
+
+  builder->n_coords += coords->n_coords;
+  return GEOARROW_OK;
+}
+
+static int GeoArrowGEOSVisitorRingEnd(struct GeoArrowVisitor* v) {
+  struct GeoArrowGEOSGeometryBuilder* builder =
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data;
+  GEOSCoordSequence* seq;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSGeometryBuilderMakeSeq(builder, v->error, &seq));
+
+  GEOSGeometry* ring = GEOSGeom_createLinearRing_r(builder->handle, seq);
+  if (ring == NULL) {
+    GEOSCoordSeq_destroy_r(builder->handle, seq);
+    GeoArrowErrorSet(v->error, "GEOSGeom_createLinearRing_r() failed");
+    return ENOMEM;
+  }
+
+  return GeoArrowGEOSGeometryBuilderPush(builder, ring);
+}
+
+static int GeoArrowGEOSVisitorGeomEnd(struct GeoArrowVisitor* v) {
+  struct GeoArrowGEOSGeometryBuilder* builder =
+      (struct GeoArrowGEOSGeometryBuilder*)v->private_data;
+  struct GeoArrowGEOSGeometryBuilderLevel* level = builder->levels + builder->level;
+  GEOSCoordSequence* seq = NULL;
+  GEOSGeometry* geom = NULL;
+
+  switch (level->geometry_type) {
+    case GEOARROW_GEOMETRY_TYPE_POINT: {
+      // Empty points are encoded in WKB as all-nan coordinates
+      int all_nan = builder->n_coords == 1;
+      for (int j = 0; all_nan && j < builder->n_dims; j++) {
+        all_nan = isnan(builder->coords[j]);
+      }
+
+      if (all_nan) {
+        builder->n_coords = 0;
+      }
+
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSGeometryBuilderMakeSeq(builder, v->error, &seq));
+      geom = GEOSGeom_createPoint_r(builder->handle, seq);
+      break;
+    }
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSGeometryBuilderMakeSeq(builder, v->error, &seq));
+      geom = GEOSGeom_createLineString_r(builder->handle, seq);
+      break;
+    case GEOARROW_GEOMETRY_TYPE_POLYGON:
+      if (level->n_geoms == 0) {
+        geom = GEOSGeom_createEmptyPolygon_r(builder->handle);
+      } else {
+        geom = GEOSGeom_createPolygon_r(builder->handle, level->geoms[0],
+                                        level->geoms + 1,
+                                        (unsigned int)(level->n_geoms - 1));
+        if (geom != NULL) {
+          level->n_geoms = 0;
+        }
+      }
+      break;
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+    case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+    case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION: {
+      // GEOS_MULTIPOINT...GEOS_GEOMETRYCOLLECTION are in the same order as
+      // the GeoArrow geometry types
+      int geos_type =
+          GEOS_MULTIPOINT + (level->geometry_type - GEOARROW_GEOMETRY_TYPE_MULTIPOINT);
+      if (level->n_geoms == 0) {
+        geom = GEOSGeom_createEmptyCollection_r(builder->handle, geos_type);
+      } else {
+        geom = GEOSGeom_createCollection_r(builder->handle, geos_type, level->geoms,
+                                           (unsigned int)level->n_geoms);
+        if (geom != NULL) {
+          level->n_geoms = 0;
+        }
+      }
+      break;
+    }
+    default:
+      GeoArrowErrorSet(v->error, "Unexpected geometry type: %d",
+                       (int)level->geometry_type);
+      return EINVAL;
+  }
+
+  if (geom == NULL) {
+    if (seq != NULL) {
+      GEOSCoordSeq_destroy_r(builder->handle, seq);
+    }
+
+    GeoArrowErrorSet(v->error, "Failed to create GEOS geometry of type %d",
+                     (int)level->geometry_type);
+    return ENOMEM;
+  }
+
+  builder->level--;
+  return GeoArrowGEOSGeometryBuilderPush(builder, geom);
+}
+
+static int GeoArrowGEOSVisitorFeatEnd(struct GeoArrowVisitor* v) { return GEOARROW_OK; }
+
+static void GeoArrowGEOSGeometryBuilderInitVisitor(
+    struct GeoArrowGEOSGeometryBuilder* builder, struct GeoArrowVisitor* v) {
+  GeoArrowVisitorInitVoid(v);
+  v->feat_start = &GeoArrowGEOSVisitorFeatStart;
+  v->null_feat = &GeoArrowGEOSVisitorNullFeat;
+  v->geom_start = &GeoArrowGEOSVisitorGeomStart;
+  v->ring_start = &GeoArrowGEOSVisitorRingStart;
+  v->coords = &GeoArrowGEOSVisitorCoords;
+  v->ring_end = &GeoArrowGEOSVisitorRingEnd;
+  v->geom_end = &GeoArrowGEOSVisitorGeomEnd;
+  v->feat_end = &GeoArrowGEOSVisitorFeatEnd;
+  v->private_data = builder;
+  builder->level = -1;
+}
+
+struct GeoArrowGEOSArrayReader {
+  GEOSContextHandle_t handle;
+  struct GeoArrowError error;
+  struct GeoArrowArrayView array_view;
+  // By default WKB and WKT are parsed using GeoArrow's readers, which visit
+  // coordinates directly from the Arrow buffers. GEOS' own readers are kept as
+  // an alternative (e.g., for comparison).
+  enum GeoArrowGEOSParser parser;
+  // Points are created straight from XY and XYZ coordinate values unless this
+  // is zero, in which case they are copied into a GEOSCoordSequence first
+  int direct_points;
+  struct GeoArrowWKBReader geoarrow_wkb_reader;
+  struct GeoArrowWKTReader geoarrow_wkt_reader;
+  struct GeoArrowGEOSGeometryBuilder geom_builder;
+  struct GeoArrowVisitor geom_visitor;
+  GEOSWKTReader* wkt_reader;
+  GEOSWKBReader* wkb_reader;
+  // In-progress items that we might need to clean up if an error was returned
+  int64_t n_geoms[2];
+  GEOSGeometry** geoms[2];
+  // GEOS' WKT reader needs null-terminated strings, but Arrow stores them in
+  // buffers without the null terminator. Thus, we need a bounce buffer to copy
+  // each WKT item into before passing to GEOS' reader.
+  size_t wkt_temp_size;
+  char* wkt_temp;
+  // geoarrow.geometry (dense union) and geoarrow.geometrycollection (list of
+  // dense union) arrays aren't supported by the GeoArrowArrayView, so we
+  // keep our own view of those and read each union member using a child
+  // reader. For these the array_view only holds the top-level validity and
+  // list offsets.
+  int64_t n_children;
+  struct GeoArrowGEOSArrayReader** children;
+  int8_t child_for_type_id[128];
+  const int8_t* union_type_ids;
+  const int32_t* union_offsets;
+  // Bitmask of offset levels that are 64-bit (large_binary, large_string, or
+  // large_list). The GeoArrowArrayView only knows about 32-bit offsets, so
+  // for these levels we keep the offsets pointer ourselves.
+  int large_levels;
+  const int64_t* large_offsets[3];
+  enum GeoArrowGEOSOnError on_error;
+  struct GeoArrowGEOSFeatureErrors errors;
+  // Child readers (and the geometry builder) update the counters of the
+  // top-level reader
+  struct GeoArrowGEOSPerf* perf;
+  struct GeoArrowGEOSPerf perf_data;
+  struct GeoArrowGEOSTracer* tracer;
+  int64_t feature_threshold;
+  // Used for geoms, wkt_temp, and the geometry builder's scratch space
+  struct GeoArrowGEOSAllocator* allocator;
+};
+
+static inline int64_t GeoArrowGEOSArrayReaderOffset(
+    const struct GeoArrowGEOSArrayReader* reader, int level, int64_t i) {
+  if (reader->large_offsets[level] != NULL) {
+    return reader->large_offsets[level][i];
+  } else {
+    return reader->array_view.offsets[level][i];
+  }
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderEnsureScratch(
+    struct GeoArrowGEOSArrayReader* reader, int64_t n_geoms, int level) {
+  if (n_geoms <= reader->n_geoms[level]) {
+    return GEOARROW_OK;
+  }
+
+  if ((reader->n_geoms[level] * 2) > n_geoms) {
+    n_geoms = reader->n_geoms[level] * 2;
+  }
+
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  GEOSGeometry** new_geoms = (GEOSGeometry**)GeoArrowGEOSRealloc(
+      reader->allocator, reader->geoms[level],
+      reader->n_geoms[level] * sizeof(GEOSGeometry*), n_geoms * sizeof(GEOSGeometry*));
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_alloc);
+  reader->perf->counters.n_scratch_reallocs++;
+  if (new_geoms == NULL) {
+    return ENOMEM;
+  }
+
+  reader->geoms[level] = new_geoms;
+  memset(reader->geoms[level], 0, n_geoms * sizeof(GEOSGeometry*));
+  reader->n_geoms[level] = n_geoms;
+  return GEOARROW_OK;
+}
+
+static void GeoArrowGEOSArrayReaderResetScratch(struct GeoArrowGEOSArrayReader* reader) {
+  for (int level = 0; level < 2; level++) {
+    for (int64_t i = 0; i < reader->n_geoms[level]; i++) {
+      if (reader->geoms[level][i] != NULL) {
+        GEOSGeom_destroy_r(reader->handle, reader->geoms[level][i]);
+        reader->geoms[level][i] = NULL;
+      }
+    }
+  }
+
+  for (int64_t i = 0; i < reader->n_children; i++) {
+    if (reader->children[i] != NULL) {
+      GeoArrowGEOSArrayReaderResetScratch(reader->children[i]);
+    }
+  }
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderEnsureWKTTemp(
+    struct GeoArrowGEOSArrayReader* reader, int64_t item_size) {
+  if (item_size <= reader->wkt_temp_size) {
+    return GEOARROW_OK;
+  }
+
+  if ((reader->wkt_temp_size * 2) > item_size) {
+    item_size = reader->wkt_temp_size * 2;
+  }
+
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  char* new_temp = (char*)GeoArrowGEOSRealloc(reader->allocator, reader->wkt_temp,
+                                              reader->wkt_temp_size, item_size);
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_alloc);
+  reader->perf->counters.n_scratch_reallocs++;
+  if (new_temp == NULL) {
+    return ENOMEM;
+  }
+
+  reader->wkt_temp = new_temp;
+  reader->wkt_temp_size = item_size;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitUnion(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowSchema* schema);
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitCollection(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowSchema* schema,
+    enum GeoArrowDimensions dimensions);
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitSchema(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowSchema* schema) {
+  struct GeoArrowStringView extension_name = GeoArrowGEOSSchemaExtensionName(schema);
+  if (GeoArrowGEOSStringViewEquals(extension_name, "geoarrow.geometry")) {
+    return GeoArrowGEOSArrayReaderInitUnion(reader, schema);
+  } else if (GeoArrowGEOSStringViewEquals(extension_name,
+                                          "geoarrow.geometrycollection")) {
+    return GeoArrowGEOSArrayReaderInitCollection(reader, schema,
+                                                 GEOARROW_DIMENSIONS_UNKNOWN);
+  }
+
+  enum GeoArrowType type;
+  if (GeoArrowGEOSLargeSchemaType(schema, &type, &reader->large_levels) == GEOARROW_OK) {
+    return GeoArrowArrayViewInitFromType(&reader->array_view, type);
+  }
+
+  return GeoArrowArrayViewInitFromSchema(&reader->array_view, schema, &reader->error);
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderCreateChild(
+    struct GeoArrowGEOSArrayReader* parent, struct ArrowSchema* schema, int type_id,
+    struct GeoArrowGEOSArrayReader** out) {
+  struct GeoArrowGEOSArrayReader* child =
+      (struct GeoArrowGEOSArrayReader*)malloc(sizeof(struct GeoArrowGEOSArrayReader));
+  if (child == NULL) {
+    GeoArrowErrorSet(&parent->error, "Failed to allocate child reader");
+    return ENOMEM;
+  }
+
+  memset(child, 0, sizeof(struct GeoArrowGEOSArrayReader));
+  *out = child;
+
+  child->handle = parent->handle;
+  child->parser = parent->parser;
+  child->direct_points = parent->direct_points;
+  child->allocator = parent->allocator;
+  child->geom_builder.handle = parent->handle;
+  child->geom_builder.allocator = parent->allocator;
+  GeoArrowGEOSGeometryBuilderInitVisitor(&child->geom_builder, &child->geom_visitor);
+  child->geom_visitor.error = &child->error;
+
+  // Union type ids are (dimensions - 1) * 10 + geometry type
+  enum GeoArrowGeometryType geometry_type = (enum GeoArrowGeometryType)(type_id % 10);
+  enum GeoArrowDimensions dimensions = (enum GeoArrowDimensions)(type_id / 10 + 1);
+  if (geometry_type == GEOARROW_GEOMETRY_TYPE_GEOMETRY ||
+      dimensions > GEOARROW_DIMENSIONS_XYZM) {
+    GeoArrowErrorSet(&parent->error, "Unexpected union type id: %d", type_id);
+    return EINVAL;
+  }
+
+  if (geometry_type == GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION) {
+    GeoArrowErrorCode result =
+        GeoArrowGEOSArrayReaderInitCollection(child, schema, dimensions);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&parent->error, "%s", child->error.message);
+    }
+
+    return result;
+  }
+
+  // Union members don't carry extension metadata, so we infer the type
+  // from the storage
+  enum GeoArrowType type;
+  GeoArrowErrorCode result = GeoArrowGEOSNativeSchemaType(
+      schema, geometry_type, dimensions, &type, &child->large_levels);
+  if (result == GEOARROW_OK) {
+    result = GeoArrowArrayViewInitFromType(&child->array_view, type);
+  }
+
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&parent->error, "Unsupported storage for union type id %d",
+                     type_id);
+  }
+
+  return result;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitUnion(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowSchema* schema) {
+  if (strncmp(schema->format, "+ud:", 4) != 0) {
+    GeoArrowErrorSet(&reader->error,
+                     "Expected dense union storage for geoarrow.geometry but got '%s'",
+                     schema->format);
+    return ENOTSUP;
+  }
+
+  memset(reader->child_for_type_id, -1, sizeof(reader->child_for_type_id));
+  reader->array_view.schema_view.type = GEOARROW_TYPE_UNINITIALIZED;
+  reader->array_view.schema_view.geometry_type = GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  reader->array_view.schema_view.dimensions = GEOARROW_DIMENSIONS_UNKNOWN;
+
+  reader->children = (struct GeoArrowGEOSArrayReader**)calloc(
+      schema->n_children, sizeof(struct GeoArrowGEOSArrayReader*));
+  if (reader->children == NULL && schema->n_children > 0) {
+    GeoArrowErrorSet(&reader->error, "Failed to allocate child readers");
+    return ENOMEM;
+  }
+
+  reader->n_children = schema->n_children;
+
+  const char* type_ids = schema->format + 4;
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    char* end;
+    long type_id = strtol(type_ids, &end, 10);
+    if (end == type_ids || type_id < 0 || type_id > 127) {
+      GeoArrowErrorSet(&reader->error, "Invalid union format string '%s'",
+                       schema->format);
+      return EINVAL;
+    }
+
+    reader->child_for_type_id[type_id] = (int8_t)i;
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderCreateChild(
+        reader, schema->children[i], (int)type_id, reader->children + i));
+    type_ids = *end == ',' ? end + 1 : end;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitCollection(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowSchema* schema,
+    enum GeoArrowDimensions dimensions) {
+  if (strcmp(schema->format, "+L") == 0) {
+    reader->large_levels = 1;
+  } else if (strcmp(schema->format, "+l") != 0 || schema->n_children != 1) {
+    GeoArrowErrorSet(
+        &reader->error,
+        "Expected list storage for geoarrow.geometrycollection but got '%s'",
+        schema->format);
+    return ENOTSUP;
+  }
+
+  reader->array_view.schema_view.type = GEOARROW_TYPE_UNINITIALIZED;
+  reader->array_view.schema_view.geometry_type =
+      GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+  reader->array_view.schema_view.dimensions = dimensions;
+  reader->array_view.n_offsets = 1;
+
+  reader->children = (struct GeoArrowGEOSArrayReader**)calloc(
+      1, sizeof(struct GeoArrowGEOSArrayReader*));
+  if (reader->children == NULL) {
+    GeoArrowErrorSet(&reader->error, "Failed to allocate child reader");
+    return ENOMEM;
+  }
+
+  reader->n_children = 1;
+
+  struct GeoArrowGEOSArrayReader* child =
+      (struct GeoArrowGEOSArrayReader*)malloc(sizeof(struct GeoArrowGEOSArrayReader));
+  if (child == NULL) {
+    GeoArrowErrorSet(&reader->error, "Failed to allocate child reader");
+    return ENOMEM;
+  }
+
+  memset(child, 0, sizeof(struct GeoArrowGEOSArrayReader));
+  reader->children[0] = child;
+  child->handle = reader->handle;
+  child->parser = reader->parser;
+  child->direct_points = reader->direct_points;
+  child->allocator = reader->allocator;
+  child->geom_builder.handle = reader->handle;
+  child->geom_builder.allocator = reader->allocator;
+  GeoArrowGEOSGeometryBuilderInitVisitor(&child->geom_builder, &child->geom_visitor);
+  child->geom_visitor.error = &child->error;
+
+  GeoArrowErrorCode result = GeoArrowGEOSArrayReaderInitUnion(child, schema->children[0]);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&reader->error, "%s", child->error.message);
+  }
+
+  return result;
+}
+
+// Populates the array view (or our own view for union-based arrays)
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderSetLargeArray(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array) {
+  struct GeoArrowArrayView* array_view = &reader->array_view;
+  array_view->validity_bitmap =
+      array->null_count == 0 ? NULL : (const uint8_t*)array->buffers[0];
+
+  switch (array_view->schema_view.type) {
+    case GEOARROW_TYPE_WKB:
+    case GEOARROW_TYPE_WKT:
+      array_view->offset[0] = array->offset;
+      array_view->length[0] = array->length;
+      reader->large_offsets[0] = (const int64_t*)array->buffers[1];
+      array_view->data = (const uint8_t*)array->buffers[2];
+      return GEOARROW_OK;
+    default:
+      break;
+  }
+
+  for (int32_t level = 0; level < array_view->n_offsets; level++) {
+    array_view->offset[level] = array->offset;
+    array_view->length[level] = array->length;
+    if (reader->large_levels & (1 << level)) {
+      reader->large_offsets[level] = (const int64_t*)array->buffers[1];
+      array_view->offsets[level] = NULL;
+    } else {
+      reader->large_offsets[level] = NULL;
+      array_view->offsets[level] = (const int32_t*)array->buffers[1];
+    }
+
+    if (array->n_children != 1) {
+      GeoArrowErrorSet(&reader->error, "Unexpected number of children for list array");
+      return EINVAL;
+    }
+
+    array = array->children[0];
+  }
+
+  array_view->offset[array_view->n_offsets] = array->offset;
+  array_view->length[array_view->n_offsets] = array->length;
+  array_view->coords.n_coords = array->length;
+
+  switch (array_view->schema_view.coord_type) {
+    case GEOARROW_COORD_TYPE_SEPARATE:
+      if (array->n_children != array_view->coords.n_values) {
+        GeoArrowErrorSet(&reader->error, "Unexpected number of children for coord array");
+        return EINVAL;
+      }
+
+      for (int64_t i = 0; i < array->n_children; i++) {
+        array_view->coords.values[i] =
+            (const double*)array->children[i]->buffers[1] + array->children[i]->offset;
+      }
+      break;
+    default:
+      if (array->n_children != 1) {
+        GeoArrowErrorSet(&reader->error, "Unexpected number of children for coord array");
+        return EINVAL;
+      }
+
+      for (int32_t i = 0; i < array_view->coords.n_values; i++) {
+        array_view->coords.values[i] = (const double*)array->children[0]->buffers[1] +
+                                       array->children[0]->offset + i;
+      }
+      break;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderSetArray(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array) {
+  if (reader->n_children == 0 && reader->large_levels != 0) {
+    return GeoArrowGEOSArrayReaderSetLargeArray(reader, array);
+  } else if (reader->n_children == 0) {
+    return GeoArrowArrayViewSetArray(&reader->array_view, array, &reader->error);
+  }
+
+  if (array->n_children != reader->n_children) {
+    GeoArrowErrorSet(&reader->error, "Expected array with %ld children but got %ld",
+                     (long)reader->n_children, (long)array->n_children);
+    return EINVAL;
+  }
+
+  reader->array_view.offset[0] = array->offset;
+  reader->array_view.length[0] = array->length;
+
+  if (reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_GEOMETRY) {
+    // Unions have no validity buffer (but did before Arrow 1.0)
+    int64_t first_buffer = array->n_buffers == 3 ? 1 : 0;
+    reader->array_view.validity_bitmap = NULL;
+    reader->union_type_ids = (const int8_t*)array->buffers[first_buffer];
+    reader->union_offsets = (const int32_t*)array->buffers[first_buffer + 1];
+  } else {
+    reader->array_view.validity_bitmap =
+        array->null_count == 0 ? NULL : (const uint8_t*)array->buffers[0];
+    if (reader->large_levels) {
+      reader->large_offsets[0] = (const int64_t*)array->buffers[1];
+    } else {
+      reader->array_view.offsets[0] = (const int32_t*)array->buffers[1];
+    }
+  }
+
+  for (int64_t i = 0; i < reader->n_children; i++) {
+    GeoArrowErrorCode result =
+        GeoArrowGEOSArrayReaderSetArray(reader->children[i], array->children[i]);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "%s", reader->children[i]->error.message);
+      return result;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+// Points the counters of reader and its children to perf
+static void GeoArrowGEOSArrayReaderSharePerf(struct GeoArrowGEOSArrayReader* reader,
+                                             struct GeoArrowGEOSPerf* perf) {
+  reader->perf = perf;
+  reader->geom_builder.perf = perf;
+  for (int64_t i = 0; i < reader->n_children; i++) {
+    if (reader->children[i] != NULL) {
+      GeoArrowGEOSArrayReaderSharePerf(reader->children[i], perf);
+    }
+  }
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderCreate(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSArrayReader** out) {
+  return GeoArrowGEOSArrayReaderCreateWithAllocator(handle, schema, NULL, out);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderCreateWithAllocator(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSAllocator* allocator, struct GeoArrowGEOSArrayReader** out) {
+  struct GeoArrowGEOSArrayReader* reader =
+      (struct GeoArrowGEOSArrayReader*)malloc(sizeof(struct GeoArrowGEOSArrayReader));
+  if (reader == NULL) {
+    *out = NULL;
+    return ENOMEM;
+  }
+
+  memset(reader, 0, sizeof(struct GeoArrowGEOSArrayReader));
+  *out = reader;
+
+  reader->handle = handle;
+  reader->allocator = allocator;
+  reader->direct_points = 1;
+  reader->geom_builder.handle = handle;
+  reader->geom_builder.allocator = allocator;
+  GeoArrowGEOSGeometryBuilderInitVisitor(&reader->geom_builder, &reader->geom_visitor);
+  reader->geom_visitor.error = &reader->error;
+  GeoArrowErrorCode result = GeoArrowGEOSArrayReaderInitSchema(reader, schema);
+  GeoArrowGEOSArrayReaderSharePerf(reader, &reader->perf_data);
+  return result;
+}
+
+const char* GeoArrowGEOSArrayReaderGetLastError(struct GeoArrowGEOSArrayReader* reader) {
+  return reader->error.message;
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetParser(
+    struct GeoArrowGEOSArrayReader* reader, enum GeoArrowGEOSParser parser) {
+  switch (parser) {
+    case GEOARROW_GEOS_PARSER_GEOARROW:
+    case GEOARROW_GEOS_PARSER_GEOS:
+      reader->parser = parser;
+      return GEOARROW_OK;
+    default:
+      GeoArrowErrorSet(&reader->error, "Unknown parser: %d", (int)parser);
+      return EINVAL;
+  }
+}
+
+void GeoArrowGEOSArrayReaderSetDirectPoints(struct GeoArrowGEOSArrayReader* reader,
+                                            int direct) {
+  reader->direct_points = direct != 0;
+  for (int64_t i = 0; i < reader->n_children; i++) {
+    if (reader->children[i] != NULL) {
+      GeoArrowGEOSArrayReaderSetDirectPoints(reader->children[i], direct);
+    }
+  }
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetOnError(
+    struct GeoArrowGEOSArrayReader* reader, enum GeoArrowGEOSOnError on_error) {
+  switch (on_error) {
+    case GEOARROW_GEOS_ON_ERROR_FAIL:
+    case GEOARROW_GEOS_ON_ERROR_NULL:
+      reader->on_error = on_error;
+      return GEOARROW_OK;
+    default:
+      GeoArrowErrorSet(&reader->error, "Unknown on error option: %d", (int)on_error);
+      return EINVAL;
+  }
+}
+
+int64_t GeoArrowGEOSArrayReaderGetFeatureErrors(struct GeoArrowGEOSArrayReader* reader,
+                                                const int64_t** indices,
+                                                const char* const** messages) {
+  return GeoArrowGEOSFeatureErrorsGet(&reader->errors, indices, messages);
+}
+
+// Visits one item using the GeoArrow WKB or WKT reader and moves the resulting
+// geometry to out.
+static GeoArrowErrorCode MakeGeomFromVisitor(struct GeoArrowGEOSArrayReader* reader,
+                                             const uint8_t* data, int64_t data_size,
+                                             size_t i, GEOSGeometry** out) {
+  GeoArrowErrorCode result;
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  if (reader->array_view.schema_view.type == GEOARROW_TYPE_WKB) {
+    struct GeoArrowBufferView src;
+    src.data = data;
+    src.size_bytes = data_size;
+    result =
+        GeoArrowWKBReaderVisit(&reader->geoarrow_wkb_reader, src, &reader->geom_visitor);
+  } else {
+    struct GeoArrowStringView src;
+    src.data = (const char*)data;
+    src.size_bytes = data_size;
+    result =
+        GeoArrowWKTReaderVisit(&reader->geoarrow_wkt_reader, src, &reader->geom_visitor);
+  }
+
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_parse);
+
+  if (result != GEOARROW_OK) {
+    char message[sizeof(reader->error.message)];
+    memcpy(message, reader->error.message, sizeof(message));
+    GeoArrowErrorSet(&reader->error, "[%ld] %s", (long)i, message);
+    GeoArrowGEOSGeometryBuilderResetFeat(&reader->geom_builder);
+    return result;
+  }
+
+  *out = reader->geom_builder.feat;
+  reader->geom_builder.feat = NULL;
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeGeomFromWKB(struct GeoArrowGEOSArrayReader* reader,
+                                         size_t offset, size_t length, GEOSGeometry** out,
+                                         size_t* n_out) {
+  offset += reader->array_view.offset[0];
+
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, reader->array_view.validity_bitmap, offset,
+                               length);
+
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t data_offset = GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i);
+      int64_t data_size =
+          GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i + 1) - data_offset;
+
+      if (reader->parser == GEOARROW_GEOS_PARSER_GEOARROW) {
+        GEOARROW_RETURN_NOT_OK(MakeGeomFromVisitor(
+            reader, reader->array_view.data + data_offset, data_size, i, out + i));
+        *n_out += 1;
+        continue;
+      }
+
+      int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+      out[i] = GEOSWKBReader_read_r(reader->handle, reader->wkb_reader,
+                                    reader->array_view.data + data_offset, data_size);
+      GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_parse);
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSWKBReader_read_r() failed", (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeGeomFromWKT(struct GeoArrowGEOSArrayReader* reader,
+                                         size_t offset, size_t length, GEOSGeometry** out,
+                                         size_t* n_out) {
+  offset += reader->array_view.offset[0];
+
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, reader->array_view.validity_bitmap, offset,
+                               length);
+
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t data_offset = GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i);
+      int64_t data_size =
+          GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i + 1) - data_offset;
+
+      if (reader->parser == GEOARROW_GEOS_PARSER_GEOARROW) {
+        GEOARROW_RETURN_NOT_OK(MakeGeomFromVisitor(
+            reader, reader->array_view.data + data_offset, data_size, i, out + i));
+        *n_out += 1;
+        continue;
+      }
+
+      // GEOSWKTReader_read_r() requires a null-terminated string. To ensure that, we
+      // copy into memory we own and add the null-terminator ourselves.
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderEnsureWKTTemp(reader, data_size + 1));
+      memcpy(reader->wkt_temp, reader->array_view.data + data_offset, data_size);
+      reader->wkt_temp[data_size] = '\0';
+
+      int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+      out[i] = GEOSWKTReader_read_r(reader->handle, reader->wkt_reader, reader->wkt_temp);
+      GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_parse);
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSWKTReader_read_r() failed", (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeCoordSeq(struct GeoArrowGEOSArrayReader* reader,
+                                      size_t offset, size_t length,
+                                      GEOSCoordSequence** out) {
+  offset += reader->array_view.offset[reader->array_view.n_offsets];
+  struct GeoArrowCoordView* coords = &reader->array_view.coords;
+  const double* z = NULL;
+  const double* m = NULL;
+
+  switch (reader->array_view.schema_view.dimensions) {
+    case GEOARROW_DIMENSIONS_XYZ:
+      z = coords->values[2];
+      break;
+    case GEOARROW_DIMENSIONS_XYM:
+      m = coords->values[2];
+      break;
+    case GEOARROW_DIMENSIONS_XYZM:
+      z = coords->values[2];
+      m = coords->values[3];
       break;
+    default:
+      break;
+  }
+
+  GEOSCoordSequence* seq;
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+
+  switch (reader->array_view.schema_view.coord_type) {
+    case GEOARROW_COORD_TYPE_SEPARATE:
+      seq = GEOSCoordSeq_copyFromArrays_r(reader->handle, coords->values[0] + offset,
+                                          coords->values[1] + offset,
+                                          z == NULL ? NULL : z + offset,
+                                          m == NULL ? NULL : m + offset, length);
+      break;
+    case GEOARROW_COORD_TYPE_INTERLEAVED:
+      seq = GEOSCoordSeq_copyFromBuffer_r(reader->handle,
+                                          coords->values[0] + (offset * coords->n_values),
+                                          length, z != NULL, m != NULL);
+      break;
+    default:
+      GeoArrowErrorSet(&reader->error, "Unsupported coord type");
+      return ENOTSUP;
+  }
+
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_coords);
+  reader->perf->counters.n_coords += length;
+  if (seq == NULL) {
+    GeoArrowErrorSet(&reader->error, "GEOSCoordSeq_copyFromArrays_r() failed");
+    return ENOMEM;
+  }
+
+  *out = seq;
+  return GEOARROW_OK;
+}
+
+static inline GEOSGeometry* MakePointXY(GEOSContextHandle_t handle, double x, double y) {
+  if (isnan(x) && isnan(y)) {
+    return GEOSGeom_createEmptyPoint_r(handle);
+  }
+
+#if GEOS_VERSION_MAJOR > 3 || (GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR >= 8)
+  return GEOSGeom_createPointFromXY_r(handle, x, y);
+#else
+  GEOSCoordSequence* seq = GEOSCoordSeq_create_r(handle, 1, 2);
+  if (seq == NULL) {
+    return NULL;
+  }
+
+  if (!GEOSCoordSeq_setXY_r(handle, seq, 0, x, y)) {
+    GEOSCoordSeq_destroy_r(handle, seq);
+    return NULL;
+  }
+
+  GEOSGeometry* point = GEOSGeom_createPoint_r(handle, seq);
+  if (point == NULL) {
+    GEOSCoordSeq_destroy_r(handle, seq);
+  }
+
+  return point;
+#endif
+}
+
+static inline GEOSGeometry* MakePointXYZ(GEOSContextHandle_t handle, double x, double y,
+                                         double z) {
+  int empty = isnan(x) && isnan(y) && isnan(z);
+  GEOSCoordSequence* seq = GEOSCoordSeq_create_r(handle, !empty, 3);
+  if (seq == NULL) {
+    return NULL;
+  }
+
+  if (!empty && !GEOSCoordSeq_setXYZ_r(handle, seq, 0, x, y, z)) {
+    GEOSCoordSeq_destroy_r(handle, seq);
+    return NULL;
+  }
+
+  GEOSGeometry* point = GEOSGeom_createPoint_r(handle, seq);
+  if (point == NULL) {
+    GEOSCoordSeq_destroy_r(handle, seq);
+  }
+
+  return point;
+}
+
+// Points are created directly from the coordinate values (i.e., without
+// copying into an intermediary GEOSCoordSequence first) except for
+// dimensions that include M (or if direct points were turned off), which use
+// the general coordinate sequence path.
+static GeoArrowErrorCode MakePoints(struct GeoArrowGEOSArrayReader* reader, size_t offset,
+                                    size_t length, GEOSGeometry** out, size_t* n_out) {
+  int top_level =
+      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_POINT;
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader,
+                               top_level ? reader->array_view.validity_bitmap : NULL,
+                               reader->array_view.offset[0] + offset, length);
+
+  struct GeoArrowCoordView* coords = &reader->array_view.coords;
+  int64_t stride = coords->coords_stride;
+  int64_t coord_offset =
+      (reader->array_view.offset[reader->array_view.n_offsets] + offset) * stride;
+  const double* x = coords->values[0] + coord_offset;
+  const double* y = coords->values[1] + coord_offset;
+  const double* z = NULL;
+  int direct = reader->direct_points;
+
+  switch (reader->array_view.schema_view.dimensions) {
+    case GEOARROW_DIMENSIONS_XY:
+      break;
+    case GEOARROW_DIMENSIONS_XYZ:
+      z = coords->values[2] + coord_offset;
+      break;
+    default:
+      direct = 0;
+      break;
+  }
+
+  if (!direct) {
+    GEOSCoordSequence* seq = NULL;
+    for (size_t i = 0; i < length;) {
+      size_t end =
+          GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+      for (; i < end; i++) {
+        GEOARROW_RETURN_NOT_OK(MakeCoordSeq(reader, offset + i, 1, &seq));
+        out[i] = GEOSGeom_createPoint_r(reader->handle, seq);
+        if (out[i] == NULL) {
+          GEOSCoordSeq_destroy_r(reader->handle, seq);
+          GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createPoint_r() failed",
+                           (long)i);
+          return ENOMEM;
+        }
+
+        reader->perf->counters.n_geos_objects++;
+        *n_out += 1;
+      }
+    }
+
+    return GEOARROW_OK;
+  }
+
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      if (z == NULL) {
+        out[i] = MakePointXY(reader->handle, x[i * stride], y[i * stride]);
+      } else {
+        out[i] =
+            MakePointXYZ(reader->handle, x[i * stride], y[i * stride], z[i * stride]);
+      }
+
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createPoint_r() failed",
+                         (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      reader->perf->counters.n_coords++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeLinestrings(struct GeoArrowGEOSArrayReader* reader,
+                                         size_t offset, size_t length, GEOSGeometry** out,
+                                         size_t* n_out) {
+  int level = reader->array_view.n_offsets - 1;
+  offset += reader->array_view.offset[level];
+
+  int top_level =
+      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_LINESTRING;
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader,
+                               top_level ? reader->array_view.validity_bitmap : NULL,
+                               offset, length);
+
+  GEOSCoordSequence* seq = NULL;
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t coord_offset = GeoArrowGEOSArrayReaderOffset(reader, level, offset + i);
+      int64_t n_coords =
+          GeoArrowGEOSArrayReaderOffset(reader, level, offset + i + 1) - coord_offset;
+      GEOARROW_RETURN_NOT_OK(MakeCoordSeq(reader, coord_offset, n_coords, &seq));
+      out[i] = GEOSGeom_createLineString_r(reader->handle, seq);
+      if (out[i] == NULL) {
+        GEOSCoordSeq_destroy_r(reader->handle, seq);
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createLineString_r() failed",
+                         (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeLinearrings(struct GeoArrowGEOSArrayReader* reader,
+                                         size_t offset, size_t length,
+                                         GEOSGeometry** out) {
+  int level = reader->array_view.n_offsets - 1;
+  offset += reader->array_view.offset[level];
+
+  GEOSCoordSequence* seq = NULL;
+  for (size_t i = 0; i < length; i++) {
+    int64_t coord_offset = GeoArrowGEOSArrayReaderOffset(reader, level, offset + i);
+    int64_t n_coords =
+        GeoArrowGEOSArrayReaderOffset(reader, level, offset + i + 1) - coord_offset;
+    GEOARROW_RETURN_NOT_OK(MakeCoordSeq(reader, coord_offset, n_coords, &seq));
+    out[i] = GEOSGeom_createLinearRing_r(reader->handle, seq);
+    if (out[i] == NULL) {
+      GEOSCoordSeq_destroy_r(reader->handle, seq);
+      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createLinearRing_r() failed",
+                       (long)i);
+      return ENOMEM;
+    }
+
+    reader->perf->counters.n_geos_objects++;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakePolygons(struct GeoArrowGEOSArrayReader* reader,
+                                      size_t offset, size_t length, GEOSGeometry** out,
+                                      size_t* n_out) {
+  int level = reader->array_view.n_offsets - 2;
+  offset += reader->array_view.offset[level];
+
+  int top_level =
+      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_POLYGON;
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader,
+                               top_level ? reader->array_view.validity_bitmap : NULL,
+                               offset, length);
+
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t ring_offset = GeoArrowGEOSArrayReaderOffset(reader, level, offset + i);
+      int64_t n_rings =
+          GeoArrowGEOSArrayReaderOffset(reader, level, offset + i + 1) - ring_offset;
+
+      if (n_rings == 0) {
+        out[i] = GEOSGeom_createEmptyPolygon_r(reader->handle);
+      } else {
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderEnsureScratch(reader, n_rings, 0));
+        GEOARROW_RETURN_NOT_OK(
+            MakeLinearrings(reader, ring_offset, n_rings, reader->geoms[0]));
+        out[i] = GEOSGeom_createPolygon_r(reader->handle, reader->geoms[0][0],
+                                          reader->geoms[0] + 1, n_rings - 1);
+        memset(reader->geoms[0], 0, n_rings * sizeof(GEOSGeometry*));
+      }
+
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createPolygon_r() failed",
+                         (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+typedef GeoArrowErrorCode (*GeoArrowGEOSPartMaker)(struct GeoArrowGEOSArrayReader* reader,
+                                                   size_t offset, size_t length,
+                                                   GEOSGeometry** out, size_t* n_out);
+
+static GeoArrowErrorCode MakeCollection(struct GeoArrowGEOSArrayReader* reader,
+                                        size_t offset, size_t length, GEOSGeometry** out,
+                                        int geom_level, int offset_level, int geos_type,
+                                        GeoArrowGEOSPartMaker part_maker, size_t* n_out) {
+  int level = reader->array_view.n_offsets - offset_level;
+  offset += reader->array_view.offset[level];
+
+  // Currently collections are always outer geometries
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, reader->array_view.validity_bitmap, offset,
+                               length);
+
+  size_t part_n_out = 0;
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t part_offset = GeoArrowGEOSArrayReaderOffset(reader, level, offset + i);
+      int64_t n_parts =
+          GeoArrowGEOSArrayReaderOffset(reader, level, offset + i + 1) - part_offset;
+
+      if (n_parts == 0) {
+        out[i] = GEOSGeom_createEmptyCollection_r(reader->handle, geos_type);
+      } else {
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowGEOSArrayReaderEnsureScratch(reader, n_parts, geom_level));
+        GEOARROW_RETURN_NOT_OK(part_maker(reader, part_offset, n_parts,
+                                          reader->geoms[geom_level], &part_n_out));
+        out[i] = GEOSGeom_createCollection_r(reader->handle, geos_type,
+                                             reader->geoms[geom_level], n_parts);
+        memset(reader->geoms[geom_level], 0, n_parts * sizeof(GEOSGeometry*));
+      }
+
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error,
+                         "[%ld] GEOSGeom_createEmptyCollection_r() failed", (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadRange(
+    struct GeoArrowGEOSArrayReader* reader, size_t offset, size_t length,
+    GEOSGeometry** out, size_t* n_out);
+
+static GeoArrowErrorCode MakeGeometries(struct GeoArrowGEOSArrayReader* reader,
+                                        size_t offset, size_t length, GEOSGeometry** out,
+                                        size_t* n_out) {
+  offset += reader->array_view.offset[0];
+  const int8_t* type_ids = reader->union_type_ids + offset;
+  const int32_t* child_offsets = reader->union_offsets + offset;
+
+  size_t i = 0;
+  while (i < length) {
+    int8_t type_id = type_ids[i];
+    int8_t child_i = type_id < 0 ? -1 : reader->child_for_type_id[type_id];
+    if (child_i < 0) {
+      GeoArrowErrorSet(&reader->error, "[%ld] Unexpected union type id: %d", (long)i,
+                       (int)type_id);
+      return EINVAL;
+    }
+
+    // Read runs of the same type that are contiguous in the child in one call
+    size_t run = 1;
+    while ((i + run) < length && type_ids[i + run] == type_id &&
+           child_offsets[i + run] == (child_offsets[i] + (int32_t)run)) {
+      run++;
+    }
+
+    struct GeoArrowGEOSArrayReader* child = reader->children[child_i];
+    GeoArrowErrorCode result =
+        GeoArrowGEOSArrayReaderReadRange(child, child_offsets[i], run, out + i, n_out);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "[%ld] %s", (long)i, child->error.message);
+      return result;
+    }
+
+    i += run;
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode MakeGeometryCollections(struct GeoArrowGEOSArrayReader* reader,
+                                                 size_t offset, size_t length,
+                                                 GEOSGeometry** out, size_t* n_out) {
+  offset += reader->array_view.offset[0];
+  struct GeoArrowGEOSArrayReader* child = reader->children[0];
+
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, reader->array_view.validity_bitmap, offset,
+                               length);
+
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    for (; i < end; i++) {
+      int64_t part_offset = GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i);
+      int64_t n_parts =
+          GeoArrowGEOSArrayReaderOffset(reader, 0, offset + i + 1) - part_offset;
+
+      if (n_parts == 0) {
+        out[i] =
+            GEOSGeom_createEmptyCollection_r(reader->handle, GEOS_GEOMETRYCOLLECTION);
+      } else {
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderEnsureScratch(reader, n_parts, 0));
+        size_t part_n_out = 0;
+        GeoArrowErrorCode result = GeoArrowGEOSArrayReaderReadRange(
+            child, part_offset, n_parts, reader->geoms[0], &part_n_out);
+        if (result != GEOARROW_OK) {
+          GeoArrowErrorSet(&reader->error, "[%ld] %s", (long)i, child->error.message);
+          return result;
+        }
+
+        for (int64_t j = 0; j < n_parts; j++) {
+          if (reader->geoms[0][j] == NULL) {
+            GeoArrowErrorSet(&reader->error, "[%ld] Unexpected null collection member",
+                             (long)i);
+            return EINVAL;
+          }
+        }
+
+        out[i] = GEOSGeom_createCollection_r(reader->handle, GEOS_GEOMETRYCOLLECTION,
+                                             reader->geoms[0], n_parts);
+        memset(reader->geoms[0], 0, n_parts * sizeof(GEOSGeometry*));
+      }
+
+      if (out[i] == NULL) {
+        GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createCollection_r() failed",
+                         (long)i);
+        return ENOMEM;
+      }
+
+      reader->perf->counters.n_geos_objects++;
+      *n_out += 1;
+    }
+  }
+
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadRange(
+    struct GeoArrowGEOSArrayReader* reader, size_t offset, size_t length,
+    GEOSGeometry** out, size_t* n_out) {
+  GeoArrowErrorCode result;
+  switch (reader->array_view.schema_view.type) {
+    case GEOARROW_TYPE_WKB:
+      if (reader->parser == GEOARROW_GEOS_PARSER_GEOARROW) {
+        if (reader->geoarrow_wkb_reader.private_data == NULL) {
+          GEOARROW_RETURN_NOT_OK(GeoArrowWKBReaderInit(&reader->geoarrow_wkb_reader));
+        }
+      } else if (reader->wkb_reader == NULL) {
+        reader->wkb_reader = GEOSWKBReader_create_r(reader->handle);
+        if (reader->wkb_reader == NULL) {
+          GeoArrowErrorSet(&reader->error, "GEOSWKBReader_create_r() failed");
+          return ENOMEM;
+        }
+      }
+
+      result = MakeGeomFromWKB(reader, offset, length, out, n_out);
+      break;
+    case GEOARROW_TYPE_WKT:
+      if (reader->parser == GEOARROW_GEOS_PARSER_GEOARROW) {
+        if (reader->geoarrow_wkt_reader.private_data == NULL) {
+          GEOARROW_RETURN_NOT_OK(GeoArrowWKTReaderInit(&reader->geoarrow_wkt_reader));
+        }
+      } else if (reader->wkt_reader == NULL) {
+        reader->wkt_reader = GEOSWKTReader_create_r(reader->handle);
+        if (reader->wkt_reader == NULL) {
+          GeoArrowErrorSet(&reader->error, "GEOSWKTReader_create_r() failed");
+          return ENOMEM;
+        }
+      }
+
+      result = MakeGeomFromWKT(reader, offset, length, out, n_out);
+      break;
+    default:
+      switch (reader->array_view.schema_view.geometry_type) {
+        case GEOARROW_GEOMETRY_TYPE_POINT:
+          result = MakePoints(reader, offset, length, out, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+          result = MakeLinestrings(reader, offset, length, out, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_POLYGON:
+          result = MakePolygons(reader, offset, length, out, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+          result = MakeCollection(reader, offset, length, out, 0, 1, GEOS_MULTIPOINT,
+                                  &MakePoints, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+          result = MakeCollection(reader, offset, length, out, 0, 2, GEOS_MULTILINESTRING,
+                                  &MakeLinestrings, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+          result = MakeCollection(reader, offset, length, out, 1, 3, GEOS_MULTIPOLYGON,
+                                  &MakePolygons, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION:
+          result = MakeGeometryCollections(reader, offset, length, out, n_out);
+          break;
+        case GEOARROW_GEOMETRY_TYPE_GEOMETRY:
+          if (reader->n_children > 0) {
+            result = MakeGeometries(reader, offset, length, out, n_out);
+            break;
+          }
+          // fall through
+        default:
+          GeoArrowErrorSet(&reader->error,
+                           "GeoArrowGEOSArrayReaderRead not implemented for array type");
+          return ENOTSUP;
+      }
+  }
+
+  return result;
+}
+
+// Returns a monotonic "work" position for the start of element i of the
+// top-level array. For native arrays this resolves the offset buffers down to
+// the coordinate index; for serialized arrays it is the byte offset into the
+// data buffer. The element index is added so that runs of null or empty
+// features are still spread between workers.
+static int64_t GeoArrowGEOSArrayReaderCost(struct GeoArrowGEOSArrayReader* reader,
+                                           int64_t i) {
+  struct GeoArrowArrayView* array_view = &reader->array_view;
+  int64_t index = array_view->offset[0] + i;
+
+  switch (array_view->schema_view.type) {
+    case GEOARROW_TYPE_WKB:
+    case GEOARROW_TYPE_WKT:
+      return GeoArrowGEOSArrayReaderOffset(reader, 0, index) + i;
+    default:
+      for (int32_t level = 0; level < array_view->n_offsets; level++) {
+        index = GeoArrowGEOSArrayReaderOffset(reader, level, index) +
+                array_view->offset[level + 1];
+      }
+
+      return index + i;
+  }
+}
+
+// Reads top-level features. Every Make*() function counts the features it
+// has processed in n_out, so on error the failing feature is out[*n_out]. In
+// GEOARROW_GEOS_ON_ERROR_NULL mode that feature is recorded (as out_index +
+// its position in out) and reading resumes after it. Clean input takes the
+// same single call to GeoArrowGEOSArrayReaderReadRange() in either mode.
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadFeaturesInternal(
+    struct GeoArrowGEOSArrayReader* reader, size_t offset, size_t length,
+    GEOSGeometry** out, int64_t out_index, size_t* n_out) {
+  size_t n_done = 0;
+  while (n_done < length) {
+    size_t n_range_out = 0;
+    GeoArrowErrorCode result = GeoArrowGEOSArrayReaderReadRange(
+        reader, offset + n_done, length - n_done, out + n_done, &n_range_out);
+    *n_out += n_range_out;
+    reader->perf->counters.n_features += n_range_out;
+    if (result == GEOARROW_OK) {
+      return GEOARROW_OK;
     }
 
-    case GEOS_MULTIPOINT:
-    case GEOS_MULTILINESTRING:
-    case GEOS_MULTIPOLYGON:
-    case GEOS_GEOMETRYCOLLECTION: {
-      int size = GEOSGetNumGeometries_r(builder->handle, geom);
-      for (int i = 0; i < size; i++) {
-        const GEOSGeometry* child = GEOSGetGeometryN_r(builder->handle, geom, i);
-        if (child == NULL) {
-          GeoArrowErrorSet(v->error, "GEOSGetGeometryN_r() failed");
-          return ENOMEM;
-        }
+    size_t i = n_done + n_range_out;
+    if (reader->on_error != GEOARROW_GEOS_ON_ERROR_NULL || result == ENOTSUP ||
+        i >= length) {
+      return result;
+    }
 
-        GEOARROW_RETURN_NOT_OK(VisitGeometry(builder, child, v));
+    if (GeoArrowGEOSFeatureErrorsAppend(&reader->errors, out_index + i,
+                                        reader->error.message) != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "Failed to record error for feature %ld",
+                       (long)(out_index + i));
+      return ENOMEM;
+    }
+
+    // Clean up any parts of the failed feature
+    GeoArrowGEOSArrayReaderResetScratch(reader);
+    out[i] = NULL;
+    *n_out += 1;
+    reader->perf->counters.n_features++;
+    n_done = i + 1;
+  }
+
+  return GEOARROW_OK;
+}
+
+// Returns the number of coordinates (native arrays) or bytes (WKB and WKT) of
+// element i of the top-level array, or 0 for union arrays.
+static inline int64_t GeoArrowGEOSArrayReaderFeatureSize(
+    struct GeoArrowGEOSArrayReader* reader, int64_t i) {
+  if (reader->n_children > 0) {
+    return 0;
+  }
+
+  return GeoArrowGEOSArrayReaderCost(reader, i + 1) -
+         GeoArrowGEOSArrayReaderCost(reader, i) - 1;
+}
+
+#if defined(GEOARROW_GEOS_ENABLE_TRACING)
+// With a feature threshold, features larger than the threshold are read one
+// at a time inside their own span and the runs between them are read as usual.
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadFeatures(
+    struct GeoArrowGEOSArrayReader* reader, size_t offset, size_t length,
+    GEOSGeometry** out, int64_t out_index, size_t* n_out) {
+  if (reader->tracer == NULL || reader->feature_threshold <= 0) {
+    return GeoArrowGEOSArrayReaderReadFeaturesInternal(reader, offset, length, out,
+                                                       out_index, n_out);
+  }
+
+  size_t i = 0;
+  while (i < length) {
+    size_t end = i;
+    int64_t size = 0;
+    while (end < length) {
+      size = GeoArrowGEOSArrayReaderFeatureSize(reader, offset + end);
+      if (size > reader->feature_threshold) {
+        break;
       }
+      end++;
+    }
 
-      break;
+    if (end > i) {
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderReadFeaturesInternal(
+          reader, offset + i, end - i, out + i, out_index + i, n_out));
     }
-    default:
-      GeoArrowErrorSet(v->error, "Unexpected GEOSGeomTypeId: %d", type_id);
-      return EINVAL;
+
+    if (end < length) {
+      GEOARROW_GEOS_TRACE_BEGIN(reader->tracer, "feature", offset + end, size);
+      GeoArrowErrorCode result = GeoArrowGEOSArrayReaderReadFeaturesInternal(
+          reader, offset + end, 1, out + end, out_index + end, n_out);
+      GEOARROW_GEOS_TRACE_END(reader->tracer, "feature", offset + end, size);
+      GEOARROW_RETURN_NOT_OK(result);
+      end++;
+    }
+
+    i = end;
   }
 
-  GEOARROW_RETURN_NOT_OK(v->geom_end(v));
   return GEOARROW_OK;
 }
+#else
+#define GeoArrowGEOSArrayReaderReadFeatures GeoArrowGEOSArrayReaderReadFeaturesInternal
+#endif
 
-GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppend(
-    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
-    size_t* n_appended) {
-  *n_appended = 0;
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadInternal(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, GEOSGeometry** out, size_t* n_out) {
+  GeoArrowGEOSArrayReaderResetScratch(reader);
+  GeoArrowGEOSFeatureErrorsClear(&reader->errors);
 
-  for (size_t i = 0; i < geom_size; i++) {
-    GEOARROW_RETURN_NOT_OK(builder->v.feat_start(&builder->v));
-    GEOARROW_RETURN_NOT_OK(VisitGeometry(builder, geom[i], &builder->v));
-    GEOARROW_RETURN_NOT_OK(builder->v.feat_end(&builder->v));
-    *n_appended = i + 1;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderSetArray(reader, array));
+
+  memset(out, 0, sizeof(GEOSGeometry*) * length);
+  *n_out = 0;
+
+  return GeoArrowGEOSArrayReaderReadFeatures(reader, offset, length, out, 0, n_out);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderRead(struct GeoArrowGEOSArrayReader* reader,
+                                                  struct ArrowArray* array, size_t offset,
+                                                  size_t length, GEOSGeometry** out,
+                                                  size_t* n_out) {
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(reader->tracer, "GeoArrowGEOSArrayReaderRead", offset,
+                            length);
+  GeoArrowErrorCode result =
+      GeoArrowGEOSArrayReaderReadInternal(reader, array, offset, length, out, n_out);
+  GEOARROW_GEOS_TRACE_END(reader->tracer, "GeoArrowGEOSArrayReaderRead", offset, length);
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_total);
+  return result;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderTakeInternal(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array,
+    const int64_t* indices, size_t n_indices, GEOSGeometry** out, size_t* n_out) {
+  GeoArrowGEOSArrayReaderResetScratch(reader);
+  GeoArrowGEOSFeatureErrorsClear(&reader->errors);
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderSetArray(reader, array));
+
+  memset(out, 0, sizeof(GEOSGeometry*) * n_indices);
+  *n_out = 0;
+
+  // Consecutive indices are read as a single range
+  for (size_t i = 0; i < n_indices;) {
+    if (indices[i] < 0 || indices[i] >= array->length) {
+      GeoArrowErrorSet(&reader->error, "[%ld] index %ld is out of range [0, %ld)",
+                       (long)i, (long)indices[i], (long)array->length);
+      return EINVAL;
+    }
+
+    size_t end = i + 1;
+    while (end < n_indices && indices[end] == (indices[end - 1] + 1) &&
+           indices[end] < array->length) {
+      end++;
+    }
+
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderReadFeatures(
+        reader, indices[i], end - i, out + i, i, n_out));
+
+    i = end;
   }
 
   return GEOARROW_OK;
 }
 
-// This should really be in nanoarrow and/or geoarrow
-struct GeoArrowGEOSBitmapReader {
-  const uint8_t* bits;
-  int64_t byte_i;
-  int bit_i;
-  uint8_t byte;
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderTake(struct GeoArrowGEOSArrayReader* reader,
+                                                  struct ArrowArray* array,
+                                                  const int64_t* indices,
+                                                  size_t n_indices, GEOSGeometry** out,
+                                                  size_t* n_out) {
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(reader->tracer, "GeoArrowGEOSArrayReaderTake", 0, n_indices);
+  GeoArrowErrorCode result =
+      GeoArrowGEOSArrayReaderTakeInternal(reader, array, indices, n_indices, out, n_out);
+  GEOARROW_GEOS_TRACE_END(reader->tracer, "GeoArrowGEOSArrayReaderTake", 0, n_indices);
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_total);
+  return result;
+}
+
+struct GeoArrowGEOSReadTask {
+  struct GeoArrowGEOSArrayReader reader;
+  size_t offset;
+  size_t length;
+  GEOSGeometry** out;
+  size_t n_out;
+  GeoArrowErrorCode result;
 };
 
-static inline void GeoArrowGEOSBitmapReaderInit(
-    struct GeoArrowGEOSBitmapReader* bitmap_reader, const uint8_t* bits, int64_t offset) {
-  memset(bitmap_reader, 0, sizeof(struct GeoArrowGEOSBitmapReader));
-  bitmap_reader->bits = bits;
+static void GeoArrowGEOSReadTaskRun(void* task_void) {
+  struct GeoArrowGEOSReadTask* task = (struct GeoArrowGEOSReadTask*)task_void;
+  task->result = GeoArrowGEOSArrayReaderReadFeatures(
+      &task->reader, task->offset, task->length, task->out, 0, &task->n_out);
+}
 
-  if (bits != NULL) {
-    bitmap_reader->byte_i = offset / 8;
-    bitmap_reader->bit_i = offset % 8;
-    if (bitmap_reader->bit_i == 0) {
-      bitmap_reader->bit_i = 7;
-      bitmap_reader->byte_i--;
-    } else {
-      bitmap_reader->bit_i--;
+static void GeoArrowGEOSArrayReaderResetInternal(struct GeoArrowGEOSArrayReader* reader);
+
+// Initializes a worker reader that shares the (already populated) array view
+// of the parent but uses its own GEOS context and owns its GEOS readers and
+// scratch space.
+// Geometries are created by the default GEOS geometry factory regardless of the
+// context, so they outlive the worker context and may be destroyed by the
+// caller using its own handle.
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderInitWorker(
+    struct GeoArrowGEOSArrayReader* worker, struct GeoArrowGEOSArrayReader* parent,
+    GEOSContextHandle_t handle) {
+  memset(worker, 0, sizeof(struct GeoArrowGEOSArrayReader));
+  worker->array_view = parent->array_view;
+  worker->parser = parent->parser;
+  worker->direct_points = parent->direct_points;
+  worker->on_error = parent->on_error;
+  worker->tracer = parent->tracer;
+  worker->feature_threshold = parent->feature_threshold;
+  worker->large_levels = parent->large_levels;
+  memcpy(worker->large_offsets, parent->large_offsets, sizeof(worker->large_offsets));
+  worker->handle = handle;
+  worker->allocator = parent->allocator;
+  worker->geom_builder.handle = handle;
+  worker->geom_builder.allocator = parent->allocator;
+  GeoArrowGEOSGeometryBuilderInitVisitor(&worker->geom_builder, &worker->geom_visitor);
+  worker->geom_visitor.error = &worker->error;
+
+  if (parent->n_children == 0) {
+    return GEOARROW_OK;
+  }
+
+  memcpy(worker->child_for_type_id, parent->child_for_type_id,
+         sizeof(worker->child_for_type_id));
+  worker->union_type_ids = parent->union_type_ids;
+  worker->union_offsets = parent->union_offsets;
+  worker->children = (struct GeoArrowGEOSArrayReader**)calloc(
+      parent->n_children, sizeof(struct GeoArrowGEOSArrayReader*));
+  if (worker->children == NULL) {
+    return ENOMEM;
+  }
+
+  worker->n_children = parent->n_children;
+  for (int64_t i = 0; i < parent->n_children; i++) {
+    worker->children[i] =
+        (struct GeoArrowGEOSArrayReader*)malloc(sizeof(struct GeoArrowGEOSArrayReader));
+    if (worker->children[i] == NULL) {
+      return ENOMEM;
     }
+
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderInitWorker(
+        worker->children[i], parent->children[i], handle));
   }
+
+  return GEOARROW_OK;
 }
 
-static inline int8_t GeoArrowGEOSBitmapReaderNextIsNull(
-    struct GeoArrowGEOSBitmapReader* bitmap_reader) {
-  if (bitmap_reader->bits == NULL) {
-    return 0;
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadParallelInternal(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, int n_threads, GEOSGeometry** out, size_t* n_out) {
+  if (n_threads > (int64_t)length) {
+    n_threads = (int)length;
+  }
+
+  // Reading on this thread has the same all-or-nothing result on error
+  if (n_threads <= 1) {
+    GeoArrowErrorCode result =
+        GeoArrowGEOSArrayReaderReadInternal(reader, array, offset, length, out, n_out);
+    if (result != GEOARROW_OK) {
+      for (size_t i = 0; i < *n_out; i++) {
+        if (out[i] != NULL) {
+          GEOSGeom_destroy_r(reader->handle, out[i]);
+        }
+      }
+
+      memset(out, 0, sizeof(GEOSGeometry*) * length);
+      *n_out = 0;
+    }
+
+    return result;
+  }
+
+  GeoArrowGEOSArrayReaderResetScratch(reader);
+  GeoArrowGEOSFeatureErrorsClear(&reader->errors);
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderSetArray(reader, array));
+
+  memset(out, 0, sizeof(GEOSGeometry*) * length);
+  *n_out = 0;
+
+  struct GeoArrowGEOSReadTask* tasks = (struct GeoArrowGEOSReadTask*)malloc(
+      n_threads * sizeof(struct GeoArrowGEOSReadTask));
+  if (tasks == NULL) {
+    GeoArrowErrorSet(&reader->error, "Failed to allocate %d read tasks", n_threads);
+    return ENOMEM;
+  }
+
+  // Split [offset, offset + length) such that each task has approximately the
+  // same number of coordinates (or bytes) to process
+  int64_t end = offset + length;
+  int64_t cost_start = GeoArrowGEOSArrayReaderCost(reader, offset);
+  int64_t cost_total = GeoArrowGEOSArrayReaderCost(reader, end) - cost_start;
+  int64_t task_start = offset;
+
+  GeoArrowErrorCode result = GEOARROW_OK;
+  int n_tasks = 0;
+  for (; n_tasks < n_threads; n_tasks++) {
+    struct GeoArrowGEOSReadTask* task = tasks + n_tasks;
+
+    int64_t task_end = end;
+    if (n_tasks < (n_threads - 1)) {
+      int64_t target = cost_start + (cost_total * (n_tasks + 1)) / n_threads;
+      int64_t lo = task_start;
+      int64_t hi = end;
+      while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (GeoArrowGEOSArrayReaderCost(reader, mid) < target) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+
+      task_end = lo;
+    }
+
+    GEOSContextHandle_t handle = GEOS_init_r();
+    if (handle == NULL) {
+      GeoArrowErrorSet(&reader->error, "GEOS_init_r() failed");
+      result = ENOMEM;
+      break;
+    }
+
+    result = GeoArrowGEOSArrayReaderInitWorker(&task->reader, reader, handle);
+    GeoArrowGEOSArrayReaderSharePerf(&task->reader, &task->reader.perf_data);
+    task->reader.perf_data.collect_timings = reader->perf->collect_timings;
+    task->offset = task_start;
+    task->length = task_end - task_start;
+    task->out = out + (task_start - offset);
+    task->n_out = 0;
+    task->result = GEOARROW_OK;
+    task_start = task_end;
+
+    if (result != GEOARROW_OK) {
+      // Still count this task so that its partially initialized reader and
+      // GEOS context are cleaned up below
+      GeoArrowErrorSet(&reader->error, "Failed to initialize read task");
+      n_tasks++;
+      break;
+    }
+  }
+
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSRunTasks(&GeoArrowGEOSReadTaskRun, tasks,
+                                  sizeof(struct GeoArrowGEOSReadTask), n_tasks);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "Failed to start read tasks");
+    }
+  }
+
+  for (int i = 0; i < n_tasks && result == GEOARROW_OK; i++) {
+    if (tasks[i].result != GEOARROW_OK) {
+      result = tasks[i].result;
+      GeoArrowErrorSet(&reader->error, "[offset %ld] %s", (long)tasks[i].offset,
+                       tasks[i].reader.error.message);
+    }
   }
 
-  if (++bitmap_reader->bit_i == 8) {
-    bitmap_reader->byte = bitmap_reader->bits[++bitmap_reader->byte_i];
-    bitmap_reader->bit_i = 0;
+  // Collect per-feature errors in order, relative to the start of out
+  for (int i = 0; i < n_tasks && result == GEOARROW_OK; i++) {
+    struct GeoArrowGEOSFeatureErrors* errors = &tasks[i].reader.errors;
+    for (int64_t j = 0; j < errors->size && result == GEOARROW_OK; j++) {
+      result = GeoArrowGEOSFeatureErrorsAppend(
+          &reader->errors, (tasks[i].offset - offset) + errors->indices[j],
+          errors->messages[j]);
+      if (result != GEOARROW_OK) {
+        GeoArrowErrorSet(&reader->error, "Failed to collect feature errors");
+      }
+    }
+  }
+
+  // On success all output is owned by the caller; on error nothing is, since
+  // the completed chunks are not necessarily contiguous.
+  for (int i = 0; i < n_tasks; i++) {
+    if (result != GEOARROW_OK) {
+      for (size_t j = 0; j < tasks[i].length; j++) {
+        if (tasks[i].out[j] != NULL) {
+          GEOSGeom_destroy_r(tasks[i].reader.handle, tasks[i].out[j]);
+          tasks[i].out[j] = NULL;
+        }
+      }
+    } else {
+      *n_out += tasks[i].n_out;
+    }
+
+    GeoArrowGEOSCountersAdd(&reader->perf->counters, &tasks[i].reader.perf_data.counters);
+    GeoArrowGEOSArrayReaderResetInternal(&tasks[i].reader);
+    GEOS_finish_r(tasks[i].reader.handle);
   }
 
-  return (bitmap_reader->byte & (1 << bitmap_reader->bit_i)) == 0;
+  free(tasks);
+  return result;
 }
 
-struct GeoArrowGEOSArrayReader {
-  GEOSContextHandle_t handle;
-  struct GeoArrowError error;
-  struct GeoArrowArrayView array_view;
-  // In order to use GeoArrow's read capability we need to write a visitor-based
-  // constructor for GEOS geometries, which is complicated and may or may not be
-  // faster than GEOS' own readers.
-  GEOSWKTReader* wkt_reader;
-  GEOSWKBReader* wkb_reader;
-  // In-progress items that we might need to clean up if an error was returned
-  int64_t n_geoms[2];
-  GEOSGeometry** geoms[2];
-  struct GeoArrowGEOSBitmapReader bitmap_reader;
-  // GEOS' WKT reader needs null-terminated strings, but Arrow stores them in
-  // buffers without the null terminator. Thus, we need a bounce buffer to copy
-  // each WKT item into before passing to GEOS' reader.
-  size_t wkt_temp_size;
-  char* wkt_temp;
-};
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderReadParallel(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, int n_threads, GEOSGeometry** out, size_t* n_out) {
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(reader->tracer, "GeoArrowGEOSArrayReaderReadParallel", offset,
+                            length);
+  GeoArrowErrorCode result = GeoArrowGEOSArrayReaderReadParallelInternal(
+      reader, array, offset, length, n_threads, out, n_out);
+  GEOARROW_GEOS_TRACE_END(reader->tracer, "GeoArrowGEOSArrayReaderReadParallel", offset,
+                          length);
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_total);
+  return result;
+}
 
-static GeoArrowErrorCode GeoArrowGEOSArrayReaderEnsureScratch(
-    struct GeoArrowGEOSArrayReader* reader, int64_t n_geoms, int level) {
-  if (n_geoms <= reader->n_geoms[level]) {
-    return GEOARROW_OK;
+// Computes the xmin, ymin, xmax, ymax of element i of the top-level array of a
+// native reader directly from the coordinate buffers. Empty features (and
+// empty points, whose coordinates are nan) get bounds that intersect nothing.
+static void GeoArrowGEOSArrayReaderNativeBounds(struct GeoArrowGEOSArrayReader* reader,
+                                                int64_t i, double* bounds) {
+  struct GeoArrowArrayView* array_view = &reader->array_view;
+  int64_t start = array_view->offset[0] + i;
+  int64_t end = start + 1;
+  for (int32_t level = 0; level < array_view->n_offsets; level++) {
+    start = GeoArrowGEOSArrayReaderOffset(reader, level, start) +
+            array_view->offset[level + 1];
+    end = GeoArrowGEOSArrayReaderOffset(reader, level, end) +
+          array_view->offset[level + 1];
   }
 
-  if ((reader->n_geoms[level] * 2) > n_geoms) {
-    n_geoms = reader->n_geoms[level] * 2;
+  int64_t stride = array_view->coords.coords_stride;
+  const double* x = array_view->coords.values[0];
+  const double* y = array_view->coords.values[1];
+
+  bounds[0] = INFINITY;
+  bounds[1] = INFINITY;
+  bounds[2] = -INFINITY;
+  bounds[3] = -INFINITY;
+  for (int64_t j = start * stride; j < (end * stride); j += stride) {
+    bounds[0] = x[j] < bounds[0] ? x[j] : bounds[0];
+    bounds[1] = y[j] < bounds[1] ? y[j] : bounds[1];
+    bounds[2] = x[j] > bounds[2] ? x[j] : bounds[2];
+    bounds[3] = y[j] > bounds[3] ? y[j] : bounds[3];
   }
+}
 
-  reader->geoms[level] =
-      (GEOSGeometry**)realloc(reader->geoms[level], n_geoms * sizeof(GEOSGeometry*));
-  if (reader->geoms[level] == NULL) {
-    reader->n_geoms[level] = 0;
-    return ENOMEM;
+static inline int GeoArrowGEOSBoundsIntersect(const double* bounds, const double* bbox) {
+  return bounds[0] <= bbox[2] && bounds[2] >= bbox[0] && bounds[1] <= bbox[3] &&
+         bounds[3] >= bbox[1];
+}
+
+// Used for serialized, union, and geometry collection arrays, where the bounds
+// are only known after the geometry has been created
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderFilterBbox(
+    struct GeoArrowGEOSArrayReader* reader, size_t length, const double* bbox,
+    GEOSGeometry** out, uint8_t* selection) {
+#if GEOS_VERSION_MAJOR > 3 || (GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR >= 7)
+  double bounds[4];
+  for (size_t i = 0; i < length; i++) {
+    if (out[i] == NULL) {
+      continue;
+    }
+
+    int intersects = GEOSisEmpty_r(reader->handle, out[i]) == 0 &&
+                     GEOSGeom_getXMin_r(reader->handle, out[i], bounds + 0) &&
+                     GEOSGeom_getYMin_r(reader->handle, out[i], bounds + 1) &&
+                     GEOSGeom_getXMax_r(reader->handle, out[i], bounds + 2) &&
+                     GEOSGeom_getYMax_r(reader->handle, out[i], bounds + 3) &&
+                     GeoArrowGEOSBoundsIntersect(bounds, bbox);
+    if (intersects) {
+      selection[i / 8] |= (uint8_t)(1 << (i % 8));
+    } else {
+      GEOSGeom_destroy_r(reader->handle, out[i]);
+      out[i] = NULL;
+    }
   }
 
-  memset(reader->geoms[level], 0, n_geoms * sizeof(GEOSGeometry*));
   return GEOARROW_OK;
+#else
+  GeoArrowErrorSet(&reader->error,
+                   "GeoArrowGEOSArrayReaderReadBbox() requires GEOS >= 3.7 for "
+                   "serialized and mixed-type arrays");
+  return ENOTSUP;
+#endif
 }
 
-static void GeoArrowGEOSArrayReaderResetScratch(struct GeoArrowGEOSArrayReader* reader) {
-  for (int level = 0; level < 2; level++) {
-    for (int64_t i = 0; i < reader->n_geoms[level]; i++) {
-      if (reader->geoms[level][i] != NULL) {
-        GEOSGeom_destroy_r(reader->handle, reader->geoms[level][i]);
-        reader->geoms[level][i] = NULL;
+static GeoArrowErrorCode GeoArrowGEOSArrayReaderReadBboxInternal(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, const double* bbox, GEOSGeometry** out, uint8_t* selection,
+    size_t* n_out) {
+  GeoArrowGEOSArrayReaderResetScratch(reader);
+  GeoArrowGEOSFeatureErrorsClear(&reader->errors);
+
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderSetArray(reader, array));
+
+  memset(out, 0, sizeof(GEOSGeometry*) * length);
+  memset(selection, 0, (length + 7) / 8);
+  *n_out = 0;
+
+  struct GeoArrowArrayView* array_view = &reader->array_view;
+  int native = array_view->schema_view.type != GEOARROW_TYPE_WKB &&
+               array_view->schema_view.type != GEOARROW_TYPE_WKT &&
+               reader->n_children == 0;
+
+  if (!native) {
+    GEOARROW_RETURN_NOT_OK(
+        GeoArrowGEOSArrayReaderReadFeatures(reader, offset, length, out, 0, n_out));
+    return GeoArrowGEOSArrayReaderFilterBbox(reader, length, bbox, out, selection);
+  }
+
+  // Select non-null features whose bounds intersect bbox...
+  struct GeoArrowGEOSBitmapReader bitmap_reader;
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, array_view->validity_bitmap,
+                               array_view->offset[0] + offset, length);
+  size_t n_null = 0;
+  double bounds[4];
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, &n_null);
+    for (; i < end; i++) {
+      GeoArrowGEOSArrayReaderNativeBounds(reader, offset + i, bounds);
+      if (GeoArrowGEOSBoundsIntersect(bounds, bbox)) {
+        selection[i / 8] |= (uint8_t)(1 << (i % 8));
       }
     }
   }
+
+  // ...and only create geometries for runs of selected features
+  GeoArrowGEOSBitmapReaderInit(&bitmap_reader, selection, 0, length);
+  for (size_t i = 0; i < length;) {
+    size_t end =
+        GeoArrowGEOSBitmapReaderNextValidRun(&bitmap_reader, &i, length, out, n_out);
+    if (i == end) {
+      continue;
+    }
+
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderReadFeatures(
+        reader, offset + i, end - i, out + i, i, n_out));
+    i = end;
+  }
+
+  return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode GeoArrowGEOSArrayReaderEnsureWKTTemp(
-    struct GeoArrowGEOSArrayReader* reader, int64_t item_size) {
-  if (item_size <= reader->wkt_temp_size) {
-    return GEOARROW_OK;
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderReadBbox(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, const double* bbox, GEOSGeometry** out, uint8_t* selection,
+    size_t* n_out) {
+  int64_t start = GeoArrowGEOSPerfStart(reader->perf);
+  GEOARROW_GEOS_TRACE_BEGIN(reader->tracer, "GeoArrowGEOSArrayReaderReadBbox", offset,
+                            length);
+  GeoArrowErrorCode result = GeoArrowGEOSArrayReaderReadBboxInternal(
+      reader, array, offset, length, bbox, out, selection, n_out);
+  GEOARROW_GEOS_TRACE_END(reader->tracer, "GeoArrowGEOSArrayReaderReadBbox", offset,
+                          length);
+  GeoArrowGEOSPerfStop(reader->perf, start, &reader->perf->counters.ns_total);
+  return result;
+}
+
+static void GeoArrowGEOSArrayReaderResetInternal(struct GeoArrowGEOSArrayReader* reader) {
+  if (reader->geoarrow_wkb_reader.private_data != NULL) {
+    GeoArrowWKBReaderReset(&reader->geoarrow_wkb_reader);
   }
 
-  if ((reader->wkt_temp_size * 2) > item_size) {
-    item_size = reader->wkt_temp_size * 2;
+  if (reader->geoarrow_wkt_reader.private_data != NULL) {
+    GeoArrowWKTReaderReset(&reader->geoarrow_wkt_reader);
   }
 
-  reader->wkt_temp = (char*)realloc(reader->wkt_temp, item_size);
-  if (reader->wkt_temp == NULL) {
-    reader->wkt_temp_size = 0;
-    return ENOMEM;
+  GeoArrowGEOSGeometryBuilderReset(&reader->geom_builder);
+
+  if (reader->wkt_reader != NULL) {
+    GEOSWKTReader_destroy_r(reader->handle, reader->wkt_reader);
+  }
+
+  if (reader->wkb_reader != NULL) {
+    GEOSWKBReader_destroy_r(reader->handle, reader->wkb_reader);
+  }
+
+  GeoArrowGEOSArrayReaderResetScratch(reader);
+
+  for (int i = 0; i < 2; i++) {
+    GeoArrowGEOSFree(reader->allocator, reader->geoms[i],
+                     reader->n_geoms[i] * sizeof(GEOSGeometry*));
+  }
+
+  GeoArrowGEOSFree(reader->allocator, reader->wkt_temp, reader->wkt_temp_size);
+
+  if (reader->children != NULL) {
+    for (int64_t i = 0; i < reader->n_children; i++) {
+      if (reader->children[i] != NULL) {
+        GeoArrowGEOSArrayReaderDestroy(reader->children[i]);
+      }
+    }
+
+    free(reader->children);
+  }
+
+  GeoArrowGEOSFeatureErrorsReset(&reader->errors);
+}
+
+void GeoArrowGEOSArrayReaderSetCollectTimings(struct GeoArrowGEOSArrayReader* reader,
+                                              int collect) {
+  reader->perf->collect_timings = collect;
+}
+
+void GeoArrowGEOSArrayReaderGetCounters(struct GeoArrowGEOSArrayReader* reader,
+                                        struct GeoArrowGEOSCounters* out) {
+  memcpy(out, &reader->perf->counters, sizeof(struct GeoArrowGEOSCounters));
+}
+
+void GeoArrowGEOSArrayReaderResetCounters(struct GeoArrowGEOSArrayReader* reader) {
+  memset(&reader->perf->counters, 0, sizeof(struct GeoArrowGEOSCounters));
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetTracer(
+    struct GeoArrowGEOSArrayReader* reader, struct GeoArrowGEOSTracer* tracer,
+    int64_t feature_threshold) {
+#if !defined(GEOARROW_GEOS_ENABLE_TRACING)
+  if (tracer != NULL) {
+    GeoArrowErrorSet(&reader->error,
+                     "geoarrow-c-geos was built without GEOARROW_GEOS_ENABLE_TRACING");
+    return ENOTSUP;
   }
+#endif
 
+  reader->tracer = tracer;
+  reader->feature_threshold = feature_threshold;
   return GEOARROW_OK;
 }
 
-GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderCreate(
-    GEOSContextHandle_t handle, struct ArrowSchema* schema,
-    struct GeoArrowGEOSArrayReader** out) {
-  struct GeoArrowGEOSArrayReader* reader =
-      (struct GeoArrowGEOSArrayReader*)malloc(sizeof(struct GeoArrowGEOSArrayReader));
+void GeoArrowGEOSArrayReaderDestroy(struct GeoArrowGEOSArrayReader* reader) {
+  GeoArrowGEOSArrayReaderResetInternal(reader);
+  free(reader);
+}
+
+struct GeoArrowGEOSStreamReader {
+  struct ArrowArrayStream stream;
+  struct GeoArrowGEOSArrayReader* reader;
+  struct ArrowArray chunk;
+  size_t chunk_offset;
+  int finished;
+  struct GeoArrowError error;
+};
+
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderCreate(
+    GEOSContextHandle_t handle, struct ArrowArrayStream* stream,
+    struct GeoArrowGEOSStreamReader** out) {
+  struct GeoArrowGEOSStreamReader* reader =
+      (struct GeoArrowGEOSStreamReader*)malloc(sizeof(struct GeoArrowGEOSStreamReader));
   if (reader == NULL) {
     *out = NULL;
     return ENOMEM;
   }
 
-  memset(reader, 0, sizeof(struct GeoArrowGEOSArrayReader));
+  memset(reader, 0, sizeof(struct GeoArrowGEOSStreamReader));
   *out = reader;
 
-  reader->handle = handle;
-  GEOARROW_RETURN_NOT_OK(
-      GeoArrowArrayViewInitFromSchema(&reader->array_view, schema, &reader->error));
+  memcpy(&reader->stream, stream, sizeof(struct ArrowArrayStream));
+  stream->release = NULL;
 
-  return GEOARROW_OK;
+  struct ArrowSchema schema;
+  int result = reader->stream.get_schema(&reader->stream, &schema);
+  if (result != GEOARROW_OK) {
+    const char* message = reader->stream.get_last_error(&reader->stream);
+    GeoArrowErrorSet(&reader->error, "get_schema() failed: %s",
+                     message == NULL ? "" : message);
+    return result;
+  }
+
+  result = GeoArrowGEOSArrayReaderCreate(handle, &schema, &reader->reader);
+  schema.release(&schema);
+  if (result != GEOARROW_OK && reader->reader != NULL) {
+    GeoArrowErrorSet(&reader->error, "%s", reader->reader->error.message);
+  }
+
+  return result;
 }
 
-const char* GeoArrowGEOSArrayReaderGetLastError(struct GeoArrowGEOSArrayReader* reader) {
+const char* GeoArrowGEOSStreamReaderGetLastError(
+    struct GeoArrowGEOSStreamReader* reader) {
   return reader->error.message;
 }
 
-static GeoArrowErrorCode MakeGeomFromWKB(struct GeoArrowGEOSArrayReader* reader,
-                                         size_t offset, size_t length, GEOSGeometry** out,
-                                         size_t* n_out) {
-  offset += reader->array_view.offset[0];
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderSetParser(
+    struct GeoArrowGEOSStreamReader* reader, enum GeoArrowGEOSParser parser) {
+  int result = GeoArrowGEOSArrayReaderSetParser(reader->reader, parser);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&reader->error, "%s", reader->reader->error.message);
+  }
 
-  GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader, reader->array_view.validity_bitmap,
-                               offset);
+  return result;
+}
 
-  for (size_t i = 0; i < length; i++) {
-    if (GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderSetOnError(
+    struct GeoArrowGEOSStreamReader* reader, enum GeoArrowGEOSOnError on_error) {
+  int result = GeoArrowGEOSArrayReaderSetOnError(reader->reader, on_error);
+  if (result != GEOARROW_OK) {
+    GeoArrowErrorSet(&reader->error, "%s", reader->reader->error.message);
+  }
+
+  return result;
+}
+
+int64_t GeoArrowGEOSStreamReaderGetFeatureErrors(struct GeoArrowGEOSStreamReader* reader,
+                                                 const int64_t** indices,
+                                                 const char* const** messages) {
+  return GeoArrowGEOSArrayReaderGetFeatureErrors(reader->reader, indices, messages);
+}
+
+// Makes sure reader->chunk has at least one unread feature, pulling (and
+// skipping empty) chunks from the stream as needed. Sets reader->finished at
+// the end of the stream.
+static GeoArrowErrorCode GeoArrowGEOSStreamReaderEnsureChunk(
+    struct GeoArrowGEOSStreamReader* reader) {
+  while (reader->chunk.release == NULL ||
+         reader->chunk_offset >= (size_t)reader->chunk.length) {
+    if (reader->chunk.release != NULL) {
+      reader->chunk.release(&reader->chunk);
     }
 
-    int64_t data_offset = reader->array_view.offsets[0][i];
-    int64_t data_size = reader->array_view.offsets[0][i + 1] - data_offset;
+    if (reader->finished) {
+      return GEOARROW_OK;
+    }
 
-    out[i] = GEOSWKBReader_read_r(reader->handle, reader->wkb_reader,
-                                  reader->array_view.data + data_offset, data_size);
-    if (out[i] == NULL) {
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSWKBReader_read_r() failed", (long)i);
-      return ENOMEM;
+    int result = reader->stream.get_next(&reader->stream, &reader->chunk);
+    if (result != GEOARROW_OK) {
+      const char* message = reader->stream.get_last_error(&reader->stream);
+      GeoArrowErrorSet(&reader->error, "get_next() failed: %s",
+                       message == NULL ? "" : message);
+      reader->chunk.release = NULL;
+      return result;
     }
 
-    *n_out += 1;
+    if (reader->chunk.release == NULL) {
+      reader->finished = 1;
+      return GEOARROW_OK;
+    }
+
+    reader->chunk_offset = 0;
+    result = GeoArrowGEOSArrayReaderSetArray(reader->reader, &reader->chunk);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "%s", reader->reader->error.message);
+      reader->chunk.release(&reader->chunk);
+      return result;
+    }
   }
 
   return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode MakeGeomFromWKT(struct GeoArrowGEOSArrayReader* reader,
-                                         size_t offset, size_t length, GEOSGeometry** out,
-                                         size_t* n_out) {
-  offset += reader->array_view.offset[0];
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderRead(
+    struct GeoArrowGEOSStreamReader* reader, GEOSGeometry** out, size_t max_out,
+    size_t* n_out) {
+  memset(out, 0, sizeof(GEOSGeometry*) * max_out);
+  *n_out = 0;
+  GeoArrowGEOSFeatureErrorsClear(&reader->reader->errors);
 
-  GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader, reader->array_view.validity_bitmap,
-                               offset);
+  while (*n_out < max_out) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSStreamReaderEnsureChunk(reader));
+    if (reader->finished) {
+      break;
+    }
 
-  for (size_t i = 0; i < length; i++) {
-    if (GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
+    size_t length = (size_t)reader->chunk.length - reader->chunk_offset;
+    if (length > (max_out - *n_out)) {
+      length = max_out - *n_out;
     }
 
-    int64_t data_offset = reader->array_view.offsets[0][i];
-    int64_t data_size = reader->array_view.offsets[0][i + 1] - data_offset;
+    GeoArrowGEOSArrayReaderResetScratch(reader->reader);
+    int result = GeoArrowGEOSArrayReaderReadFeatures(
+        reader->reader, reader->chunk_offset, length, out + *n_out, *n_out, n_out);
+    if (result != GEOARROW_OK) {
+      GeoArrowErrorSet(&reader->error, "%s", reader->reader->error.message);
+      return result;
+    }
 
-    // GEOSWKTReader_read_r() requires a null-terminated string. To ensure that, we
-    // copy into memory we own and add the null-terminator ourselves.
-    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderEnsureWKTTemp(reader, data_size + 1));
-    memcpy(reader->wkt_temp, reader->array_view.data + data_offset, data_size);
-    reader->wkt_temp[data_size] = '\0';
+    reader->chunk_offset += length;
+  }
 
-    out[i] = GEOSWKTReader_read_r(reader->handle, reader->wkt_reader, reader->wkt_temp);
-    if (out[i] == NULL) {
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSWKBReader_read_r() failed", (long)i);
-      return ENOMEM;
-    }
+  // Release a fully consumed chunk now rather than on the next call
+  if (reader->chunk.release != NULL &&
+      reader->chunk_offset >= (size_t)reader->chunk.length) {
+    reader->chunk.release(&reader->chunk);
+  }
 
-    *n_out += 1;
+  return GEOARROW_OK;
+}
+
+void GeoArrowGEOSStreamReaderDestroy(struct GeoArrowGEOSStreamReader* reader) {
+  if (reader->chunk.release != NULL) {
+    reader->chunk.release(&reader->chunk);
+  }
+
+  if (reader->reader != NULL) {
+    GeoArrowGEOSArrayReaderDestroy(reader->reader);
+  }
+
+  if (reader->stream.release != NULL) {
+    reader->stream.release(&reader->stream);
+  }
+
+  free(reader);
+}
+
+// The geometry types and dimensions seen so far are accumulated as bitsets so
+// that the result doesn't depend on the order of the input. Anything that
+// isn't a valid type sets the GEOMETRY bit (i.e., the output is WKB).
+#define GEOARROW_GEOS_DIMENSIONS_HAS_Z 1
+#define GEOARROW_GEOS_DIMENSIONS_HAS_M 2
+
+struct GeoArrowGEOSSchemaCalculator {
+  uint32_t geometry_types;
+  uint32_t dimensions;
+  int collect_stats;
+  struct GeoArrowGEOSSizeStats stats;
+};
+
+GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorCreate(
+    struct GeoArrowGEOSSchemaCalculator** out) {
+  struct GeoArrowGEOSSchemaCalculator* calc =
+      (struct GeoArrowGEOSSchemaCalculator*)malloc(
+          sizeof(struct GeoArrowGEOSSchemaCalculator));
+  if (calc == NULL) {
+    *out = NULL;
+    return ENOMEM;
   }
 
+  calc->geometry_types = 0;
+  calc->dimensions = 0;
+  calc->collect_stats = 0;
+  memset(&calc->stats, 0, sizeof(struct GeoArrowGEOSSizeStats));
+  *out = calc;
+
   return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode MakeCoordSeq(struct GeoArrowGEOSArrayReader* reader,
-                                      size_t offset, size_t length,
-                                      GEOSCoordSequence** out) {
-  offset += reader->array_view.offset[reader->array_view.n_offsets];
-  struct GeoArrowCoordView* coords = &reader->array_view.coords;
-  const double* z = NULL;
-  const double* m = NULL;
+// Returns the geometry type that can represent every type in geometry_types, -1
+// if no types have been seen, or GEOMETRY if there is no such type
+static int GeoArrowGEOSGeometryTypeFromBits(uint32_t geometry_types) {
+  static const uint32_t point_bits =
+      (1 << GEOARROW_GEOMETRY_TYPE_POINT) | (1 << GEOARROW_GEOMETRY_TYPE_MULTIPOINT);
+  static const uint32_t linestring_bits = (1 << GEOARROW_GEOMETRY_TYPE_LINESTRING) |
+                                          (1 << GEOARROW_GEOMETRY_TYPE_MULTILINESTRING);
+  static const uint32_t polygon_bits =
+      (1 << GEOARROW_GEOMETRY_TYPE_POLYGON) | (1 << GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON);
+
+  if (geometry_types == 0) {
+    return -1;
+  } else if ((geometry_types & ~point_bits) == 0) {
+    return (geometry_types & (1 << GEOARROW_GEOMETRY_TYPE_MULTIPOINT))
+               ? GEOARROW_GEOMETRY_TYPE_MULTIPOINT
+               : GEOARROW_GEOMETRY_TYPE_POINT;
+  } else if ((geometry_types & ~linestring_bits) == 0) {
+    return (geometry_types & (1 << GEOARROW_GEOMETRY_TYPE_MULTILINESTRING))
+               ? GEOARROW_GEOMETRY_TYPE_MULTILINESTRING
+               : GEOARROW_GEOMETRY_TYPE_LINESTRING;
+  } else if ((geometry_types & ~polygon_bits) == 0) {
+    return (geometry_types & (1 << GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON))
+               ? GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON
+               : GEOARROW_GEOMETRY_TYPE_POLYGON;
+  } else if (geometry_types == (1 << GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION)) {
+    return GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION;
+  } else {
+    return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  }
+}
 
-  switch (reader->array_view.schema_view.dimensions) {
+static void GeoArrowGEOSSchemaCalculatorAdd(struct GeoArrowGEOSSchemaCalculator* calc,
+                                            int32_t wkb_type) {
+  int32_t geometry_type = wkb_type % 1000;
+  int32_t dimensions = wkb_type / 1000;
+  if (geometry_type < 0 || geometry_type > GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION) {
+    geometry_type = GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  }
+
+  calc->geometry_types |= 1 << geometry_type;
+
+  switch (dimensions) {
+    case GEOARROW_DIMENSIONS_UNKNOWN:
+    case GEOARROW_DIMENSIONS_XY:
+      break;
     case GEOARROW_DIMENSIONS_XYZ:
-      z = coords->values[2];
+      calc->dimensions |= GEOARROW_GEOS_DIMENSIONS_HAS_Z;
       break;
     case GEOARROW_DIMENSIONS_XYM:
-      m = coords->values[2];
+      calc->dimensions |= GEOARROW_GEOS_DIMENSIONS_HAS_M;
       break;
     case GEOARROW_DIMENSIONS_XYZM:
-      z = coords->values[2];
-      m = coords->values[3];
+      calc->dimensions |= GEOARROW_GEOS_DIMENSIONS_HAS_Z | GEOARROW_GEOS_DIMENSIONS_HAS_M;
       break;
     default:
+      calc->geometry_types |= 1 << GEOARROW_GEOMETRY_TYPE_GEOMETRY;
       break;
   }
+}
 
-  GEOSCoordSequence* seq;
+// Once the result is GEOMETRY with XYZM dimensions no further input can change it
+static int GeoArrowGEOSSchemaCalculatorIsCollapsed(
+    struct GeoArrowGEOSSchemaCalculator* calc) {
+  return calc->dimensions ==
+             (GEOARROW_GEOS_DIMENSIONS_HAS_Z | GEOARROW_GEOS_DIMENSIONS_HAS_M) &&
+         GeoArrowGEOSGeometryTypeFromBits(calc->geometry_types) ==
+             GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+}
 
-  switch (reader->array_view.schema_view.coord_type) {
-    case GEOARROW_COORD_TYPE_SEPARATE:
-      seq = GEOSCoordSeq_copyFromArrays_r(reader->handle, coords->values[0] + offset,
-                                          coords->values[1] + offset, z, m, length);
+void GeoArrowGEOSSchemaCalculatorIngest(struct GeoArrowGEOSSchemaCalculator* calc,
+                                        const int32_t* wkb_type, size_t n) {
+  // Input is usually long runs of one type (and nulls), so only values that
+  // differ from the last one seen are decoded. Blocks that don't contain any
+  // are skipped with a branchless scan that the compiler can vectorize.
+  const size_t block_size = 256;
+  int32_t last = 0;
+  size_t i = 0;
+  while (i < n && !GeoArrowGEOSSchemaCalculatorIsCollapsed(calc)) {
+    size_t block_end = (n - i) > block_size ? i + block_size : n;
+
+    int differs = 0;
+    for (size_t j = i; j < block_end; j++) {
+      differs |= (wkb_type[j] != last) & (wkb_type[j] != 0);
+    }
+
+    if (!differs) {
+      i = block_end;
+      continue;
+    }
+
+    for (; i < block_end; i++) {
+      if (wkb_type[i] != 0 && wkb_type[i] != last) {
+        GeoArrowGEOSSchemaCalculatorAdd(calc, wkb_type[i]);
+        last = wkb_type[i];
+      }
+    }
+  }
+}
+
+void GeoArrowGEOSSchemaCalculatorSetCollectStats(
+    struct GeoArrowGEOSSchemaCalculator* calc, int collect) {
+  calc->collect_stats = collect != 0;
+}
+
+// Adds the rings and coordinates of geom (at any level) to stats
+static void GeoArrowGEOSSizeStatsAddCoords(GEOSContextHandle_t handle,
+                                           const GEOSGeometry* geom,
+                                           struct GeoArrowGEOSSizeStats* stats) {
+  switch (GEOSGeomTypeId_r(handle, geom)) {
+    case GEOS_POINT:
+      stats->n_coords += 1;
       break;
-    case GEOARROW_COORD_TYPE_INTERLEAVED:
-      seq = GEOSCoordSeq_copyFromBuffer_r(reader->handle,
-                                          coords->values[0] + (offset * coords->n_values),
-                                          length, z != NULL, m != NULL);
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+      stats->n_coords += GEOSGetNumCoordinates_r(handle, geom);
+      break;
+    case GEOS_POLYGON:
+      if (!GEOSisEmpty_r(handle, geom)) {
+        stats->n_rings += 1 + GEOSGetNumInteriorRings_r(handle, geom);
+        stats->n_coords += GEOSGetNumCoordinates_r(handle, geom);
+      }
+      break;
+    case GEOS_MULTIPOINT:
+    case GEOS_MULTILINESTRING:
+    case GEOS_MULTIPOLYGON:
+    case GEOS_GEOMETRYCOLLECTION: {
+      int n_parts = GEOSGetNumGeometries_r(handle, geom);
+      for (int i = 0; i < n_parts; i++) {
+        const GEOSGeometry* child = GEOSGetGeometryN_r(handle, geom, i);
+        if (child != NULL) {
+          GeoArrowGEOSSizeStatsAddCoords(handle, child, stats);
+        }
+      }
       break;
+    }
     default:
-      GeoArrowErrorSet(&reader->error, "Unsupported coord type");
-      return ENOTSUP;
+      break;
   }
+}
 
-  if (seq == NULL) {
-    GeoArrowErrorSet(&reader->error, "GEOSCoordSeq_copyFromArrays_r() failed");
-    return ENOMEM;
+static void GeoArrowGEOSSizeStatsAdd(GEOSContextHandle_t handle,
+                                     const GEOSGeometry* geom,
+                                     struct GeoArrowGEOSSizeStats* stats) {
+  stats->n_features++;
+  if (geom == NULL) {
+    stats->n_null++;
+    return;
   }
 
-  *out = seq;
-  return GEOARROW_OK;
-}
+  switch (GEOSGeomTypeId_r(handle, geom)) {
+    case GEOS_MULTIPOINT:
+    case GEOS_MULTILINESTRING:
+    case GEOS_MULTIPOLYGON:
+    case GEOS_GEOMETRYCOLLECTION:
+      stats->n_parts += GEOSGetNumGeometries_r(handle, geom);
+      break;
+    default:
+      stats->n_parts += 1;
+      break;
+  }
 
-static GeoArrowErrorCode MakePoints(struct GeoArrowGEOSArrayReader* reader, size_t offset,
-                                    size_t length, GEOSGeometry** out, size_t* n_out) {
-  int top_level =
-      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_POINT;
-  if (top_level) {
-    GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader,
-                                 reader->array_view.validity_bitmap,
-                                 reader->array_view.offset[0] + offset);
+  GeoArrowGEOSSizeStatsAddCoords(handle, geom, stats);
+
+  // Geometries that can't be written as WKB don't contribute to its size
+  struct GeoArrowError error;
+  int64_t wkb_size;
+  if (GeoArrowGEOSWKBSize(handle, geom, &wkb_size, &error) == GEOARROW_OK) {
+    stats->wkb_size += wkb_size;
   }
+}
 
-  GEOSCoordSequence* seq = NULL;
-  for (size_t i = 0; i < length; i++) {
-    if (top_level && GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
-    }
+void GeoArrowGEOSSchemaCalculatorIngestGeometry(
+    struct GeoArrowGEOSSchemaCalculator* calc, GEOSContextHandle_t handle,
+    const GEOSGeometry** geom, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    int32_t wkb_type = GeoArrowGEOSWKBType(handle, geom[i]);
+    GeoArrowGEOSSchemaCalculatorIngest(calc, &wkb_type, 1);
 
-    GEOARROW_RETURN_NOT_OK(MakeCoordSeq(reader, offset + i, 1, &seq));
-    out[i] = GEOSGeom_createPoint_r(reader->handle, seq);
-    if (out[i] == NULL) {
-      GEOSCoordSeq_destroy_r(reader->handle, seq);
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createPoint_r() failed", (long)i);
-      return ENOMEM;
+    if (calc->collect_stats) {
+      GeoArrowGEOSSizeStatsAdd(handle, geom[i], &calc->stats);
     }
+  }
+}
 
-    *n_out += 1;
+void GeoArrowGEOSSchemaCalculatorGetStats(struct GeoArrowGEOSSchemaCalculator* calc,
+                                          struct GeoArrowGEOSSizeStats* out) {
+  memcpy(out, &calc->stats, sizeof(struct GeoArrowGEOSSizeStats));
+}
+
+static void GeoArrowGEOSSizeStatsMerge(struct GeoArrowGEOSSizeStats* stats,
+                                       const struct GeoArrowGEOSSizeStats* other) {
+  stats->n_features += other->n_features;
+  stats->n_null += other->n_null;
+  stats->n_parts += other->n_parts;
+  stats->n_rings += other->n_rings;
+  stats->n_coords += other->n_coords;
+  stats->wkb_size += other->wkb_size;
+}
+
+void GeoArrowGEOSSchemaCalculatorMerge(struct GeoArrowGEOSSchemaCalculator* calc,
+                                       const struct GeoArrowGEOSSchemaCalculator* other) {
+  calc->geometry_types |= other->geometry_types;
+  calc->dimensions |= other->dimensions;
+  GeoArrowGEOSSizeStatsMerge(&calc->stats, &other->stats);
+}
+
+// The serialized state is a version, the geometry type and dimension bitsets,
+// a reserved field, and the size stats, all little endian
+#define GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_VERSION 1
+
+static void GeoArrowGEOSWriteLE(uint8_t** cursor, uint64_t value, int n_bytes) {
+  for (int i = 0; i < n_bytes; i++) {
+    (*cursor)[i] = (uint8_t)(value >> (8 * i));
   }
 
-  return GEOARROW_OK;
+  *cursor += n_bytes;
 }
 
-static GeoArrowErrorCode MakeLinestrings(struct GeoArrowGEOSArrayReader* reader,
-                                         size_t offset, size_t length, GEOSGeometry** out,
-                                         size_t* n_out) {
-  offset += reader->array_view.offset[reader->array_view.n_offsets - 1];
-  const int32_t* coord_offsets =
-      reader->array_view.offsets[reader->array_view.n_offsets - 1];
+static uint64_t GeoArrowGEOSReadLE(const uint8_t** cursor, int n_bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < n_bytes; i++) {
+    value |= (uint64_t)(*cursor)[i] << (8 * i);
+  }
 
-  int top_level =
-      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_LINESTRING;
-  if (top_level) {
-    GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader,
-                                 reader->array_view.validity_bitmap, offset);
+  *cursor += n_bytes;
+  return value;
+}
+
+void GeoArrowGEOSSchemaCalculatorGetState(struct GeoArrowGEOSSchemaCalculator* calc,
+                                          uint8_t* out) {
+  GeoArrowGEOSWriteLE(&out, GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_VERSION, 4);
+  GeoArrowGEOSWriteLE(&out, calc->geometry_types, 4);
+  GeoArrowGEOSWriteLE(&out, calc->dimensions, 4);
+  GeoArrowGEOSWriteLE(&out, 0, 4);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.n_features, 8);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.n_null, 8);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.n_parts, 8);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.n_rings, 8);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.n_coords, 8);
+  GeoArrowGEOSWriteLE(&out, (uint64_t)calc->stats.wkb_size, 8);
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorMergeState(
+    struct GeoArrowGEOSSchemaCalculator* calc, const uint8_t* state, size_t size) {
+  if (size != GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_SIZE ||
+      GeoArrowGEOSReadLE(&state, 4) != GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_VERSION) {
+    return EINVAL;
   }
 
-  GEOSCoordSequence* seq = NULL;
-  for (size_t i = 0; i < length; i++) {
-    if (top_level && GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
-    }
+  struct GeoArrowGEOSSchemaCalculator other;
+  other.geometry_types = (uint32_t)GeoArrowGEOSReadLE(&state, 4);
+  other.dimensions = (uint32_t)GeoArrowGEOSReadLE(&state, 4);
+  GeoArrowGEOSReadLE(&state, 4);
+  const uint32_t all_dimensions =
+      GEOARROW_GEOS_DIMENSIONS_HAS_Z | GEOARROW_GEOS_DIMENSIONS_HAS_M;
+  if (other.geometry_types >= (1 << (GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION + 1)) ||
+      other.dimensions > all_dimensions) {
+    return EINVAL;
+  }
 
-    GEOARROW_RETURN_NOT_OK(
-        MakeCoordSeq(reader, coord_offsets[offset + i],
-                     coord_offsets[offset + i + 1] - coord_offsets[offset + i], &seq));
-    out[i] = GEOSGeom_createLineString_r(reader->handle, seq);
-    if (out[i] == NULL) {
-      GEOSCoordSeq_destroy_r(reader->handle, seq);
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createLineString_r() failed",
-                       (long)i);
-      return ENOMEM;
-    }
+  other.stats.n_features = (int64_t)GeoArrowGEOSReadLE(&state, 8);
+  other.stats.n_null = (int64_t)GeoArrowGEOSReadLE(&state, 8);
+  other.stats.n_parts = (int64_t)GeoArrowGEOSReadLE(&state, 8);
+  other.stats.n_rings = (int64_t)GeoArrowGEOSReadLE(&state, 8);
+  other.stats.n_coords = (int64_t)GeoArrowGEOSReadLE(&state, 8);
+  other.stats.wkb_size = (int64_t)GeoArrowGEOSReadLE(&state, 8);
 
-    *n_out += 1;
+  GeoArrowGEOSSchemaCalculatorMerge(calc, &other);
+  return GEOARROW_OK;
+}
+
+// Ingested for features that can't be scanned: not a valid geometry type, so
+// it is ingested as GEOMETRY
+#define GEOARROW_GEOS_WKB_TYPE_INVALID 999
+
+// Nested collections deeper than this are considered invalid
+#define GEOARROW_GEOS_SCAN_MAX_DEPTH 32
+
+struct GeoArrowGEOSWKBScan {
+  const uint8_t* data;
+  int64_t size;
+  int64_t pos;
+};
+
+static GeoArrowErrorCode GeoArrowGEOSWKBScanUInt32(struct GeoArrowGEOSWKBScan* scan,
+                                                   int swap, uint32_t* out) {
+  if ((scan->size - scan->pos) < (int64_t)sizeof(uint32_t)) {
+    return EINVAL;
   }
 
+  memcpy(out, scan->data + scan->pos, sizeof(uint32_t));
+  if (swap) {
+    *out = ((*out & 0xff) << 24) | ((*out & 0xff00) << 8) | ((*out >> 8) & 0xff00) |
+           (*out >> 24);
+  }
+
+  scan->pos += sizeof(uint32_t);
   return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode MakeLinearrings(struct GeoArrowGEOSArrayReader* reader,
-                                         size_t offset, size_t length,
-                                         GEOSGeometry** out) {
-  offset += reader->array_view.offset[reader->array_view.n_offsets - 1];
-  const int32_t* coord_offsets =
-      reader->array_view.offsets[reader->array_view.n_offsets - 1];
+static GeoArrowErrorCode GeoArrowGEOSWKBScanDouble(struct GeoArrowGEOSWKBScan* scan,
+                                                   int swap, double* out) {
+  if ((scan->size - scan->pos) < (int64_t)sizeof(double)) {
+    return EINVAL;
+  }
 
-  GEOSCoordSequence* seq = NULL;
-  for (size_t i = 0; i < length; i++) {
-    GEOARROW_RETURN_NOT_OK(
-        MakeCoordSeq(reader, coord_offsets[offset + i],
-                     coord_offsets[offset + i + 1] - coord_offsets[offset + i], &seq));
-    out[i] = GEOSGeom_createLinearRing_r(reader->handle, seq);
-    if (out[i] == NULL) {
-      GEOSCoordSeq_destroy_r(reader->handle, seq);
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createLinearRing_r() failed",
-                       (long)i);
-      return ENOMEM;
-    }
+  uint8_t bytes[sizeof(double)];
+  for (size_t i = 0; i < sizeof(double); i++) {
+    bytes[i] = scan->data[scan->pos + (swap ? sizeof(double) - i - 1 : i)];
+  }
+
+  memcpy(out, bytes, sizeof(double));
+  scan->pos += sizeof(double);
+  return GEOARROW_OK;
+}
+
+static GeoArrowErrorCode GeoArrowGEOSWKBScanSkip(struct GeoArrowGEOSWKBScan* scan,
+                                                 int64_t n_bytes) {
+  if ((scan->size - scan->pos) < n_bytes) {
+    return EINVAL;
   }
 
+  scan->pos += n_bytes;
   return GEOARROW_OK;
 }
 
-static GeoArrowErrorCode MakePolygons(struct GeoArrowGEOSArrayReader* reader,
-                                      size_t offset, size_t length, GEOSGeometry** out,
-                                      size_t* n_out) {
-  offset += reader->array_view.offset[reader->array_view.n_offsets - 2];
-  const int32_t* ring_offsets =
-      reader->array_view.offsets[reader->array_view.n_offsets - 2];
+// Scans the geometry at the current position, setting *has_coords if it
+// contains any (non-NaN) coordinates. The geometry type and dimensions are
+// read from the header (ISO or EWKB) as a calculator wkb_type. Stops as soon
+// as a coordinate is found.
+static GeoArrowErrorCode GeoArrowGEOSWKBScanGeometry(struct GeoArrowGEOSWKBScan* scan,
+                                                     int depth, int32_t* wkb_type,
+                                                     int* has_coords) {
+  if (depth > GEOARROW_GEOS_SCAN_MAX_DEPTH || scan->pos >= scan->size) {
+    return EINVAL;
+  }
+
+  uint8_t endian = scan->data[scan->pos++];
+  if (endian > 1) {
+    return EINVAL;
+  }
+
+  int swap = endian != GEOARROW_GEOS_WKB_ENDIAN;
+  uint32_t type;
+  GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanUInt32(scan, swap, &type));
+  if (type & 0x20000000) {
+    GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanSkip(scan, sizeof(uint32_t)));
+  }
 
-  int top_level =
-      reader->array_view.schema_view.geometry_type == GEOARROW_GEOMETRY_TYPE_POLYGON;
-  if (top_level) {
-    GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader,
-                                 reader->array_view.validity_bitmap, offset);
+  int has_z = (type & 0x80000000) != 0;
+  int has_m = (type & 0x40000000) != 0;
+  type &= 0x0fffffff;
+  if ((type / 1000) > 3 || (type % 1000) < GEOARROW_GEOMETRY_TYPE_POINT ||
+      (type % 1000) > GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION) {
+    return EINVAL;
   }
 
-  for (size_t i = 0; i < length; i++) {
-    if (top_level && GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
-    }
+  has_z = has_z || (type / 1000) == 1 || (type / 1000) == 3;
+  has_m = has_m || (type / 1000) == 2 || (type / 1000) == 3;
+  int n_dims = 2 + has_z + has_m;
+  uint32_t geometry_type = type % 1000;
 
-    int64_t ring_offset = ring_offsets[offset + i];
-    int64_t n_rings = ring_offsets[offset + i + 1] - ring_offset;
+  static const int32_t dimensions[2][2] = {{0, 3000}, {2000, 4000}};
+  *wkb_type = dimensions[has_z][has_m] + geometry_type;
 
-    if (n_rings == 0) {
-      out[i] = GEOSGeom_createEmptyPolygon_r(reader->handle);
-    } else {
-      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSArrayReaderEnsureScratch(reader, n_rings, 0));
-      GEOARROW_RETURN_NOT_OK(
-          MakeLinearrings(reader, ring_offset, n_rings, reader->geoms[0]));
-      out[i] = GEOSGeom_createPolygon_r(reader->handle, reader->geoms[0][0],
-                                        reader->geoms[0] + 1, n_rings - 1);
-      memset(reader->geoms[0], 0, n_rings * sizeof(GEOSGeometry*));
+  uint32_t n;
+  switch (geometry_type) {
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      // An empty point is written with all NaN coordinates
+      for (int i = 0; i < n_dims; i++) {
+        double value;
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanDouble(scan, swap, &value));
+        *has_coords = *has_coords || !isnan(value);
+      }
+      return GEOARROW_OK;
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanUInt32(scan, swap, &n));
+      *has_coords = n > 0;
+      return GeoArrowGEOSWKBScanSkip(scan, (int64_t)n * n_dims * sizeof(double));
+    case GEOARROW_GEOMETRY_TYPE_POLYGON: {
+      uint32_t n_rings;
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanUInt32(scan, swap, &n_rings));
+      for (uint32_t i = 0; i < n_rings && !*has_coords; i++) {
+        GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanUInt32(scan, swap, &n));
+        *has_coords = n > 0;
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowGEOSWKBScanSkip(scan, (int64_t)n * n_dims * sizeof(double)));
+      }
+      return GEOARROW_OK;
     }
-
-    if (out[i] == NULL) {
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createPolygon_r() failed",
-                       (long)i);
-      return ENOMEM;
+    default: {
+      uint32_t n_parts;
+      GEOARROW_RETURN_NOT_OK(GeoArrowGEOSWKBScanUInt32(scan, swap, &n_parts));
+      int32_t part_wkb_type;
+      for (uint32_t i = 0; i < n_parts && !*has_coords; i++) {
+        GEOARROW_RETURN_NOT_OK(
+            GeoArrowGEOSWKBScanGeometry(scan, depth + 1, &part_wkb_type, has_coords));
+      }
+      return GEOARROW_OK;
     }
+  }
+}
 
-    *n_out += 1;
+static int32_t GeoArrowGEOSWKBScanType(const uint8_t* data, int64_t size) {
+  struct GeoArrowGEOSWKBScan scan = {data, size, 0};
+  int32_t wkb_type;
+  int has_coords = 0;
+  if (GeoArrowGEOSWKBScanGeometry(&scan, 0, &wkb_type, &has_coords) != GEOARROW_OK) {
+    return GEOARROW_GEOS_WKB_TYPE_INVALID;
   }
 
-  return GEOARROW_OK;
+  return has_coords ? wkb_type : 0;
 }
 
-typedef GeoArrowErrorCode (*GeoArrowGEOSPartMaker)(struct GeoArrowGEOSArrayReader* reader,
-                                                   size_t offset, size_t length,
-                                                   GEOSGeometry** out, size_t* n_out);
+static int GeoArrowGEOSWKTIsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
 
-static GeoArrowErrorCode MakeCollection(struct GeoArrowGEOSArrayReader* reader,
-                                        size_t offset, size_t length, GEOSGeometry** out,
-                                        int geom_level, int offset_level, int geos_type,
-                                        GeoArrowGEOSPartMaker part_maker, size_t* n_out) {
-  offset += reader->array_view.offset[reader->array_view.n_offsets - offset_level];
-  const int32_t* part_offsets =
-      reader->array_view.offsets[reader->array_view.n_offsets - offset_level];
+static int GeoArrowGEOSWKTIsAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
 
-  // Currently collections are always outer geometries
-  GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader, reader->array_view.validity_bitmap,
-                               offset);
+// Returns non-zero if the size characters at word are equal to value ignoring
+// case (value is upper case)
+static int GeoArrowGEOSWKTWordEquals(const char* word, int64_t size, const char* value) {
+  if (size != (int64_t)strlen(value)) {
+    return 0;
+  }
 
-  size_t part_n_out = 0;
-  for (size_t i = 0; i < length; i++) {
-    if (GeoArrowGEOSBitmapReaderNextIsNull(&reader->bitmap_reader)) {
-      out[i] = NULL;
-      *n_out += 1;
-      continue;
+  for (int64_t i = 0; i < size; i++) {
+    char c = word[i] >= 'a' && word[i] <= 'z' ? (char)(word[i] - 'a' + 'A') : word[i];
+    if (c != value[i]) {
+      return 0;
     }
+  }
 
-    int64_t part_offset = part_offsets[offset + i];
-    int64_t n_parts = part_offsets[offset + i + 1] - part_offset;
-
-    if (n_parts == 0) {
-      out[i] = GEOSGeom_createEmptyCollection_r(reader->handle, geos_type);
-    } else {
-      GEOARROW_RETURN_NOT_OK(
-          GeoArrowGEOSArrayReaderEnsureScratch(reader, n_parts, geom_level));
-      GEOARROW_RETURN_NOT_OK(part_maker(reader, part_offset, n_parts,
-                                        reader->geoms[geom_level], &part_n_out));
-      out[i] = GEOSGeom_createCollection_r(reader->handle, geos_type,
-                                           reader->geoms[geom_level], n_parts);
-      memset(reader->geoms[geom_level], 0, n_parts * sizeof(GEOSGeometry*));
-    }
+  return 1;
+}
 
-    if (out[i] == NULL) {
-      GeoArrowErrorSet(&reader->error, "[%ld] GEOSGeom_createEmptyCollection_r() failed",
-                       (long)i);
-      return ENOMEM;
-    }
+// Advances *pos past any whitespace and the next word, returning its length
+static int64_t GeoArrowGEOSWKTScanWord(const char* data, int64_t size, int64_t* pos) {
+  while (*pos < size && GeoArrowGEOSWKTIsSpace(data[*pos])) {
+    (*pos)++;
+  }
 
-    *n_out += 1;
+  int64_t start = *pos;
+  while (*pos < size && GeoArrowGEOSWKTIsAlpha(data[*pos])) {
+    (*pos)++;
   }
 
-  return GEOARROW_OK;
+  return *pos - start;
 }
 
-GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderRead(struct GeoArrowGEOSArrayReader* reader,
-                                                  struct ArrowArray* array, size_t offset,
-                                                  size_t length, GEOSGeometry** out,
-                                                  size_t* n_out) {
-  GeoArrowGEOSArrayReaderResetScratch(reader);
-
-  GEOARROW_RETURN_NOT_OK(
-      GeoArrowArrayViewSetArray(&reader->array_view, array, &reader->error));
-
-  GeoArrowGEOSBitmapReaderInit(&reader->bitmap_reader, NULL, 0);
+// Returns 0 (not tagged), 2000 (Z), 3000 (M), or 4000 (ZM) if the size
+// characters at word are a dimension tag or -1 otherwise
+static int32_t GeoArrowGEOSWKTDimensions(const char* word, int64_t size) {
+  if (size == 0) {
+    return 0;
+  } else if (GeoArrowGEOSWKTWordEquals(word, size, "Z")) {
+    return 2000;
+  } else if (GeoArrowGEOSWKTWordEquals(word, size, "M")) {
+    return 3000;
+  } else if (GeoArrowGEOSWKTWordEquals(word, size, "ZM")) {
+    return 4000;
+  } else {
+    return -1;
+  }
+}
 
-  memset(out, 0, sizeof(GEOSGeometry*) * length);
-  *n_out = 0;
+static int32_t GeoArrowGEOSWKTScanType(const char* data, int64_t size) {
+  static const char* names[] = {"POINT",          "LINESTRING",      "POLYGON",
+                                "MULTIPOINT",     "MULTILINESTRING", "MULTIPOLYGON",
+                                "GEOMETRYCOLLECTION"};
+
+  // Skip an EWKT SRID=...; prefix
+  int64_t pos = 0;
+  if (size > 5 && GeoArrowGEOSWKTWordEquals(data, 4, "SRID") && data[4] == '=') {
+    const char* srid_end = (const char*)memchr(data, ';', size);
+    if (srid_end == NULL) {
+      return GEOARROW_GEOS_WKB_TYPE_INVALID;
+    }
 
-  GeoArrowErrorCode result;
-  switch (reader->array_view.schema_view.type) {
-    case GEOARROW_TYPE_WKB:
-      if (reader->wkb_reader == NULL) {
-        reader->wkb_reader = GEOSWKBReader_create_r(reader->handle);
-        if (reader->wkb_reader == NULL) {
-          GeoArrowErrorSet(&reader->error, "GEOSWKBReader_create_r() failed");
-          return ENOMEM;
-        }
-      }
+    pos = srid_end - data + 1;
+  }
 
-      result = MakeGeomFromWKB(reader, offset, length, out, n_out);
-      break;
-    case GEOARROW_TYPE_WKT:
-      if (reader->wkt_reader == NULL) {
-        reader->wkt_reader = GEOSWKTReader_create_r(reader->handle);
-        if (reader->wkt_reader == NULL) {
-          GeoArrowErrorSet(&reader->error, "GEOSWKTReader_create_r() failed");
-          return ENOMEM;
-        }
-      }
+  // The geometry type, which may have a dimension suffix (e.g., POINTZ)
+  int64_t word_size = GeoArrowGEOSWKTScanWord(data, size, &pos);
+  int64_t word_start = pos - word_size;
+  int32_t geometry_type = 0;
+  int32_t dimensions = -1;
+  for (int i = 0; i < 7 && dimensions == -1; i++) {
+    int64_t name_size = strlen(names[i]);
+    if (word_size >= name_size &&
+        GeoArrowGEOSWKTWordEquals(data + word_start, name_size, names[i])) {
+      geometry_type = i + 1;
+      dimensions =
+          GeoArrowGEOSWKTDimensions(data + word_start + name_size, word_size - name_size);
+    }
+  }
 
-      result = MakeGeomFromWKT(reader, offset, length, out, n_out);
-      break;
-    default:
-      switch (reader->array_view.schema_view.geometry_type) {
-        case GEOARROW_GEOMETRY_TYPE_POINT:
-          result = MakePoints(reader, offset, length, out, n_out);
-          break;
-        case GEOARROW_GEOMETRY_TYPE_LINESTRING:
-          result = MakeLinestrings(reader, offset, length, out, n_out);
-          break;
-        case GEOARROW_GEOMETRY_TYPE_POLYGON:
-          result = MakePolygons(reader, offset, length, out, n_out);
-          break;
-        case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
-          result = MakeCollection(reader, offset, length, out, 0, 1, GEOS_MULTIPOINT,
-                                  &MakePoints, n_out);
-          break;
-        case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
-          result = MakeCollection(reader, offset, length, out, 0, 2, GEOS_MULTILINESTRING,
-                                  &MakeLinestrings, n_out);
-          break;
-        case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
-          result = MakeCollection(reader, offset, length, out, 1, 3, GEOS_MULTIPOLYGON,
-                                  &MakePolygons, n_out);
-          break;
-        default:
-          GeoArrowErrorSet(&reader->error,
-                           "GeoArrowGEOSArrayReaderRead not implemented for array type");
-          return ENOTSUP;
-      }
+  if (dimensions == -1) {
+    return GEOARROW_GEOS_WKB_TYPE_INVALID;
   }
 
-  return result;
-}
+  // The next word is a dimension tag, EMPTY, or nothing
+  word_size = GeoArrowGEOSWKTScanWord(data, size, &pos);
+  if (dimensions == 0) {
+    dimensions = GeoArrowGEOSWKTDimensions(data + pos - word_size, word_size);
+    if (dimensions > 0) {
+      word_size = GeoArrowGEOSWKTScanWord(data, size, &pos);
+    } else {
+      dimensions = 0;
+    }
+  }
 
-void GeoArrowGEOSArrayReaderDestroy(struct GeoArrowGEOSArrayReader* reader) {
-  if (reader->wkt_reader != NULL) {
-    GEOSWKTReader_destroy_r(reader->handle, reader->wkt_reader);
+  if (GeoArrowGEOSWKTWordEquals(data + pos - word_size, word_size, "EMPTY")) {
+    return 0;
+  } else if (word_size > 0 || pos >= size || data[pos] != '(') {
+    return GEOARROW_GEOS_WKB_TYPE_INVALID;
   }
 
-  if (reader->wkb_reader != NULL) {
-    GEOSWKBReader_destroy_r(reader->handle, reader->wkb_reader);
+  // Nested geometries may all be empty
+  while (pos < size && !(data[pos] >= '0' && data[pos] <= '9')) {
+    pos++;
   }
 
-  GeoArrowGEOSArrayReaderResetScratch(reader);
+  if (pos == size) {
+    return 0;
+  }
 
-  for (int i = 0; i < 2; i++) {
-    if (reader->geoms[i] != NULL) {
-      free(reader->geoms[i]);
+  // Without a tag, the number of ordinates in the first coordinate determines
+  // the dimensions (as it does for GEOS)
+  if (dimensions == 0) {
+    int n_ordinates = 0;
+    int in_ordinate = 0;
+    for (; pos < size && data[pos] != ',' && data[pos] != ')'; pos++) {
+      if (GeoArrowGEOSWKTIsSpace(data[pos])) {
+        in_ordinate = 0;
+      } else if (!in_ordinate) {
+        in_ordinate = 1;
+        n_ordinates++;
+      }
     }
-  }
 
-  if (reader->wkt_temp != NULL) {
-    free(reader->wkt_temp);
+    if (n_ordinates == 3) {
+      dimensions = 2000;
+    } else if (n_ordinates >= 4) {
+      dimensions = 4000;
+    }
   }
 
-  free(reader);
+  return dimensions + geometry_type;
 }
 
-struct GeoArrowGEOSSchemaCalculator {
-  int geometry_type;
-  int dimensions;
+struct GeoArrowGEOSIngestTask {
+  struct GeoArrowGEOSSchemaCalculator calc;
+  enum GeoArrowGEOSEncoding encoding;
+  const struct ArrowArray* array;
+  int64_t offset;
+  int64_t length;
 };
 
-GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorCreate(
-    struct GeoArrowGEOSSchemaCalculator** out) {
-  struct GeoArrowGEOSSchemaCalculator* calc =
-      (struct GeoArrowGEOSSchemaCalculator*)malloc(
-          sizeof(struct GeoArrowGEOSSchemaCalculator));
-  if (calc == NULL) {
-    *out = NULL;
-    return ENOMEM;
-  }
+static void GeoArrowGEOSIngestTaskRun(void* task_void) {
+  struct GeoArrowGEOSIngestTask* task = (struct GeoArrowGEOSIngestTask*)task_void;
+  const struct ArrowArray* array = task->array;
+  const uint8_t* validity =
+      array->null_count == 0 ? NULL : (const uint8_t*)array->buffers[0];
+  const int32_t* offsets = (const int32_t*)array->buffers[1];
+  const int64_t* large_offsets = (const int64_t*)array->buffers[1];
+  const uint8_t* data = (const uint8_t*)array->buffers[2];
+  int large = task->encoding == GEOARROW_GEOS_ENCODING_LARGE_WKB ||
+              task->encoding == GEOARROW_GEOS_ENCODING_LARGE_WKT;
+  int wkb = task->encoding == GEOARROW_GEOS_ENCODING_WKB ||
+            task->encoding == GEOARROW_GEOS_ENCODING_LARGE_WKB;
+
+  // Types are scanned in blocks so that scanning stops soon after the result
+  // can't change
+  int32_t wkb_type[256];
+  int64_t end = task->offset + task->length;
+  for (int64_t i = task->offset;
+       i < end && !GeoArrowGEOSSchemaCalculatorIsCollapsed(&task->calc);) {
+    int64_t n = (end - i) > 256 ? 256 : (end - i);
+    for (int64_t j = 0; j < n; j++) {
+      int64_t index = array->offset + i + j;
+      if (validity != NULL && !(validity[index / 8] & (1 << (index % 8)))) {
+        wkb_type[j] = 0;
+        continue;
+      }
 
-  calc->geometry_type = -1;
-  calc->dimensions = GEOARROW_DIMENSIONS_UNKNOWN;
-  *out = calc;
+      int64_t start = large ? large_offsets[index] : offsets[index];
+      int64_t size = (large ? large_offsets[index + 1] : offsets[index + 1]) - start;
+      wkb_type[j] = wkb ? GeoArrowGEOSWKBScanType(data + start, size)
+                        : GeoArrowGEOSWKTScanType((const char*)data + start, size);
+    }
 
-  return GEOARROW_OK;
+    GeoArrowGEOSSchemaCalculatorIngest(&task->calc, wkb_type, n);
+    i += n;
+  }
 }
 
-static int GeometryType2(int x, int y) {
-  switch (x) {
-    case -1:
-      return y;
-    case GEOARROW_GEOMETRY_TYPE_GEOMETRY:
-      return x;
-    case GEOARROW_GEOMETRY_TYPE_POINT:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_POINT:
-        case GEOARROW_TYPE_MULTIPOINT:
-          return y;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_LINESTRING:
-        case GEOARROW_TYPE_MULTILINESTRING:
-          return y;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_POLYGON:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_POLYGON:
-        case GEOARROW_TYPE_MULTIPOLYGON:
-          return y;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_POINT:
-        case GEOARROW_TYPE_MULTIPOINT:
-          return x;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_LINESTRING:
-        case GEOARROW_TYPE_MULTILINESTRING:
-          return x;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_TYPE_POLYGON:
-        case GEOARROW_TYPE_MULTIPOLYGON:
-          return x;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
-    case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION:
-      switch (y) {
-        case -1:
-          return x;
-        case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION:
-          return x;
-        default:
-          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
-      }
+GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorIngestArray(
+    struct GeoArrowGEOSSchemaCalculator* calc, enum GeoArrowGEOSEncoding encoding,
+    const struct ArrowArray* array, int n_threads) {
+  switch (encoding) {
+    case GEOARROW_GEOS_ENCODING_WKB:
+    case GEOARROW_GEOS_ENCODING_WKT:
+    case GEOARROW_GEOS_ENCODING_LARGE_WKB:
+    case GEOARROW_GEOS_ENCODING_LARGE_WKT:
+      break;
     default:
-      return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      return EINVAL;
   }
-}
 
-static int Dimensions2(int x, int y) {
-  switch (x) {
-    case GEOARROW_DIMENSIONS_UNKNOWN:
-      return y;
-    case GEOARROW_DIMENSIONS_XY:
-      switch (y) {
-        case GEOARROW_DIMENSIONS_UNKNOWN:
-          return x;
-        default:
-          return y;
-      }
-    case GEOARROW_DIMENSIONS_XYZ:
-      switch (y) {
-        case GEOARROW_DIMENSIONS_UNKNOWN:
-          return x;
-        case GEOARROW_DIMENSIONS_XYM:
-          return GEOARROW_DIMENSIONS_XYZM;
-        default:
-          return y;
-      }
-    case GEOARROW_DIMENSIONS_XYM:
-      switch (y) {
-        case GEOARROW_DIMENSIONS_UNKNOWN:
-          return x;
-        case GEOARROW_DIMENSIONS_XYZ:
-          return GEOARROW_DIMENSIONS_XYZM;
-        default:
-          return y;
-      }
-    default:
-      return GEOARROW_DIMENSIONS_XYZM;
+  if (array->n_buffers != 3) {
+    return EINVAL;
   }
-}
 
-void GeoArrowGEOSSchemaCalculatorIngest(struct GeoArrowGEOSSchemaCalculator* calc,
-                                        const int32_t* wkb_type, size_t n) {
-  for (size_t i = 0; i < n; i++) {
-    if (wkb_type[i] == 0) {
-      continue;
-    }
+  if (n_threads > array->length) {
+    n_threads = (int)array->length;
+  }
 
-    calc->geometry_type = GeometryType2(calc->geometry_type, wkb_type[i] % 1000);
-    calc->dimensions = Dimensions2(calc->dimensions, wkb_type[i] / 1000);
+  if (n_threads < 1) {
+    n_threads = 1;
   }
+
+  struct GeoArrowGEOSIngestTask* tasks = (struct GeoArrowGEOSIngestTask*)calloc(
+      n_threads, sizeof(struct GeoArrowGEOSIngestTask));
+  if (tasks == NULL) {
+    return ENOMEM;
+  }
+
+  for (int i = 0; i < n_threads; i++) {
+    tasks[i].encoding = encoding;
+    tasks[i].array = array;
+    tasks[i].offset = (array->length * i) / n_threads;
+    tasks[i].length = (array->length * (i + 1)) / n_threads - tasks[i].offset;
+  }
+
+  GeoArrowErrorCode result =
+      GeoArrowGEOSRunTasks(&GeoArrowGEOSIngestTaskRun, tasks,
+                           sizeof(struct GeoArrowGEOSIngestTask), n_threads);
+  if (result == GEOARROW_OK) {
+    for (int i = 0; i < n_threads; i++) {
+      GeoArrowGEOSSchemaCalculatorMerge(calc, &tasks[i].calc);
+    }
+  }
+
+  free(tasks);
+  return result;
 }
 
 GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorFinish(
@@ -1013,6 +6771,8 @@ GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorFinish(
   switch (encoding) {
     case GEOARROW_GEOS_ENCODING_WKT:
     case GEOARROW_GEOS_ENCODING_WKB:
+    case GEOARROW_GEOS_ENCODING_LARGE_WKT:
+    case GEOARROW_GEOS_ENCODING_LARGE_WKB:
       return GeoArrowGEOSMakeSchema(encoding, 0, out);
     case GEOARROW_GEOS_ENCODING_GEOARROW:
       coord_type = GEOARROW_COORD_TYPE_INTERLEAVED;
@@ -1024,15 +6784,16 @@ GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorFinish(
       return EINVAL;
   }
 
+  int calc_geometry_type = GeoArrowGEOSGeometryTypeFromBits(calc->geometry_types);
   enum GeoArrowGeometryType geometry_type;
-  switch (calc->geometry_type) {
+  switch (calc_geometry_type) {
     case GEOARROW_GEOMETRY_TYPE_POINT:
     case GEOARROW_GEOMETRY_TYPE_LINESTRING:
     case GEOARROW_GEOMETRY_TYPE_POLYGON:
     case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
     case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
     case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
-      geometry_type = (enum GeoArrowGeometryType)calc->geometry_type;
+      geometry_type = (enum GeoArrowGeometryType)calc_geometry_type;
       break;
     case -1:
       // We don't have an "empty"/"null" type to return, but "POINT" is also
@@ -1043,17 +6804,18 @@ GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorFinish(
 
   enum GeoArrowDimensions dimensions;
   switch (calc->dimensions) {
-    case GEOARROW_DIMENSIONS_UNKNOWN:
-      dimensions = GEOARROW_DIMENSIONS_XY;
+    case GEOARROW_GEOS_DIMENSIONS_HAS_Z:
+      dimensions = GEOARROW_DIMENSIONS_XYZ;
       break;
-    case GEOARROW_DIMENSIONS_XY:
-    case GEOARROW_DIMENSIONS_XYZ:
-    case GEOARROW_DIMENSIONS_XYM:
-    case GEOARROW_DIMENSIONS_XYZM:
-      dimensions = (enum GeoArrowDimensions)calc->dimensions;
+    case GEOARROW_GEOS_DIMENSIONS_HAS_M:
+      dimensions = GEOARROW_DIMENSIONS_XYM;
+      break;
+    case GEOARROW_GEOS_DIMENSIONS_HAS_Z | GEOARROW_GEOS_DIMENSIONS_HAS_M:
+      dimensions = GEOARROW_DIMENSIONS_XYZM;
       break;
     default:
-      return GeoArrowGEOSMakeSchema(GEOARROW_GEOS_ENCODING_WKB, 0, out);
+      dimensions = GEOARROW_DIMENSIONS_XY;
+      break;
   }
 
   enum GeoArrowType type = GeoArrowMakeType(geometry_type, dimensions, coord_type);
@@ -1065,6 +6827,68 @@ void GeoArrowGEOSSchemaCalculatorDestroy(struct GeoArrowGEOSSchemaCalculator* ca
   free(calc);
 }
 
+struct GeoArrowGEOSWKBTypeTask {
+  GEOSContextHandle_t handle;
+  const GEOSGeometry** geom;
+  size_t n;
+  int32_t* out;
+};
+
+static void GeoArrowGEOSWKBTypeTaskRun(void* task_void) {
+  struct GeoArrowGEOSWKBTypeTask* task = (struct GeoArrowGEOSWKBTypeTask*)task_void;
+  for (size_t i = 0; i < task->n; i++) {
+    task->out[i] = GeoArrowGEOSWKBType(task->handle, task->geom[i]);
+  }
+}
+
+GeoArrowGEOSErrorCode GeoArrowGEOSWKBTypes(GEOSContextHandle_t handle,
+                                           const GEOSGeometry** geom, size_t n,
+                                           int n_threads, int32_t* out) {
+  if (n_threads > (int64_t)n) {
+    n_threads = (int)n;
+  }
+
+  if (n_threads <= 1) {
+    struct GeoArrowGEOSWKBTypeTask task = {handle, geom, n, out};
+    GeoArrowGEOSWKBTypeTaskRun(&task);
+    return GEOARROW_OK;
+  }
+
+  struct GeoArrowGEOSWKBTypeTask* tasks = (struct GeoArrowGEOSWKBTypeTask*)calloc(
+      n_threads, sizeof(struct GeoArrowGEOSWKBTypeTask));
+  if (tasks == NULL) {
+    return ENOMEM;
+  }
+
+  // The first task runs on the calling thread and can use its context
+  GeoArrowErrorCode result = GEOARROW_OK;
+  for (int i = 0; i < n_threads; i++) {
+    size_t offset = (n * i) / n_threads;
+    tasks[i].geom = geom + offset;
+    tasks[i].n = (n * (i + 1)) / n_threads - offset;
+    tasks[i].out = out + offset;
+    tasks[i].handle = i == 0 ? handle : GEOS_init_r();
+    if (tasks[i].handle == NULL) {
+      result = ENOMEM;
+      break;
+    }
+  }
+
+  if (result == GEOARROW_OK) {
+    result = GeoArrowGEOSRunTasks(&GeoArrowGEOSWKBTypeTaskRun, tasks,
+                                  sizeof(struct GeoArrowGEOSWKBTypeTask), n_threads);
+  }
+
+  for (int i = 1; i < n_threads; i++) {
+    if (tasks[i].handle != NULL) {
+      GEOS_finish_r(tasks[i].handle);
+    }
+  }
+
+  free(tasks);
+  return result;
+}
+
 GeoArrowGEOSErrorCode GeoArrowGEOSMakeSchema(int32_t encoding, int32_t wkb_type,
                                              struct ArrowSchema* out) {
   enum GeoArrowType type = GEOARROW_TYPE_UNINITIALIZED;
@@ -1079,6 +6903,12 @@ GeoArrowGEOSErrorCode GeoArrowGEOSMakeSchema(int32_t encoding, int32_t wkb_type,
     case GEOARROW_GEOS_ENCODING_WKB:
       type = GEOARROW_TYPE_WKB;
       break;
+    case GEOARROW_GEOS_ENCODING_LARGE_WKT:
+      type = GEOARROW_TYPE_LARGE_WKT;
+      break;
+    case GEOARROW_GEOS_ENCODING_LARGE_WKB:
+      type = GEOARROW_TYPE_LARGE_WKB;
+      break;
     case GEOARROW_GEOS_ENCODING_GEOARROW:
       coord_type = GEOARROW_COORD_TYPE_SEPARATE;
       break;
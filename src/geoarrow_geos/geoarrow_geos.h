@@ -56,6 +56,24 @@ struct ArrowArray {
 
 #endif
 
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  // Callbacks providing stream functionality
+  int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+  int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+  const char* (*get_last_error)(struct ArrowArrayStream*);
+
+  // Release callback
+  void (*release)(struct ArrowArrayStream*);
+
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
 #define GEOARROW_GEOS_OK 0
 
 enum GeoArrowGEOSEncoding {
@@ -63,11 +81,109 @@ enum GeoArrowGEOSEncoding {
   GEOARROW_GEOS_ENCODING_WKT,
   GEOARROW_GEOS_ENCODING_WKB,
   GEOARROW_GEOS_ENCODING_GEOARROW,
-  GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED
+  GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED,
+  GEOARROW_GEOS_ENCODING_LARGE_WKT,
+  GEOARROW_GEOS_ENCODING_LARGE_WKB
+};
+
+enum GeoArrowGEOSParser { GEOARROW_GEOS_PARSER_GEOARROW = 0, GEOARROW_GEOS_PARSER_GEOS };
+
+enum GeoArrowGEOSLargeOffsets {
+  GEOARROW_GEOS_LARGE_OFFSETS_NEVER = 0,
+  GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS,
+  GEOARROW_GEOS_LARGE_OFFSETS_AUTO
 };
 
+enum GeoArrowGEOSOnError { GEOARROW_GEOS_ON_ERROR_FAIL = 0, GEOARROW_GEOS_ON_ERROR_NULL };
+
 typedef int GeoArrowGEOSErrorCode;
 
+// Totals for a set of geometries, gathered by a GeoArrowGEOSSchemaCalculator,
+// that a GeoArrowGEOSArrayBuilder can use to reserve its buffers exactly.
+// Parts are counted for top-level geometries only (a single geometry is one
+// part); rings and coordinates are counted at every level. An empty point is
+// one coordinate because it is written as NaN.
+struct GeoArrowGEOSSizeStats {
+  int64_t n_features;
+  int64_t n_null;
+  int64_t n_parts;
+  int64_t n_rings;
+  int64_t n_coords;
+  int64_t wkb_size;
+};
+
+// Counters kept by a GeoArrowGEOSArrayReader or GeoArrowGEOSArrayBuilder since it
+// was created or its counters were last reset. Counts are always kept; times
+// (cumulative nanoseconds) are only measured once enabled because each
+// measurement reads the clock. Time not attributed to a phase is spent creating
+// or inspecting GEOS geometries and in bookkeeping such as validity bitmaps.
+// Parallel reads and appends add the counts and phase times of every worker,
+// so phase times may exceed ns_total.
+struct GeoArrowGEOSCounters {
+  // Features read or appended, including nulls
+  int64_t n_features;
+  // Coordinates copied into or out of GEOS coordinate sequences
+  int64_t n_coords;
+  // GEOS geometries created by a reader, including parts and rings (but only
+  // features when parsing with GEOARROW_GEOS_PARSER_GEOS)
+  int64_t n_geos_objects;
+  // Reallocations of a reader's scratch space or a builder's output buffers
+  int64_t n_scratch_reallocs;
+  // Reallocations of the temporary coordinate buffer
+  int64_t n_coords_reallocs;
+  // Size of the buffers of the arrays produced by a builder
+  int64_t bytes_produced;
+  // Time spent in read or append calls
+  int64_t ns_total;
+  // Time spent parsing WKB or WKT (reader)
+  int64_t ns_parse;
+  // Time spent copying coordinates between Arrow buffers and GEOS
+  int64_t ns_coords;
+  // Time spent growing buffers
+  int64_t ns_alloc;
+  // Time spent moving or concatenating output into finished arrays (builder)
+  int64_t ns_finish;
+};
+
+// Receives the start and end of spans of work done by a reader or builder: one
+// around each read or append call (index and size are the offset and number of
+// features) and, if a feature threshold was set, one around each feature
+// larger than the threshold (index is the feature's position in the array and
+// size its number of coordinates, or bytes for WKB and WKT input). Parallel
+// calls invoke the callbacks from several threads. Spans are only emitted if
+// the library was built with GEOARROW_GEOS_ENABLE_TRACING.
+struct GeoArrowGEOSTracer {
+  void (*span_begin)(struct GeoArrowGEOSTracer* tracer, const char* name,
+                     int64_t index, int64_t size);
+  void (*span_end)(struct GeoArrowGEOSTracer* tracer, const char* name, int64_t index,
+                   int64_t size);
+  void (*release)(struct GeoArrowGEOSTracer* tracer);
+  void* private_data;
+};
+
+// Initializes a tracer that writes spans to path as a Chrome trace event JSON
+// array (viewable with chrome://tracing or Perfetto). The file is complete once
+// the tracer is released.
+GeoArrowGEOSErrorCode GeoArrowGEOSTracerInitChrome(struct GeoArrowGEOSTracer* tracer,
+                                                   const char* path);
+
+// The alignment requested for all memory allocated using a GeoArrowGEOSAllocator
+#define GEOARROW_GEOS_ALIGNMENT 64
+
+// Provides the memory for a reader's or builder's scratch space and for the
+// buffers of the arrays a builder produces. allocate() returns NULL on failure;
+// deallocate() receives the size and alignment that ptr was allocated with. The
+// allocator is not owned by readers or builders: it must outlive them and every
+// array they produced, and must be thread-safe if used by parallel reads or
+// appends (which allocate from worker threads).
+struct GeoArrowGEOSAllocator {
+  void* (*allocate)(struct GeoArrowGEOSAllocator* allocator, int64_t size,
+                    int64_t alignment);
+  void (*deallocate)(struct GeoArrowGEOSAllocator* allocator, void* ptr, int64_t size,
+                     int64_t alignment);
+  void* private_data;
+};
+
 const char* GeoArrowGEOSVersionGEOS(void);
 
 const char* GeoArrowGEOSVersionGeoArrow(void);
@@ -78,6 +194,14 @@ GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderCreate(
     GEOSContextHandle_t handle, struct ArrowSchema* schema,
     struct GeoArrowGEOSArrayBuilder** out);
 
+// Like GeoArrowGEOSArrayBuilderCreate() but allocates coordinate scratch space
+// and output buffers using allocator (or malloc() if NULL). Output produced by
+// the geoarrow-c writers (e.g., WKT or XYM) is copied into buffers from the
+// allocator when a chunk is finished.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderCreateWithAllocator(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSAllocator* allocator, struct GeoArrowGEOSArrayBuilder** out);
+
 void GeoArrowGEOSArrayBuilderDestroy(struct GeoArrowGEOSArrayBuilder* builder);
 
 const char* GeoArrowGEOSArrayBuilderGetLastError(
@@ -87,24 +211,265 @@ GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppend(
     struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
     size_t* n_appended);
 
+// Like GeoArrowGEOSArrayBuilderAppend() but takes ownership of each geometry,
+// destroying it and setting geom[i] to NULL as soon as it has been written.
+// Geometries are destroyed with the builder's handle, which need not be the one
+// that created them. On error, the first n_appended geometries were appended
+// (and destroyed) and the rest remain owned by the caller. Combined with
+// GeoArrowGEOSArrayBuilderSetChunkSize() and GeoArrowGEOSArrayBuilderPopChunk(),
+// this avoids holding every feature as both a GEOSGeometry and Arrow output.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppendOwned(
+    struct GeoArrowGEOSArrayBuilder* builder, GEOSGeometry** geom, size_t geom_size,
+    size_t* n_appended);
+
+// Like GeoArrowGEOSArrayBuilderAppend() but splits geom into up to n_threads
+// contiguous shards and writes each with its own builder and GEOS context on its
+// own thread (a single shard is written on the calling thread). The shards are
+// kept in input order as chunks of this builder's output. The geometries must
+// not be modified while this call is running. On error, nothing is appended
+// (i.e., n_appended is 0).
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderAppendParallel(
+    struct GeoArrowGEOSArrayBuilder* builder, const GEOSGeometry** geom, size_t geom_size,
+    int n_threads, size_t* n_appended);
+
+// Controls whether the builder produces 32-bit (the default) or 64-bit
+// (large_binary, large_string, or large_list) offsets. With AUTO, 32-bit
+// offsets are used unless the appended features would overflow them.
+// Builders created from a schema with large types default to ALWAYS.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetLargeOffsets(
+    struct GeoArrowGEOSArrayBuilder* builder,
+    enum GeoArrowGEOSLargeOffsets large_offsets);
+
+// Sets the largest offset a chunk with 32-bit offsets may hold (INT32_MAX by
+// default), which is also the point past which AUTO switches to 64-bit offsets.
+// Mostly useful for testing large output without allocating gigabytes. Must be
+// called before any features are appended.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetMaxOffset(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t max_offset);
+
+// Populates out with the schema of the array the next call to
+// GeoArrowGEOSArrayBuilderFinish() will produce.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderGetSchema(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowSchema* out);
+
+// With GEOARROW_GEOS_ON_ERROR_NULL, geometries that can't be written to the
+// output type are appended as null instead of failing the call.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetOnError(
+    struct GeoArrowGEOSArrayBuilder* builder, enum GeoArrowGEOSOnError on_error);
+
+// Returns the number of features appended as null because of an error since the
+// last call to GeoArrowGEOSArrayBuilderFinish() and points indices (positions in
+// the output array) and messages to that many items. These remain valid until
+// the next call to Append() or Finish().
+int64_t GeoArrowGEOSArrayBuilderGetFeatureErrors(struct GeoArrowGEOSArrayBuilder* builder,
+                                                 const int64_t** indices,
+                                                 const char* const** messages);
+
+// Reserves exactly enough memory to append the geometries described by stats
+// (e.g., from GeoArrowGEOSSchemaCalculatorGetStats()) without reallocating.
+// This is a no-op for output written by geoarrow-c (WKT and XYM/XYZM native
+// output).
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderReserve(
+    struct GeoArrowGEOSArrayBuilder* builder, const struct GeoArrowGEOSSizeStats* stats);
+
+// WKB output is serialized directly from each GEOSGeometry. When verify is
+// non-zero, features are also written with geoarrow-c's visitor-based WKB writer
+// and GeoArrowGEOSArrayBuilderFinish() fails with EINVAL if the two differ by
+// even one byte. Must be set before the first feature is appended.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetVerifyWKB(
+    struct GeoArrowGEOSArrayBuilder* builder, int verify);
+
+// Native XY and XYZ output is written directly to buffers owned by the builder.
+// When direct is zero, it is written through geoarrow-c's visitor-based builder
+// instead (e.g., to benchmark one against the other). Returns EINVAL for other
+// output types. Must be set before the first feature is appended.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetDirect(
+    struct GeoArrowGEOSArrayBuilder* builder, int direct);
+
+// When n_dims is 2 or 3, also computes the bounds of each feature while its
+// coordinates are copied (0 disables). Must be set before the first feature is
+// appended.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, int n_dims);
+
+// Initializes out as struct<xmin, ymin, [zmin], xmax, ymax, [zmax]> of doubles,
+// the type of the output of GeoArrowGEOSArrayBuilderFinishBounds()
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderGetBoundsSchema(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowSchema* out);
+
+// Moves the bounds of the features appended since the last call into out (one
+// row per feature in output order, null for null features and inf/-inf for
+// empty ones) and, if total_bounds is not NULL, writes their combined bounds
+// to total_bounds (xmin, ymin, [zmin], xmax, ymax, [zmax]).
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinishBounds(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out,
+    double* total_bounds);
+
+// Seals the current chunk once it holds max_rows features or its buffers hold
+// at least max_bytes bytes (zero for no limit). Sealed chunks are queued until
+// they are popped with GeoArrowGEOSArrayBuilderPopChunk() or returned by
+// GeoArrowGEOSArrayBuilderFinish() or GeoArrowGEOSArrayBuilderFinishStream().
+// Memory for the next chunk is allocated based on the size of the last one.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetChunkSize(
+    struct GeoArrowGEOSArrayBuilder* builder, int64_t max_rows, int64_t max_bytes);
+
+// Moves the oldest sealed chunk into out or sets out->release to NULL if no
+// chunk is queued. Chunks always use 32-bit offsets. Indices of feature errors
+// remain relative to the first feature appended since the last Finish().
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderPopChunk(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out);
+
 GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinish(
     struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArray* out);
 
+// Like GeoArrowGEOSArrayBuilderFinish() but, instead of concatenating them, moves
+// the chunks written so far (e.g., one per shard of
+// GeoArrowGEOSArrayBuilderAppendParallel() or one per target chunk size) into
+// out without copying. Chunks always use 32-bit offsets.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderFinishStream(
+    struct GeoArrowGEOSArrayBuilder* builder, struct ArrowArrayStream* out);
+
+// Counters are plain integers updated by the thread using the builder, so they
+// can be read or reset between calls without synchronization.
+void GeoArrowGEOSArrayBuilderSetCollectTimings(struct GeoArrowGEOSArrayBuilder* builder,
+                                               int collect);
+
+void GeoArrowGEOSArrayBuilderGetCounters(struct GeoArrowGEOSArrayBuilder* builder,
+                                         struct GeoArrowGEOSCounters* out);
+
+void GeoArrowGEOSArrayBuilderResetCounters(struct GeoArrowGEOSArrayBuilder* builder);
+
+// Emits spans to tracer (which is not owned by the builder and must outlive it
+// or be unset with NULL) for appends and for geometries with more than
+// feature_threshold coordinates (0 to disable per-feature spans). Returns
+// ENOTSUP for a non-NULL tracer if the library was built without
+// GEOARROW_GEOS_ENABLE_TRACING.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayBuilderSetTracer(
+    struct GeoArrowGEOSArrayBuilder* builder, struct GeoArrowGEOSTracer* tracer,
+    int64_t feature_threshold);
+
 struct GeoArrowGEOSArrayReader;
 
+// In addition to the types supported by geoarrow-c, schema may be a
+// geoarrow.geometry (dense union) or geoarrow.geometrycollection (list of dense
+// union) whose union type ids are (dimensions - 1) * 10 + geometry type.
 GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderCreate(GEOSContextHandle_t handle,
                                                     struct ArrowSchema* schema,
                                                     struct GeoArrowGEOSArrayReader** out);
 
+// Like GeoArrowGEOSArrayReaderCreate() but allocates scratch space using
+// allocator (or malloc() if NULL)
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderCreateWithAllocator(
+    GEOSContextHandle_t handle, struct ArrowSchema* schema,
+    struct GeoArrowGEOSAllocator* allocator, struct GeoArrowGEOSArrayReader** out);
+
 const char* GeoArrowGEOSArrayReaderGetLastError(struct GeoArrowGEOSArrayReader* reader);
 
+// Chooses how WKB and WKT input is parsed: GeoArrow's readers (the default)
+// or GEOS' GEOSWKBReader/GEOSWKTReader.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetParser(
+    struct GeoArrowGEOSArrayReader* reader, enum GeoArrowGEOSParser parser);
+
+// Points with XY or XYZ coordinates are created directly from the coordinate
+// values. When direct is zero, each point's coordinates are copied into a
+// GEOSCoordSequence first as they are for other dimensions (e.g., to benchmark
+// one against the other).
+void GeoArrowGEOSArrayReaderSetDirectPoints(struct GeoArrowGEOSArrayReader* reader,
+                                            int direct);
+
+// With GEOARROW_GEOS_ON_ERROR_NULL, features that fail to parse or build are
+// returned as NULL instead of failing the read.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetOnError(
+    struct GeoArrowGEOSArrayReader* reader, enum GeoArrowGEOSOnError on_error);
+
+// Returns the number of features returned as NULL because of an error by the
+// last read and points indices (positions in out) and messages to that many
+// items. These remain valid until the next read.
+int64_t GeoArrowGEOSArrayReaderGetFeatureErrors(struct GeoArrowGEOSArrayReader* reader,
+                                                const int64_t** indices,
+                                                const char* const** messages);
+
 GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderRead(struct GeoArrowGEOSArrayReader* reader,
                                                   struct ArrowArray* array, size_t offset,
                                                   size_t length, GEOSGeometry** out,
                                                   size_t* n_out);
 
+// Reads the elements at the given indices of array into out (i.e., out[i] is
+// element indices[i]) in a single pass. Runs of consecutive indices are read
+// together.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderTake(struct GeoArrowGEOSArrayReader* reader,
+                                                  struct ArrowArray* array,
+                                                  const int64_t* indices,
+                                                  size_t n_indices, GEOSGeometry** out,
+                                                  size_t* n_out);
+
+// Like GeoArrowGEOSArrayReaderRead() but splits the range into up to n_threads
+// chunks of approximately equal coordinate (or byte) count and reads each on its
+// own thread using its own GEOS context. On error, no geometries are returned
+// (i.e., out is filled with NULL and n_out is 0).
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderReadParallel(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, int n_threads, GEOSGeometry** out, size_t* n_out);
+
+// Like GeoArrowGEOSArrayReaderRead() but only creates geometries whose envelope
+// intersects bbox (xmin, ymin, xmax, ymax); other elements of out are NULL. Bit
+// i of selection, which must hold at least length bits, is set if element i
+// was selected. For native arrays the envelope is computed from the coordinate
+// buffers before any geometry is created.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderReadBbox(
+    struct GeoArrowGEOSArrayReader* reader, struct ArrowArray* array, size_t offset,
+    size_t length, const double* bbox, GEOSGeometry** out, uint8_t* selection,
+    size_t* n_out);
+
+// Like the builder's counters, these can be read or reset between calls without
+// synchronization.
+void GeoArrowGEOSArrayReaderSetCollectTimings(struct GeoArrowGEOSArrayReader* reader,
+                                              int collect);
+
+void GeoArrowGEOSArrayReaderGetCounters(struct GeoArrowGEOSArrayReader* reader,
+                                        struct GeoArrowGEOSCounters* out);
+
+void GeoArrowGEOSArrayReaderResetCounters(struct GeoArrowGEOSArrayReader* reader);
+
+// Like GeoArrowGEOSArrayBuilderSetTracer(), where the size of a WKB or WKT
+// feature is its number of bytes.
+GeoArrowGEOSErrorCode GeoArrowGEOSArrayReaderSetTracer(
+    struct GeoArrowGEOSArrayReader* reader, struct GeoArrowGEOSTracer* tracer,
+    int64_t feature_threshold);
+
 void GeoArrowGEOSArrayReaderDestroy(struct GeoArrowGEOSArrayReader* reader);
 
+struct GeoArrowGEOSStreamReader;
+
+// Takes ownership of stream, whose schema must be one that
+// GeoArrowGEOSArrayReaderCreate() accepts. Chunks are pulled from the stream
+// only as needed and each is released as soon as it has been fully read.
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderCreate(
+    GEOSContextHandle_t handle, struct ArrowArrayStream* stream,
+    struct GeoArrowGEOSStreamReader** out);
+
+const char* GeoArrowGEOSStreamReaderGetLastError(
+    struct GeoArrowGEOSStreamReader* reader);
+
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderSetParser(
+    struct GeoArrowGEOSStreamReader* reader, enum GeoArrowGEOSParser parser);
+
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderSetOnError(
+    struct GeoArrowGEOSStreamReader* reader, enum GeoArrowGEOSOnError on_error);
+
+int64_t GeoArrowGEOSStreamReaderGetFeatureErrors(struct GeoArrowGEOSStreamReader* reader,
+                                                 const int64_t** indices,
+                                                 const char* const** messages);
+
+// Reads up to max_out geometries into out, continuing across chunk boundaries.
+// n_out is less than max_out only at the end of the stream (0 once the stream
+// is exhausted).
+GeoArrowGEOSErrorCode GeoArrowGEOSStreamReaderRead(
+    struct GeoArrowGEOSStreamReader* reader, GEOSGeometry** out, size_t max_out,
+    size_t* n_out);
+
+void GeoArrowGEOSStreamReaderDestroy(struct GeoArrowGEOSStreamReader* reader);
+
 struct GeoArrowGEOSSchemaCalculator;
 
 GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorCreate(
@@ -113,6 +478,49 @@ GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorCreate(
 void GeoArrowGEOSSchemaCalculatorIngest(struct GeoArrowGEOSSchemaCalculator* calc,
                                         const int32_t* wkb_type, size_t n);
 
+// When collect is non-zero, GeoArrowGEOSSchemaCalculatorIngestGeometry() also
+// totals the sizes reported by GeoArrowGEOSSchemaCalculatorGetStats().
+void GeoArrowGEOSSchemaCalculatorSetCollectStats(
+    struct GeoArrowGEOSSchemaCalculator* calc, int collect);
+
+// Ingests the type of each geometry (as GeoArrowGEOSWKBType() would) and,
+// if enabled, its sizes. A NULL geometry is a null feature.
+void GeoArrowGEOSSchemaCalculatorIngestGeometry(
+    struct GeoArrowGEOSSchemaCalculator* calc, GEOSContextHandle_t handle,
+    const GEOSGeometry** geom, size_t n);
+
+// Ingests the type of each feature of a WKB or WKT array (encoding is one of
+// the WKB or WKT encodings) without parsing it into a GEOSGeometry. Only WKB
+// headers and element counts or the WKT geometry tag, dimension tokens, and
+// first coordinate are read. As for GeoArrowGEOSWKBType(), features without
+// coordinates are ignored; unlike GEOS, M dimensions are detected. Features
+// that can't be scanned are ingested as GEOMETRY (i.e., the result is WKB).
+// The array is split into up to n_threads shards ingested in parallel.
+GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorIngestArray(
+    struct GeoArrowGEOSSchemaCalculator* calc, enum GeoArrowGEOSEncoding encoding,
+    const struct ArrowArray* array, int n_threads);
+
+void GeoArrowGEOSSchemaCalculatorGetStats(struct GeoArrowGEOSSchemaCalculator* calc,
+                                          struct GeoArrowGEOSSizeStats* out);
+
+// Adds the types and sizes ingested by other to calc such that finishing calc
+// gives the same result as if it had ingested both inputs
+void GeoArrowGEOSSchemaCalculatorMerge(struct GeoArrowGEOSSchemaCalculator* calc,
+                                       const struct GeoArrowGEOSSchemaCalculator* other);
+
+#define GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_SIZE 64
+
+// Writes the state of calc to out (GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_SIZE
+// bytes) in a platform-independent format so that it can be sent to another
+// process and merged with GeoArrowGEOSSchemaCalculatorMergeState().
+void GeoArrowGEOSSchemaCalculatorGetState(struct GeoArrowGEOSSchemaCalculator* calc,
+                                          uint8_t* out);
+
+// Like GeoArrowGEOSSchemaCalculatorMerge() for a state written by
+// GeoArrowGEOSSchemaCalculatorGetState(). Returns EINVAL if state is not valid.
+GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorMergeState(
+    struct GeoArrowGEOSSchemaCalculator* calc, const uint8_t* state, size_t size);
+
 GeoArrowGEOSErrorCode GeoArrowGEOSSchemaCalculatorFinish(
     struct GeoArrowGEOSSchemaCalculator* calc, enum GeoArrowGEOSEncoding encoding,
     struct ArrowSchema* out);
@@ -122,18 +530,37 @@ void GeoArrowGEOSSchemaCalculatorDestroy(struct GeoArrowGEOSSchemaCalculator* ca
 GeoArrowGEOSErrorCode GeoArrowGEOSMakeSchema(int32_t encoding, int32_t wkb_type,
                                              struct ArrowSchema* out);
 
+// Writes GeoArrowGEOSWKBType() of each of the n geometries to out. With
+// n_threads > 1, geom is split into up to n_threads contiguous shards that are
+// each handled on their own thread with their own GEOS context. The geometries
+// must not be modified while this call is running.
+GeoArrowGEOSErrorCode GeoArrowGEOSWKBTypes(GEOSContextHandle_t handle,
+                                           const GEOSGeometry** geom, size_t n,
+                                           int n_threads, int32_t* out);
+
+// Returns the geometry type of geom plus 2000 (XYZ), 3000 (XYM), or 4000
+// (XYZM), or 0 if geom is NULL or empty. M dimensions are only available from
+// GEOS 3.12.
 static inline int32_t GeoArrowGEOSWKBType(GEOSContextHandle_t handle,
                                           const GEOSGeometry* geom) {
-  if (geom == NULL || GEOSGetNumCoordinates_r(handle, geom) == 0) {
+  // GEOSisEmpty_r() stops at the first non-empty part rather than counting
+  // every coordinate
+  if (geom == NULL || GEOSisEmpty_r(handle, geom) == 1) {
     return 0;
   }
 
   int n_dim = GEOSGeom_getCoordinateDimension_r(handle, geom);
 
-  // Not sure how GEOS handles M in newer versions
   int32_t wkb_type;
-  if (n_dim == 3) {
+  if (n_dim == 4) {
+    wkb_type = 4000;
+  } else if (n_dim == 3) {
     wkb_type = 2000;
+#if GEOS_VERSION_MAJOR > 3 || (GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR >= 12)
+    if (GEOSHasM_r(handle, geom) == 1) {
+      wkb_type = 3000;
+    }
+#endif
   } else {
     wkb_type = 0;
   }
@@ -1,6 +1,13 @@
 
 #include <vector>
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define GEOARROW_GEOS_HAS_MEMORY_RESOURCE
+#endif
+#endif
+
 #include "geoarrow_geos.h"
 
 namespace geoarrow {
@@ -68,6 +75,76 @@ class GeometryVector {
   std::vector<GEOSGeometry*> data_;
 };
 
+#if defined(GEOARROW_GEOS_HAS_MEMORY_RESOURCE)
+// A GeoArrowGEOSAllocator backed by a std::pmr::memory_resource. Like the
+// resource, it must outlive the readers and builders that use it and the arrays
+// they produced (and can't be moved, since they point to it).
+class MemoryResourceAllocator {
+ public:
+  explicit MemoryResourceAllocator(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    allocator_.allocate = &Allocate;
+    allocator_.deallocate = &Deallocate;
+    allocator_.private_data = resource;
+  }
+
+  MemoryResourceAllocator(MemoryResourceAllocator& rhs) = delete;
+
+  GeoArrowGEOSAllocator* get() { return &allocator_; }
+
+  std::pmr::memory_resource* resource() {
+    return reinterpret_cast<std::pmr::memory_resource*>(allocator_.private_data);
+  }
+
+ private:
+  GeoArrowGEOSAllocator allocator_;
+
+  static void* Allocate(GeoArrowGEOSAllocator* allocator, int64_t size,
+                        int64_t alignment) {
+    auto resource = reinterpret_cast<std::pmr::memory_resource*>(allocator->private_data);
+    try {
+      return resource->allocate(static_cast<size_t>(size),
+                                static_cast<size_t>(alignment));
+    } catch (...) {
+      return nullptr;
+    }
+  }
+
+  static void Deallocate(GeoArrowGEOSAllocator* allocator, void* ptr, int64_t size,
+                         int64_t alignment) {
+    auto resource = reinterpret_cast<std::pmr::memory_resource*>(allocator->private_data);
+    resource->deallocate(ptr, static_cast<size_t>(size), static_cast<size_t>(alignment));
+  }
+};
+#endif
+
+class ChromeTracer {
+ public:
+  ChromeTracer() { tracer_.release = nullptr; }
+
+  ChromeTracer(ChromeTracer& rhs) = delete;
+
+  ~ChromeTracer() { reset(); }
+
+  GeoArrowGEOSErrorCode Init(const char* path) {
+    reset();
+    return GeoArrowGEOSTracerInitChrome(&tracer_, path);
+  }
+
+  GeoArrowGEOSTracer* get() { return &tracer_; }
+
+  // Writes the end of the trace and closes the file
+  void reset() {
+    if (tracer_.release != nullptr) {
+      tracer_.release(&tracer_);
+      tracer_.release = nullptr;
+    }
+  }
+
+ private:
+  GeoArrowGEOSTracer tracer_;
+};
+
 class ArrayBuilder {
  public:
   ArrayBuilder() : builder_(nullptr) {}
@@ -92,7 +169,8 @@ class ArrayBuilder {
 
   GeoArrowGEOSErrorCode InitFromEncoding(GEOSContextHandle_t handle,
                                          GeoArrowGEOSEncoding encoding,
-                                         int wkb_type = 0) {
+                                         int wkb_type = 0,
+                                         GeoArrowGEOSAllocator* allocator = nullptr) {
     ArrowSchema tmp_schema;
     tmp_schema.release = nullptr;
     int result = GeoArrowGEOSMakeSchema(encoding, wkb_type, &tmp_schema);
@@ -100,17 +178,64 @@ class ArrayBuilder {
       return result;
     }
 
-    result = InitFromSchema(handle, &tmp_schema);
+    result = InitFromSchema(handle, &tmp_schema, allocator);
     tmp_schema.release(&tmp_schema);
     return result;
   }
 
-  GeoArrowGEOSErrorCode InitFromSchema(GEOSContextHandle_t handle, ArrowSchema* schema) {
+  GeoArrowGEOSErrorCode InitFromSchema(GEOSContextHandle_t handle, ArrowSchema* schema,
+                                       GeoArrowGEOSAllocator* allocator = nullptr) {
     if (builder_ != nullptr) {
       GeoArrowGEOSArrayBuilderDestroy(builder_);
     }
 
-    return GeoArrowGEOSArrayBuilderCreate(handle, schema, &builder_);
+    return GeoArrowGEOSArrayBuilderCreateWithAllocator(handle, schema, allocator,
+                                                       &builder_);
+  }
+
+  GeoArrowGEOSErrorCode SetLargeOffsets(GeoArrowGEOSLargeOffsets large_offsets) {
+    return GeoArrowGEOSArrayBuilderSetLargeOffsets(builder_, large_offsets);
+  }
+
+  GeoArrowGEOSErrorCode SetMaxOffset(int64_t max_offset) {
+    return GeoArrowGEOSArrayBuilderSetMaxOffset(builder_, max_offset);
+  }
+
+  GeoArrowGEOSErrorCode GetSchema(struct ArrowSchema* out) {
+    return GeoArrowGEOSArrayBuilderGetSchema(builder_, out);
+  }
+
+  GeoArrowGEOSErrorCode SetOnError(GeoArrowGEOSOnError on_error) {
+    return GeoArrowGEOSArrayBuilderSetOnError(builder_, on_error);
+  }
+
+  int64_t GetFeatureErrors(const int64_t** indices, const char* const** messages) {
+    return GeoArrowGEOSArrayBuilderGetFeatureErrors(builder_, indices, messages);
+  }
+
+  GeoArrowGEOSErrorCode Reserve(const GeoArrowGEOSSizeStats& stats) {
+    return GeoArrowGEOSArrayBuilderReserve(builder_, &stats);
+  }
+
+  GeoArrowGEOSErrorCode SetVerifyWKB(bool verify) {
+    return GeoArrowGEOSArrayBuilderSetVerifyWKB(builder_, verify);
+  }
+
+  GeoArrowGEOSErrorCode SetDirect(bool direct) {
+    return GeoArrowGEOSArrayBuilderSetDirect(builder_, direct);
+  }
+
+  GeoArrowGEOSErrorCode SetBounds(int n_dims) {
+    return GeoArrowGEOSArrayBuilderSetBounds(builder_, n_dims);
+  }
+
+  GeoArrowGEOSErrorCode GetBoundsSchema(struct ArrowSchema* out) {
+    return GeoArrowGEOSArrayBuilderGetBoundsSchema(builder_, out);
+  }
+
+  GeoArrowGEOSErrorCode FinishBounds(struct ArrowArray* out,
+                                     double* total_bounds = nullptr) {
+    return GeoArrowGEOSArrayBuilderFinishBounds(builder_, out, total_bounds);
   }
 
   GeoArrowGEOSErrorCode Append(const GEOSGeometry** geom, size_t geom_size,
@@ -118,10 +243,54 @@ class ArrayBuilder {
     return GeoArrowGEOSArrayBuilderAppend(builder_, geom, geom_size, n_appended);
   }
 
+  // Destroys each geometry in geom as soon as it has been written (GEOS geometries
+  // may be destroyed with any handle). Afterwards the first n_appended entries of
+  // geom are nullptr and, on error, the entries that were not appended are still
+  // owned by geom.
+  GeoArrowGEOSErrorCode Append(GeometryVector&& geom, size_t* n_appended) {
+    return GeoArrowGEOSArrayBuilderAppendOwned(builder_, geom.mutable_data(), geom.size(),
+                                               n_appended);
+  }
+
+  GeoArrowGEOSErrorCode AppendParallel(const GEOSGeometry** geom, size_t geom_size,
+                                       int n_threads, size_t* n_appended) {
+    return GeoArrowGEOSArrayBuilderAppendParallel(builder_, geom, geom_size, n_threads,
+                                                  n_appended);
+  }
+
+  GeoArrowGEOSErrorCode SetChunkSize(int64_t max_rows, int64_t max_bytes = 0) {
+    return GeoArrowGEOSArrayBuilderSetChunkSize(builder_, max_rows, max_bytes);
+  }
+
+  GeoArrowGEOSErrorCode PopChunk(struct ArrowArray* out) {
+    return GeoArrowGEOSArrayBuilderPopChunk(builder_, out);
+  }
+
   GeoArrowGEOSErrorCode Finish(struct ArrowArray* out) {
     return GeoArrowGEOSArrayBuilderFinish(builder_, out);
   }
 
+  GeoArrowGEOSErrorCode FinishStream(struct ArrowArrayStream* out) {
+    return GeoArrowGEOSArrayBuilderFinishStream(builder_, out);
+  }
+
+  void SetCollectTimings(bool collect) {
+    GeoArrowGEOSArrayBuilderSetCollectTimings(builder_, collect);
+  }
+
+  GeoArrowGEOSCounters GetCounters() {
+    GeoArrowGEOSCounters counters;
+    GeoArrowGEOSArrayBuilderGetCounters(builder_, &counters);
+    return counters;
+  }
+
+  void ResetCounters() { GeoArrowGEOSArrayBuilderResetCounters(builder_); }
+
+  GeoArrowGEOSErrorCode SetTracer(GeoArrowGEOSTracer* tracer,
+                                  int64_t feature_threshold = 0) {
+    return GeoArrowGEOSArrayBuilderSetTracer(builder_, tracer, feature_threshold);
+  }
+
  private:
   GeoArrowGEOSArrayBuilder* builder_;
 };
@@ -150,7 +319,8 @@ class ArrayReader {
 
   GeoArrowGEOSErrorCode InitFromEncoding(GEOSContextHandle_t handle,
                                          GeoArrowGEOSEncoding encoding,
-                                         int wkb_type = 0) {
+                                         int wkb_type = 0,
+                                         GeoArrowGEOSAllocator* allocator = nullptr) {
     ArrowSchema tmp_schema;
     tmp_schema.release = nullptr;
     int result = GeoArrowGEOSMakeSchema(encoding, wkb_type, &tmp_schema);
@@ -158,17 +328,35 @@ class ArrayReader {
       return result;
     }
 
-    result = InitFromSchema(handle, &tmp_schema);
+    result = InitFromSchema(handle, &tmp_schema, allocator);
     tmp_schema.release(&tmp_schema);
     return result;
   }
 
-  GeoArrowGEOSErrorCode InitFromSchema(GEOSContextHandle_t handle, ArrowSchema* schema) {
+  GeoArrowGEOSErrorCode InitFromSchema(GEOSContextHandle_t handle, ArrowSchema* schema,
+                                       GeoArrowGEOSAllocator* allocator = nullptr) {
     if (reader_ != nullptr) {
       GeoArrowGEOSArrayReaderDestroy(reader_);
     }
 
-    return GeoArrowGEOSArrayReaderCreate(handle, schema, &reader_);
+    return GeoArrowGEOSArrayReaderCreateWithAllocator(handle, schema, allocator,
+                                                      &reader_);
+  }
+
+  GeoArrowGEOSErrorCode SetParser(GeoArrowGEOSParser parser) {
+    return GeoArrowGEOSArrayReaderSetParser(reader_, parser);
+  }
+
+  void SetDirectPoints(bool direct) {
+    GeoArrowGEOSArrayReaderSetDirectPoints(reader_, direct);
+  }
+
+  GeoArrowGEOSErrorCode SetOnError(GeoArrowGEOSOnError on_error) {
+    return GeoArrowGEOSArrayReaderSetOnError(reader_, on_error);
+  }
+
+  int64_t GetFeatureErrors(const int64_t** indices, const char* const** messages) {
+    return GeoArrowGEOSArrayReaderGetFeatureErrors(reader_, indices, messages);
   }
 
   GeoArrowGEOSErrorCode Read(ArrowArray* array, int64_t offset, int64_t length,
@@ -176,10 +364,96 @@ class ArrayReader {
     return GeoArrowGEOSArrayReaderRead(reader_, array, offset, length, out, n_out);
   }
 
+  GeoArrowGEOSErrorCode Take(ArrowArray* array, const int64_t* indices, size_t n_indices,
+                             GEOSGeometry** out, size_t* n_out) {
+    return GeoArrowGEOSArrayReaderTake(reader_, array, indices, n_indices, out, n_out);
+  }
+
+  GeoArrowGEOSErrorCode ReadParallel(ArrowArray* array, int64_t offset, int64_t length,
+                                     int n_threads, GEOSGeometry** out, size_t* n_out) {
+    return GeoArrowGEOSArrayReaderReadParallel(reader_, array, offset, length, n_threads,
+                                               out, n_out);
+  }
+
+  GeoArrowGEOSErrorCode ReadBbox(ArrowArray* array, int64_t offset, int64_t length,
+                                 const double* bbox, GEOSGeometry** out,
+                                 uint8_t* selection, size_t* n_out) {
+    return GeoArrowGEOSArrayReaderReadBbox(reader_, array, offset, length, bbox, out,
+                                           selection, n_out);
+  }
+
+  void SetCollectTimings(bool collect) {
+    GeoArrowGEOSArrayReaderSetCollectTimings(reader_, collect);
+  }
+
+  GeoArrowGEOSCounters GetCounters() {
+    GeoArrowGEOSCounters counters;
+    GeoArrowGEOSArrayReaderGetCounters(reader_, &counters);
+    return counters;
+  }
+
+  void ResetCounters() { GeoArrowGEOSArrayReaderResetCounters(reader_); }
+
+  GeoArrowGEOSErrorCode SetTracer(GeoArrowGEOSTracer* tracer,
+                                  int64_t feature_threshold = 0) {
+    return GeoArrowGEOSArrayReaderSetTracer(reader_, tracer, feature_threshold);
+  }
+
  private:
   GeoArrowGEOSArrayReader* reader_;
 };
 
+class StreamReader {
+ public:
+  StreamReader() : reader_(nullptr) {}
+
+  StreamReader(StreamReader&& rhs) : reader_(rhs.reader_) { rhs.reader_ = nullptr; }
+
+  StreamReader(StreamReader& rhs) = delete;
+
+  ~StreamReader() {
+    if (reader_ != nullptr) {
+      GeoArrowGEOSStreamReaderDestroy(reader_);
+    }
+  }
+
+  const char* GetLastError() {
+    if (reader_ == nullptr) {
+      return "";
+    } else {
+      return GeoArrowGEOSStreamReaderGetLastError(reader_);
+    }
+  }
+
+  GeoArrowGEOSErrorCode InitFromStream(GEOSContextHandle_t handle,
+                                       ArrowArrayStream* stream) {
+    if (reader_ != nullptr) {
+      GeoArrowGEOSStreamReaderDestroy(reader_);
+    }
+
+    return GeoArrowGEOSStreamReaderCreate(handle, stream, &reader_);
+  }
+
+  GeoArrowGEOSErrorCode SetParser(GeoArrowGEOSParser parser) {
+    return GeoArrowGEOSStreamReaderSetParser(reader_, parser);
+  }
+
+  GeoArrowGEOSErrorCode SetOnError(GeoArrowGEOSOnError on_error) {
+    return GeoArrowGEOSStreamReaderSetOnError(reader_, on_error);
+  }
+
+  int64_t GetFeatureErrors(const int64_t** indices, const char* const** messages) {
+    return GeoArrowGEOSStreamReaderGetFeatureErrors(reader_, indices, messages);
+  }
+
+  GeoArrowGEOSErrorCode Read(GEOSGeometry** out, size_t max_out, size_t* n_out) {
+    return GeoArrowGEOSStreamReaderRead(reader_, out, max_out, n_out);
+  }
+
+ private:
+  GeoArrowGEOSStreamReader* reader_;
+};
+
 class SchemaCalculator {
  public:
   SchemaCalculator() : calc_(nullptr) { GeoArrowGEOSSchemaCalculatorCreate(&calc_); }
@@ -198,6 +472,39 @@ class SchemaCalculator {
     GeoArrowGEOSSchemaCalculatorIngest(calc_, wkb_type, n);
   }
 
+  void SetCollectStats(bool collect) {
+    GeoArrowGEOSSchemaCalculatorSetCollectStats(calc_, collect);
+  }
+
+  void IngestGeometry(GEOSContextHandle_t handle, const GEOSGeometry** geom, size_t n) {
+    GeoArrowGEOSSchemaCalculatorIngestGeometry(calc_, handle, geom, n);
+  }
+
+  GeoArrowGEOSErrorCode IngestArray(enum GeoArrowGEOSEncoding encoding,
+                                    const ArrowArray* array, int n_threads = 1) {
+    return GeoArrowGEOSSchemaCalculatorIngestArray(calc_, encoding, array, n_threads);
+  }
+
+  GeoArrowGEOSSizeStats GetStats() {
+    GeoArrowGEOSSizeStats stats;
+    GeoArrowGEOSSchemaCalculatorGetStats(calc_, &stats);
+    return stats;
+  }
+
+  void Merge(const SchemaCalculator& other) {
+    GeoArrowGEOSSchemaCalculatorMerge(calc_, other.calc_);
+  }
+
+  std::vector<uint8_t> GetState() {
+    std::vector<uint8_t> state(GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_SIZE);
+    GeoArrowGEOSSchemaCalculatorGetState(calc_, state.data());
+    return state;
+  }
+
+  GeoArrowGEOSErrorCode MergeState(const std::vector<uint8_t>& state) {
+    return GeoArrowGEOSSchemaCalculatorMergeState(calc_, state.data(), state.size());
+  }
+
   GeoArrowGEOSErrorCode Finish(enum GeoArrowGEOSEncoding encoding, ArrowSchema* out) {
     return GeoArrowGEOSSchemaCalculatorFinish(calc_, encoding, out);
   }
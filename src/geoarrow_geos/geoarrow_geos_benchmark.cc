@@ -0,0 +1,681 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <geoarrow.h>
+
+#include "geoarrow_geos.hpp"
+
+// Benchmarks for the reader, builder, and schema calculator. Run with
+// --benchmark_out=<file>.json --benchmark_out_format=json to save results
+// that can be compared between runs with Google Benchmark's tools/compare.py.
+
+class GEOSCppHandle {
+ public:
+  GEOSContextHandle_t handle;
+
+  GEOSCppHandle() { handle = GEOS_init_r(); }
+
+  ~GEOSCppHandle() { GEOS_finish_r(handle); }
+};
+
+// Releases an ArrowArray when it goes out of scope
+class ArrayHolder {
+ public:
+  ArrowArray array;
+
+  ArrayHolder() { array.release = nullptr; }
+
+  ~ArrayHolder() { reset(); }
+
+  void reset() {
+    if (array.release != nullptr) {
+      array.release(&array);
+    }
+  }
+};
+
+// Parameters for synthetic data. Geometries are generated from a fixed seed so
+// that every run (and every encoding) sees exactly the same input.
+struct DataOptions {
+  int geometry_type;
+  int32_t wkb_type;
+  int64_t n_features;
+  int n_parts;
+  int n_rings;
+  int n_vertices;
+  double null_rate;
+  bool z;
+};
+
+static constexpr double kPi = 3.14159265358979323846;
+
+class DataGenerator {
+ public:
+  DataGenerator(GEOSContextHandle_t handle, const DataOptions& options)
+      : handle_(handle), options_(options), rng_(1234) {}
+
+  // Appends options.n_features geometries (or nulls) to out and returns the
+  // number of coordinates generated
+  int64_t Generate(geoarrow::geos::GeometryVector* out) {
+    out->resize(options_.n_features);
+    int64_t n_coords = 0;
+    for (int64_t i = 0; i < options_.n_features; i++) {
+      if (Uniform() < options_.null_rate) {
+        continue;
+      }
+
+      out->set(i, MakeGeometry(options_.geometry_type, &n_coords));
+    }
+
+    return n_coords;
+  }
+
+ private:
+  GEOSContextHandle_t handle_;
+  DataOptions options_;
+  std::mt19937_64 rng_;
+
+  // std::uniform_real_distribution isn't guaranteed to give the same values
+  // on every standard library
+  double Uniform() { return (rng_() >> 11) * (1.0 / 9007199254740992.0); }
+
+  GEOSCoordSequence* MakeSeq(int n_vertices, bool closed, double radius) {
+    GEOSCoordSequence* seq =
+        GEOSCoordSeq_create_r(handle_, n_vertices, options_.z ? 3 : 2);
+    double cx = Uniform() * 360 - 180;
+    double cy = Uniform() * 180 - 90;
+    int n_unique = closed ? n_vertices - 1 : n_vertices;
+    for (int i = 0; i < n_vertices; i++) {
+      int j = i % n_unique;
+      double angle = 2 * kPi * j / n_unique;
+      double r = radius * (0.5 + Uniform() / 2);
+      GEOSCoordSeq_setOrdinate_r(handle_, seq, i, 0, cx + r * std::cos(angle));
+      GEOSCoordSeq_setOrdinate_r(handle_, seq, i, 1, cy + r * std::sin(angle));
+      if (options_.z) {
+        GEOSCoordSeq_setOrdinate_r(handle_, seq, i, 2, Uniform() * 1000);
+      }
+    }
+
+    if (closed) {
+      for (unsigned int dim = 0; dim < (options_.z ? 3u : 2u); dim++) {
+        double value;
+        GEOSCoordSeq_getOrdinate_r(handle_, seq, 0, dim, &value);
+        GEOSCoordSeq_setOrdinate_r(handle_, seq, n_vertices - 1, dim, value);
+      }
+    }
+
+    return seq;
+  }
+
+  GEOSGeometry* MakeGeometry(int geometry_type, int64_t* n_coords) {
+    switch (geometry_type) {
+      case GEOS_POINT:
+        *n_coords += 1;
+        return GEOSGeom_createPoint_r(handle_, MakeSeq(1, false, 0));
+      case GEOS_LINESTRING:
+        *n_coords += options_.n_vertices;
+        return GEOSGeom_createLineString_r(handle_,
+                                           MakeSeq(options_.n_vertices, false, 1));
+      case GEOS_POLYGON: {
+        // n_vertices includes the closing vertex of each ring
+        int n_vertices = options_.n_vertices < 4 ? 4 : options_.n_vertices;
+        *n_coords += static_cast<int64_t>(n_vertices) * options_.n_rings;
+        GEOSGeometry* shell =
+            GEOSGeom_createLinearRing_r(handle_, MakeSeq(n_vertices, true, 1));
+        std::vector<GEOSGeometry*> holes;
+        for (int i = 1; i < options_.n_rings; i++) {
+          holes.push_back(
+              GEOSGeom_createLinearRing_r(handle_, MakeSeq(n_vertices, true, 0.1)));
+        }
+
+        return GEOSGeom_createPolygon_r(handle_, shell, holes.data(),
+                                        static_cast<unsigned int>(holes.size()));
+      }
+      case GEOS_MULTIPOINT:
+      case GEOS_MULTILINESTRING:
+      case GEOS_MULTIPOLYGON: {
+        int part_type = geometry_type == GEOS_MULTIPOINT        ? GEOS_POINT
+                        : geometry_type == GEOS_MULTILINESTRING ? GEOS_LINESTRING
+                                                                : GEOS_POLYGON;
+        std::vector<GEOSGeometry*> parts;
+        for (int i = 0; i < options_.n_parts; i++) {
+          parts.push_back(MakeGeometry(part_type, n_coords));
+        }
+
+        return GEOSGeom_createCollection_r(handle_, geometry_type, parts.data(),
+                                           static_cast<unsigned int>(parts.size()));
+      }
+      default:
+        return nullptr;
+    }
+  }
+};
+
+// Benchmark arguments are (geometry kind, encoding, z)
+enum GeometryKind { kPoint, kLinestring, kPolygon, kMultipolygon };
+
+DataOptions MakeDataOptions(int64_t kind, bool z) {
+  DataOptions options;
+  options.n_features = 10000;
+  options.n_parts = 1;
+  options.n_rings = 1;
+  options.n_vertices = 1;
+  options.null_rate = 0.01;
+  options.z = z;
+
+  switch (kind) {
+    case kPoint:
+      options.geometry_type = GEOS_POINT;
+      options.wkb_type = 1;
+      options.n_features = 100000;
+      break;
+    case kLinestring:
+      options.geometry_type = GEOS_LINESTRING;
+      options.wkb_type = 2;
+      options.n_vertices = 20;
+      break;
+    case kPolygon:
+      options.geometry_type = GEOS_POLYGON;
+      options.wkb_type = 3;
+      options.n_vertices = 20;
+      options.n_rings = 2;
+      break;
+    default:
+      options.geometry_type = GEOS_MULTIPOLYGON;
+      options.wkb_type = 6;
+      options.n_vertices = 10;
+      options.n_rings = 2;
+      options.n_parts = 3;
+      break;
+  }
+
+  return options;
+}
+
+// The generated geometries and their size, which is used to report
+// geometries/s, coordinates/s, and bytes/s (as the equivalent WKB size so that
+// rates are comparable across encodings)
+struct Data {
+  geoarrow::geos::GeometryVector geoms;
+  int32_t wkb_type;
+  int64_t n_coords;
+  int64_t wkb_size;
+
+  Data(GEOSContextHandle_t handle, const DataOptions& options) : geoms(handle) {
+    DataGenerator generator(handle, options);
+    n_coords = generator.Generate(&geoms);
+    wkb_type = options.wkb_type + (options.z ? 2000 : 0);
+
+    geoarrow::geos::SchemaCalculator calc;
+    calc.SetCollectStats(true);
+    calc.IngestGeometry(handle, geoms.data(), geoms.size());
+    wkb_size = calc.GetStats().wkb_size;
+  }
+
+  void SetCounters(benchmark::State& state) {
+    state.counters["geometries"] = benchmark::Counter(
+        static_cast<double>(geoms.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["coordinates"] = benchmark::Counter(
+        static_cast<double>(n_coords), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(state.iterations() * wkb_size);
+  }
+};
+
+// Builds data into out using builder, whose last error describes any failure
+static GeoArrowGEOSErrorCode BuildArray(geoarrow::geos::ArrayBuilder* builder,
+                                        GEOSContextHandle_t handle, Data* data,
+                                        GeoArrowGEOSEncoding encoding, ArrowArray* out,
+                                        GeoArrowGEOSOnError on_error =
+                                            GEOARROW_GEOS_ON_ERROR_FAIL) {
+  GeoArrowGEOSErrorCode result =
+      builder->InitFromEncoding(handle, encoding, data->wkb_type);
+  if (result != GEOARROW_GEOS_OK) {
+    return result;
+  }
+
+  result = builder->SetOnError(on_error);
+  if (result != GEOARROW_GEOS_OK) {
+    return result;
+  }
+
+  size_t n = 0;
+  result = builder->Append(data->geoms.data(), data->geoms.size(), &n);
+  if (result != GEOARROW_GEOS_OK) {
+    return result;
+  }
+
+  return builder->Finish(out);
+}
+
+// Arguments are (geometry kind, encoding, z, on_error): the data are all valid,
+// so GEOARROW_GEOS_ON_ERROR_NULL should cost the same as the default
+static void BenchmarkArrayBuilder(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(state.range(0), state.range(2)));
+  auto encoding = static_cast<GeoArrowGEOSEncoding>(state.range(1));
+  auto on_error = static_cast<GeoArrowGEOSOnError>(state.range(3));
+
+  for (auto _ : state) {
+    geoarrow::geos::ArrayBuilder builder;
+    ArrayHolder array;
+    if (BuildArray(&builder, handle.handle, &data, encoding, &array.array, on_error) !=
+        GEOARROW_GEOS_OK) {
+      state.SkipWithError(builder.GetLastError());
+      break;
+    }
+
+    benchmark::DoNotOptimize(array.array.length);
+  }
+
+  data.SetCounters(state);
+}
+
+// Arguments are (geometry kind, encoding, z, direct): native output is written
+// directly to the builder's buffers or through geoarrow-c's visitor-based
+// builder (the path used for all native output before the direct writer)
+static void BenchmarkArrayBuilderDirect(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(state.range(0), state.range(2)));
+  auto encoding = static_cast<GeoArrowGEOSEncoding>(state.range(1));
+  bool direct = state.range(3);
+
+  for (auto _ : state) {
+    geoarrow::geos::ArrayBuilder builder;
+    size_t n = 0;
+    ArrayHolder array;
+    if (builder.InitFromEncoding(handle.handle, encoding, data.wkb_type) !=
+            GEOARROW_GEOS_OK ||
+        builder.SetDirect(direct) != GEOARROW_GEOS_OK ||
+        builder.Append(data.geoms.data(), data.geoms.size(), &n) != GEOARROW_GEOS_OK ||
+        builder.Finish(&array.array) != GEOARROW_GEOS_OK) {
+      state.SkipWithError(builder.GetLastError());
+      break;
+    }
+
+    benchmark::DoNotOptimize(array.array.length);
+  }
+
+  data.SetCounters(state);
+}
+
+static void BenchmarkArrayBuilderParallel(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(kPolygon, false));
+  int n_threads = static_cast<int>(state.range(0));
+
+  for (auto _ : state) {
+    geoarrow::geos::ArrayBuilder builder;
+    size_t n = 0;
+    ArrayHolder array;
+    if (builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKB) !=
+            GEOARROW_GEOS_OK ||
+        builder.AppendParallel(data.geoms.data(), data.geoms.size(), n_threads, &n) !=
+            GEOARROW_GEOS_OK ||
+        builder.Finish(&array.array) != GEOARROW_GEOS_OK) {
+      state.SkipWithError(builder.GetLastError());
+      break;
+    }
+
+    benchmark::DoNotOptimize(array.array.length);
+  }
+
+  data.SetCounters(state);
+}
+
+// The last argument selects the parser for WKB and WKT input
+static void BenchmarkArrayReader(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(state.range(0), state.range(2)));
+  auto encoding = static_cast<GeoArrowGEOSEncoding>(state.range(1));
+  auto parser = static_cast<GeoArrowGEOSParser>(state.range(3));
+
+  geoarrow::geos::ArrayBuilder builder;
+  ArrayHolder array;
+  if (BuildArray(&builder, handle.handle, &data, encoding, &array.array) !=
+      GEOARROW_GEOS_OK) {
+    state.SkipWithError(builder.GetLastError());
+    return;
+  }
+
+  geoarrow::geos::ArrayReader reader;
+  if (reader.InitFromEncoding(handle.handle, encoding, data.wkb_type) !=
+          GEOARROW_GEOS_OK ||
+      reader.SetParser(parser) != GEOARROW_GEOS_OK) {
+    state.SkipWithError(reader.GetLastError());
+    return;
+  }
+
+  geoarrow::geos::GeometryVector out(handle.handle);
+  for (auto _ : state) {
+    out.resize(array.array.length);
+    size_t n_out = 0;
+    if (reader.Read(&array.array, 0, array.array.length, out.mutable_data(), &n_out) !=
+        GEOARROW_GEOS_OK) {
+      state.SkipWithError(reader.GetLastError());
+      break;
+    }
+
+    // Don't include destroying the output
+    state.PauseTiming();
+    out.resize(0);
+    state.ResumeTiming();
+  }
+
+  data.SetCounters(state);
+}
+
+// Arguments are (encoding, z, direct): points are created straight from the
+// coordinate values or from a GEOSCoordSequence per point (the path used for
+// all points before points were created directly)
+static void BenchmarkArrayReaderDirectPoints(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(kPoint, state.range(1)));
+  auto encoding = static_cast<GeoArrowGEOSEncoding>(state.range(0));
+  bool direct = state.range(2);
+
+  geoarrow::geos::ArrayBuilder builder;
+  ArrayHolder array;
+  if (BuildArray(&builder, handle.handle, &data, encoding, &array.array) !=
+      GEOARROW_GEOS_OK) {
+    state.SkipWithError(builder.GetLastError());
+    return;
+  }
+
+  geoarrow::geos::ArrayReader reader;
+  if (reader.InitFromEncoding(handle.handle, encoding, data.wkb_type) !=
+      GEOARROW_GEOS_OK) {
+    state.SkipWithError(reader.GetLastError());
+    return;
+  }
+
+  reader.SetDirectPoints(direct);
+
+  geoarrow::geos::GeometryVector out(handle.handle);
+  for (auto _ : state) {
+    out.resize(array.array.length);
+    size_t n_out = 0;
+    if (reader.Read(&array.array, 0, array.array.length, out.mutable_data(), &n_out) !=
+        GEOARROW_GEOS_OK) {
+      state.SkipWithError(reader.GetLastError());
+      break;
+    }
+
+    state.PauseTiming();
+    out.resize(0);
+    state.ResumeTiming();
+  }
+
+  data.SetCounters(state);
+}
+
+// GeoArrowGEOSSchemaCalculatorIngest() as it was before it was reimplemented
+// with bitsets (copied unchanged from geoarrow_geos.c), kept here as a baseline
+struct LegacySchemaCalculator {
+  int geometry_type;
+  int dimensions;
+};
+
+static int LegacyGeometryType2(int x, int y) {
+  switch (x) {
+    case -1:
+      return y;
+    case GEOARROW_GEOMETRY_TYPE_GEOMETRY:
+      return x;
+    case GEOARROW_GEOMETRY_TYPE_POINT:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_POINT:
+        case GEOARROW_TYPE_MULTIPOINT:
+          return y;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_LINESTRING:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_LINESTRING:
+        case GEOARROW_TYPE_MULTILINESTRING:
+          return y;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_POLYGON:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_POLYGON:
+        case GEOARROW_TYPE_MULTIPOLYGON:
+          return y;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOINT:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_POINT:
+        case GEOARROW_TYPE_MULTIPOINT:
+          return x;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_MULTILINESTRING:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_LINESTRING:
+        case GEOARROW_TYPE_MULTILINESTRING:
+          return x;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_MULTIPOLYGON:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_TYPE_POLYGON:
+        case GEOARROW_TYPE_MULTIPOLYGON:
+          return x;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION:
+      switch (y) {
+        case -1:
+          return x;
+        case GEOARROW_GEOMETRY_TYPE_GEOMETRYCOLLECTION:
+          return x;
+        default:
+          return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+      }
+    default:
+      return GEOARROW_GEOMETRY_TYPE_GEOMETRY;
+  }
+}
+
+static int LegacyDimensions2(int x, int y) {
+  switch (x) {
+    case GEOARROW_DIMENSIONS_UNKNOWN:
+      return y;
+    case GEOARROW_DIMENSIONS_XY:
+      switch (y) {
+        case GEOARROW_DIMENSIONS_UNKNOWN:
+          return x;
+        default:
+          return y;
+      }
+    case GEOARROW_DIMENSIONS_XYZ:
+      switch (y) {
+        case GEOARROW_DIMENSIONS_UNKNOWN:
+          return x;
+        case GEOARROW_DIMENSIONS_XYM:
+          return GEOARROW_DIMENSIONS_XYZM;
+        default:
+          return y;
+      }
+    case GEOARROW_DIMENSIONS_XYM:
+      switch (y) {
+        case GEOARROW_DIMENSIONS_UNKNOWN:
+          return x;
+        case GEOARROW_DIMENSIONS_XYZ:
+          return GEOARROW_DIMENSIONS_XYZM;
+        default:
+          return y;
+      }
+    default:
+      return GEOARROW_DIMENSIONS_XYZM;
+  }
+}
+
+static void LegacySchemaCalculatorIngest(struct LegacySchemaCalculator* calc,
+                                         const int32_t* wkb_type, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (wkb_type[i] == 0) {
+      continue;
+    }
+
+    calc->geometry_type = LegacyGeometryType2(calc->geometry_type, wkb_type[i] % 1000);
+    calc->dimensions = LegacyDimensions2(calc->dimensions, wkb_type[i] / 1000);
+  }
+}
+
+// Arguments are (mixed, legacy): mixed input has a few features of another
+// type near the end
+static std::vector<int32_t> MakeWKBTypes(bool mixed) {
+  std::vector<int32_t> wkb_type(1000000, 3);
+  for (size_t i = 0; i < wkb_type.size(); i += 97) {
+    wkb_type[i] = 0;
+  }
+
+  if (mixed) {
+    wkb_type[wkb_type.size() - 10] = 2006;
+    wkb_type[wkb_type.size() - 5] = 1;
+  }
+
+  return wkb_type;
+}
+
+static void BenchmarkSchemaCalculatorIngest(benchmark::State& state) {
+  std::vector<int32_t> wkb_type = MakeWKBTypes(state.range(0));
+  bool legacy = state.range(1);
+
+  for (auto _ : state) {
+    if (legacy) {
+      LegacySchemaCalculator calc = {-1, GEOARROW_DIMENSIONS_UNKNOWN};
+      LegacySchemaCalculatorIngest(&calc, wkb_type.data(), wkb_type.size());
+      benchmark::DoNotOptimize(calc);
+    } else {
+      geoarrow::geos::SchemaCalculator calc;
+      calc.Ingest(wkb_type.data(), wkb_type.size());
+      benchmark::DoNotOptimize(calc);
+    }
+  }
+
+  state.counters["geometries"] =
+      benchmark::Counter(static_cast<double>(wkb_type.size()),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Arguments are (geometry kind, n_threads)
+static void BenchmarkWKBTypes(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(state.range(0), false));
+  int n_threads = static_cast<int>(state.range(1));
+
+  std::vector<int32_t> wkb_type(data.geoms.size());
+  for (auto _ : state) {
+    GeoArrowGEOSWKBTypes(handle.handle, data.geoms.data(), data.geoms.size(), n_threads,
+                         wkb_type.data());
+    benchmark::DoNotOptimize(wkb_type.data());
+  }
+
+  data.SetCounters(state);
+}
+
+// Arguments are (geometry kind, encoding, n_threads)
+static void BenchmarkSchemaCalculatorIngestArray(benchmark::State& state) {
+  GEOSCppHandle handle;
+  Data data(handle.handle, MakeDataOptions(state.range(0), false));
+  auto encoding = static_cast<GeoArrowGEOSEncoding>(state.range(1));
+  int n_threads = static_cast<int>(state.range(2));
+
+  geoarrow::geos::ArrayBuilder builder;
+  ArrayHolder array;
+  if (BuildArray(&builder, handle.handle, &data, encoding, &array.array) !=
+      GEOARROW_GEOS_OK) {
+    state.SkipWithError(builder.GetLastError());
+    return;
+  }
+
+  for (auto _ : state) {
+    geoarrow::geos::SchemaCalculator calc;
+    calc.IngestArray(encoding, &array.array, n_threads);
+    benchmark::DoNotOptimize(calc);
+  }
+
+  data.SetCounters(state);
+}
+
+static const std::vector<int64_t> kKinds = {kPoint, kLinestring, kPolygon,
+                                            kMultipolygon};
+
+static const std::vector<int64_t> kEncodings = {
+    GEOARROW_GEOS_ENCODING_WKT,        GEOARROW_GEOS_ENCODING_WKB,
+    GEOARROW_GEOS_ENCODING_GEOARROW,   GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED,
+    GEOARROW_GEOS_ENCODING_LARGE_WKT,  GEOARROW_GEOS_ENCODING_LARGE_WKB};
+
+BENCHMARK(BenchmarkArrayBuilder)
+    ->ArgsProduct({kKinds,
+                   kEncodings,
+                   {0, 1},
+                   {GEOARROW_GEOS_ON_ERROR_FAIL, GEOARROW_GEOS_ON_ERROR_NULL}})
+    ->ArgNames({"kind", "encoding", "z", "on_error"});
+
+BENCHMARK(BenchmarkArrayBuilderDirect)
+    ->ArgsProduct({kKinds,
+                   {GEOARROW_GEOS_ENCODING_GEOARROW,
+                    GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED},
+                   {0, 1},
+                   {0, 1}})
+    ->ArgNames({"kind", "encoding", "z", "direct"});
+
+BENCHMARK(BenchmarkArrayBuilderParallel)->ArgsProduct({{1, 2, 4, 8}})->UseRealTime();
+
+BENCHMARK(BenchmarkArrayReader)
+    ->ArgsProduct({kKinds, kEncodings, {0, 1}, {GEOARROW_GEOS_PARSER_GEOARROW}})
+    ->ArgsProduct({kKinds,
+                   {GEOARROW_GEOS_ENCODING_WKT, GEOARROW_GEOS_ENCODING_WKB},
+                   {0},
+                   {GEOARROW_GEOS_PARSER_GEOS}})
+    ->ArgNames({"kind", "encoding", "z", "parser"});
+
+BENCHMARK(BenchmarkArrayReaderDirectPoints)
+    ->ArgsProduct({{GEOARROW_GEOS_ENCODING_GEOARROW,
+                    GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED},
+                   {0, 1},
+                   {0, 1}})
+    ->ArgNames({"encoding", "z", "direct"});
+
+BENCHMARK(BenchmarkSchemaCalculatorIngest)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ArgNames({"mixed", "legacy"});
+
+BENCHMARK(BenchmarkWKBTypes)
+    ->ArgsProduct({kKinds, {1, 4}})
+    ->ArgNames({"kind", "threads"})
+    ->UseRealTime();
+
+BENCHMARK(BenchmarkSchemaCalculatorIngestArray)
+    ->ArgsProduct(
+        {kKinds, {GEOARROW_GEOS_ENCODING_WKT, GEOARROW_GEOS_ENCODING_WKB}, {1, 4}})
+    ->ArgNames({"kind", "encoding", "threads"})
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
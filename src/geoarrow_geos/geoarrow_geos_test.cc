@@ -1,4 +1,13 @@
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
 #include <gtest/gtest.h>
 
 #include <nanoarrow/nanoarrow.hpp>
@@ -333,228 +342,2317 @@ TEST_P(EncodingTestFixture, TestArrayReaderMultipolygon) {
       1006, encoding);
 }
 
-INSTANTIATE_TEST_SUITE_P(GeoArrowGEOSTest, EncodingTestFixture,
-                         ::testing::Values(GEOARROW_GEOS_ENCODING_GEOARROW,
-                                           GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED,
-                                           GEOARROW_GEOS_ENCODING_WKB,
-                                           GEOARROW_GEOS_ENCODING_WKT));
+TEST_P(EncodingTestFixture, TestArrayReaderZWithOffset) {
+  GeoArrowGEOSEncoding encoding = GetParam();
 
-TEST(GeoArrowGEOSTest, TestHppGeometryVector) {
   GEOSCppHandle handle;
-  geoarrow::geos::GeometryVector geom(handle.handle);
+  GEOSCppWKTReader wkt_reader(handle.handle);
 
-  geom.reserve(3);
-  geom.resize(3);
-  ASSERT_EQ(geom.size(), 3);
-  ASSERT_EQ(geom.borrow(0), nullptr);
-  ASSERT_EQ(geom.borrow(1), nullptr);
-  ASSERT_EQ(geom.borrow(2), nullptr);
+  for (const auto& wkt : std::vector<std::vector<std::string>>{
+           {"POINT Z (0 1 2)", "POINT Z (3 4 5)", "", "POINT Z (6 7 8)"},
+           {"LINESTRING Z (0 1 2, 3 4 5)", "LINESTRING Z (6 7 8, 9 10 11)", "",
+            "LINESTRING Z (12 13 14, 15 16 17)"}}) {
+    int wkb_type = wkt[0].substr(0, 5) == "POINT" ? 1001 : 1002;
 
-  geom.set(0, GEOSGeom_createEmptyPolygon_r(handle.handle));
-  geom.set(1, GEOSGeom_createEmptyLineString_r(handle.handle));
-  geom.set(2, GEOSGeom_createEmptyPoint_r(handle.handle));
+    geoarrow::geos::GeometryVector geoms_in(handle.handle);
+    geoms_in.resize(wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
 
-  geom.resize(2);
-  geom.resize(3);
-  ASSERT_NE(geom.borrow(0), nullptr);
-  ASSERT_NE(geom.borrow(1), nullptr);
-  ASSERT_EQ(geom.borrow(2), nullptr);
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, wkb_type),
+              GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+    geoarrow::geos::ArrayReader reader;
+    ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, wkb_type),
+              GEOARROW_GEOS_OK);
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(3);
+    size_t n_out = 0;
+    ASSERT_EQ(reader.Read(array.get(), 1, 3, geoms_out.mutable_data(), &n_out),
+              GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    ASSERT_EQ(n_out, 3);
+    EXPECT_EQ(geoms_out.borrow(1), nullptr);
+
+    for (size_t i : {0, 2}) {
+      const GEOSGeometry* expected = geoms_in.borrow(i + 1);
+      const GEOSGeometry* actual = geoms_out.borrow(i);
+      ASSERT_NE(actual, nullptr);
+      EXPECT_EQ(GEOSEqualsExact_r(handle.handle, actual, expected, 0), 1);
+
+      const GEOSCoordSequence* seq_expected =
+          GEOSGeom_getCoordSeq_r(handle.handle, expected);
+      const GEOSCoordSequence* seq_actual = GEOSGeom_getCoordSeq_r(handle.handle, actual);
+      double z_expected = 0;
+      double z_actual = 0;
+      ASSERT_EQ(GEOSCoordSeq_getZ_r(handle.handle, seq_expected, 0, &z_expected), 1);
+      ASSERT_EQ(GEOSCoordSeq_getZ_r(handle.handle, seq_actual, 0, &z_actual), 1);
+      EXPECT_EQ(z_actual, z_expected) << wkt[i + 1];
+    }
+  }
+}
 
-  GEOSGeometry* geom1 = geom.take_ownership_of(1);
-  ASSERT_NE(geom1, nullptr);
-  GEOSGeom_destroy_r(handle.handle, geom1);
-  ASSERT_EQ(geom.borrow(1), nullptr);
+TEST_P(EncodingTestFixture, TestArrayReaderDirectPoints) {
+  GeoArrowGEOSEncoding encoding = GetParam();
 
-  geoarrow::geos::GeometryVector other = std::move(geom);
-  ASSERT_EQ(geom.size(), 0);
-  ASSERT_EQ(other.size(), 3);
-  ASSERT_NE(other.borrow(0), nullptr);
-  ASSERT_EQ(other.borrow(1), nullptr);
-  ASSERT_EQ(other.borrow(2), nullptr);
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  // Points created from coordinate values and from a GEOSCoordSequence match
+  for (const auto& wkt : std::vector<std::vector<std::string>>{
+           {"POINT (0 1)", "POINT EMPTY", "", "POINT (2 3)"},
+           {"POINT Z (0 1 2)", "POINT Z EMPTY", "", "POINT Z (3 4 5)"},
+           {"MULTIPOINT ((0 1), (2 3))", "", "MULTIPOINT EMPTY", "MULTIPOINT ((4 5))"},
+           {"MULTIPOINT Z ((0 1 2), (3 4 5))", "", "MULTIPOINT Z ((6 7 8))"}}) {
+    int wkb_type = wkt[0].substr(0, 5) == "POINT" ? 1 : 4;
+    if (wkt[0].find(" Z ") != std::string::npos) {
+      wkb_type += 1000;
+    }
+
+    geoarrow::geos::GeometryVector geoms_in(handle.handle);
+    geoms_in.resize(wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
+
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, wkb_type),
+              GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+    geoarrow::geos::GeometryVector geoms_out[2] = {
+        geoarrow::geos::GeometryVector(handle.handle),
+        geoarrow::geos::GeometryVector(handle.handle)};
+    for (int direct : {0, 1}) {
+      geoarrow::geos::ArrayReader reader;
+      ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, wkb_type),
+                GEOARROW_GEOS_OK);
+      reader.SetDirectPoints(direct);
+      geoms_out[direct].resize(array->length - 1);
+      size_t n_out = 0;
+      ASSERT_EQ(reader.Read(array.get(), 1, array->length - 1,
+                            geoms_out[direct].mutable_data(), &n_out),
+                GEOARROW_GEOS_OK)
+          << reader.GetLastError();
+      ASSERT_EQ(n_out, wkt.size() - 1);
+    }
+
+    for (size_t i = 0; i < wkt.size() - 1; i++) {
+      const GEOSGeometry* expected = geoms_out[0].borrow(i);
+      const GEOSGeometry* actual = geoms_out[1].borrow(i);
+      if (expected == nullptr || actual == nullptr) {
+        EXPECT_EQ(actual, expected) << wkt[i + 1];
+        continue;
+      }
+
+      EXPECT_EQ(GEOSisEmpty_r(handle.handle, actual),
+                GEOSisEmpty_r(handle.handle, expected))
+          << wkt[i + 1];
+      EXPECT_EQ(GEOSGeom_getCoordinateDimension_r(handle.handle, actual),
+                GEOSGeom_getCoordinateDimension_r(handle.handle, expected))
+          << wkt[i + 1];
+      if (!GEOSisEmpty_r(handle.handle, expected)) {
+        EXPECT_EQ(GEOSEqualsExact_r(handle.handle, actual, expected, 0), 1)
+            << wkt[i + 1];
+      }
+    }
+  }
 }
 
-TEST(GeoArrowGEOSTest, TestHppArrayBuilder) {
+TEST_P(EncodingTestFixture, TestArrayReaderParallel) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
   GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
   geoarrow::geos::ArrayBuilder builder;
-  EXPECT_STREQ(builder.GetLastError(), "");
+  geoarrow::geos::ArrayReader reader;
 
-  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_UNKNOWN),
-            EINVAL);
-  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
-            GEOARROW_GEOS_OK);
-  EXPECT_STREQ(builder.GetLastError(), "");
+  std::vector<std::string> wkt = {
+      "POLYGON ((30 10, 40 40, 20 40, 10 20, 30 10))",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))",
+      "POLYGON EMPTY", ""};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size() * 25);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i % wkt.size()], geoms_in.mutable_data() + i),
+              GEOARROW_GEOS_OK);
+  }
 
-  geoarrow::geos::ArrayBuilder builder2 = std::move(builder);
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
   nanoarrow::UniqueArray array;
-  builder2.Finish(array.get());
-  ASSERT_EQ(array->length, 0);
-  ASSERT_EQ(array->n_buffers, 3);
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+
+  for (int n_threads : {1, 2, 3, 8}) {
+    for (int64_t offset : {0, 5}) {
+      int64_t length = array->length - offset;
+      geoarrow::geos::GeometryVector geoms_out(handle.handle);
+      geoms_out.resize(length);
+
+      size_t n_out = 0;
+      ASSERT_EQ(reader.ReadParallel(array.get(), offset, length, n_threads,
+                                    geoms_out.mutable_data(), &n_out),
+                GEOARROW_GEOS_OK)
+          << reader.GetLastError();
+      ASSERT_EQ(n_out, length);
+
+      for (int64_t i = 0; i < length; i++) {
+        const GEOSGeometry* expected = geoms_in.borrow(offset + i);
+        if (expected == nullptr || geoms_out.borrow(i) == nullptr) {
+          EXPECT_EQ(geoms_out.borrow(i), expected);
+        } else {
+          EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected, 0), 1)
+              << "n_threads = " << n_threads << " at index " << (offset + i);
+        }
+      }
+    }
+  }
 }
 
-TEST(GeoArrowGEOSTest, TestHppArrayReader) {
+TEST_P(EncodingTestFixture, TestArrayBuilderParallel) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
   GEOSCppHandle handle;
-  geoarrow::geos::ArrayReader reader;
-  EXPECT_STREQ(reader.GetLastError(), "");
+  GEOSCppWKTReader wkt_reader(handle.handle);
 
-  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_UNKNOWN),
-            EINVAL);
-  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
-            GEOARROW_GEOS_OK);
-  EXPECT_STREQ(reader.GetLastError(), "");
+  std::vector<std::string> wkt = {
+      "POLYGON ((30 10, 40 40, 20 40, 10 20, 30 10))",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))",
+      "POLYGON EMPTY", ""};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size() * 25);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i % wkt.size()], geoms_in.mutable_data() + i),
+              GEOARROW_GEOS_OK);
+  }
 
-  geoarrow::geos::ArrayReader reader2 = std::move(reader);
-}
+  for (int n_threads : {1, 2, 3, 8}) {
+    // Serial appends before and after the parallel append keep their position
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), 5, &n), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.AppendParallel(geoms_in.data() + 5, geoms_in.size() - 10,
+                                     n_threads, &n),
+              GEOARROW_GEOS_OK)
+        << builder.GetLastError();
+    ASSERT_EQ(n, geoms_in.size() - 10);
+    ASSERT_EQ(builder.Append(geoms_in.data() + geoms_in.size() - 5, 5, &n),
+              GEOARROW_GEOS_OK);
+
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK) << builder.GetLastError();
+    ASSERT_EQ(array->length, static_cast<int64_t>(geoms_in.size()));
+
+    geoarrow::geos::ArrayReader reader;
+    ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(geoms_in.size());
+    size_t n_out = 0;
+    ASSERT_EQ(reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(),
+                          &n_out),
+              GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+
+    for (size_t i = 0; i < geoms_in.size(); i++) {
+      const GEOSGeometry* expected = geoms_in.borrow(i);
+      if (expected == nullptr || geoms_out.borrow(i) == nullptr) {
+        EXPECT_EQ(geoms_out.borrow(i), expected);
+      } else {
+        EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected, 0), 1)
+            << "n_threads = " << n_threads << " at index " << i;
+      }
+    }
 
-GeoArrowGEOSErrorCode SchemaFromWkbType(const std::vector<int32_t>& wkb_type,
-                                        enum GeoArrowGEOSEncoding encoding,
-                                        ArrowSchema* out) {
-  geoarrow::geos::SchemaCalculator calc;
-  calc.Ingest(wkb_type.data(), wkb_type.size());
+    // The same shards as a stream of chunks
+    ASSERT_EQ(builder.AppendParallel(geoms_in.data(), geoms_in.size(), n_threads, &n),
+              GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArrayStream stream;
+    ASSERT_EQ(builder.FinishStream(stream.get()), GEOARROW_GEOS_OK);
+
+    int64_t n_chunks = 0;
+    int64_t total_length = 0;
+    while (true) {
+      nanoarrow::UniqueArray chunk;
+      ASSERT_EQ(stream->get_next(stream.get(), chunk.get()), GEOARROW_GEOS_OK);
+      if (chunk->release == nullptr) {
+        break;
+      }
+
+      n_chunks++;
+      total_length += chunk->length;
+    }
 
-  return calc.Finish(encoding, out);
+    EXPECT_EQ(n_chunks, n_threads);
+    EXPECT_EQ(total_length, static_cast<int64_t>(geoms_in.size()));
+  }
 }
 
-GeoArrowGEOSErrorCode SchemaFromWKT(const std::vector<std::string>& wkt,
-                                    enum GeoArrowGEOSEncoding encoding,
-                                    ArrowSchema* out) {
+TEST(GeoArrowGEOSTest, TestArrayBuilderParallelError) {
   GEOSCppHandle handle;
   GEOSCppWKTReader wkt_reader(handle.handle);
-  geoarrow::geos::GeometryVector geom(handle.handle);
-  geom.resize(wkt.size());
-  std::vector<int32_t> wkb_type(wkt.size());
 
+  std::vector<std::string> wkt = {"POINT (0 1)", "POINT (2 3)", "LINESTRING (0 1, 2 3)",
+                                  "POINT (4 5)"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
   for (size_t i = 0; i < wkt.size(); i++) {
-    if (wkt[i] == "") {
-      wkb_type[i] = 0;
-      continue;
-    }
-
-    wkt_reader.Read(wkt[i], geom.mutable_data() + i);
-    wkb_type[i] = GeoArrowGEOSWKBType(handle.handle, geom.borrow(i));
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
   }
 
-  return SchemaFromWkbType(wkb_type, encoding, out);
+  // On error nothing is appended, including when the shards are appended on one
+  // thread because n_threads is 1 or larger than the number of features
+  for (int n_threads : {1, 2, 8}) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_GEOARROW, 1),
+              GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), 2, &n), GEOARROW_GEOS_OK);
+    n = 1;
+    EXPECT_EQ(builder.AppendParallel(geoms_in.data() + 1, 3, n_threads, &n), EINVAL)
+        << "n_threads = " << n_threads;
+    EXPECT_EQ(n, 0);
+
+    ASSERT_EQ(builder.Append(geoms_in.data() + 3, 1, &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK) << builder.GetLastError();
+    EXPECT_EQ(array->length, 3);
+  }
 }
 
-std::string SchemaExtensionName(ArrowSchema* schema) {
-  ArrowStringView value;
-  value.data = "";
-  value.size_bytes = 0;
-  ArrowMetadataGetValue(schema->metadata, ArrowCharView("ARROW:extension:name"), &value);
-  return std::string(value.data, value.size_bytes);
-}
+TEST_P(EncodingTestFixture, TestArrayBuilderChunkSize) {
+  GeoArrowGEOSEncoding encoding = GetParam();
 
-std::string SchemaExtensionDims(ArrowSchema* schema) {
-  if (std::string(schema->format) == "+l") {
-    return SchemaExtensionDims(schema->children[0]);
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"POINT (0 1)", "", "POINT EMPTY", "POINT (2 3)"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(10);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i % wkt.size()], geoms_in.mutable_data() + i),
+              GEOARROW_GEOS_OK);
   }
 
-  std::stringstream ss;
-  for (int64_t i = 0; i < schema->n_children; i++) {
-    ss << schema->children[i]->name;
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 1), GEOARROW_GEOS_OK);
+  EXPECT_EQ(builder.SetChunkSize(-1), EINVAL);
+  ASSERT_EQ(builder.SetChunkSize(3), GEOARROW_GEOS_OK);
+
+  // Chunks can be consumed while features are still being appended
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), 5, &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray chunk;
+  ASSERT_EQ(builder.PopChunk(chunk.get()), GEOARROW_GEOS_OK);
+  ASSERT_NE(chunk->release, nullptr);
+  EXPECT_EQ(chunk->length, 3);
+  EXPECT_EQ(chunk->null_count, 1);
+  chunk.reset();
+  ASSERT_EQ(builder.PopChunk(chunk.get()), GEOARROW_GEOS_OK);
+  EXPECT_EQ(chunk->release, nullptr);
+
+  ASSERT_EQ(builder.Append(geoms_in.data() + 5, 5, &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArrayStream stream;
+  ASSERT_EQ(builder.FinishStream(stream.get()), GEOARROW_GEOS_OK);
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(stream->get_schema(stream.get(), schema.get()), GEOARROW_GEOS_OK);
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromSchema(handle.handle, schema.get()), GEOARROW_GEOS_OK);
+
+  std::vector<int64_t> lengths;
+  size_t offset = 3;
+  while (true) {
+    chunk.reset();
+    ASSERT_EQ(stream->get_next(stream.get(), chunk.get()), GEOARROW_GEOS_OK);
+    if (chunk->release == nullptr) {
+      break;
+    }
+
+    lengths.push_back(chunk->length);
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(chunk->length);
+    size_t n_out = 0;
+    ASSERT_EQ(reader.Read(chunk.get(), 0, chunk->length, geoms_out.mutable_data(),
+                          &n_out),
+              GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    for (int64_t i = 0; i < chunk->length; i++, offset++) {
+      const GEOSGeometry* expected = geoms_in.borrow(offset);
+      if (expected == nullptr || geoms_out.borrow(i) == nullptr) {
+        EXPECT_EQ(geoms_out.borrow(i), expected);
+      } else if (!GEOSisEmpty_r(handle.handle, expected)) {
+        EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected, 0), 1)
+            << "at index " << offset;
+      }
+    }
   }
 
-  return ss.str();
+  EXPECT_EQ(lengths, std::vector<int64_t>({3, 3, 1}));
+
+  // A byte limit smaller than any feature gives one feature per chunk
+  ASSERT_EQ(builder.SetChunkSize(0, 1), GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.Append(geoms_in.data(), 4, &n), GEOARROW_GEOS_OK);
+  for (int i = 0; i < 4; i++) {
+    chunk.reset();
+    ASSERT_EQ(builder.PopChunk(chunk.get()), GEOARROW_GEOS_OK);
+    ASSERT_NE(chunk->release, nullptr);
+    EXPECT_EQ(chunk->length, 1);
+  }
 }
 
-TEST(GeoArrowGEOSTest, TestSchemaCalcEmpty) {
+TEST_P(EncodingTestFixture, TestArrayBuilderBounds) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"LINESTRING (0 1, 2 3)", "", "LINESTRING EMPTY",
+                                  "LINESTRING (-1 5, 4 -2)"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i] != "") {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 2), GEOARROW_GEOS_OK);
+  EXPECT_EQ(builder.SetBounds(4), EINVAL);
+  ASSERT_EQ(builder.SetBounds(2), GEOARROW_GEOS_OK);
+
   nanoarrow::UniqueSchema schema;
-  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_UNKNOWN, schema.get()), EINVAL);
+  ASSERT_EQ(builder.GetBoundsSchema(schema.get()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(schema->n_children, 4);
+  EXPECT_STREQ(schema->children[0]->name, "xmin");
+  EXPECT_STREQ(schema->children[3]->name, "ymax");
 
-  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_WKT, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkt");
+  // Bounds computed by parallel shards are collected in order
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), 2, &n), GEOARROW_GEOS_OK);
+  EXPECT_EQ(builder.SetBounds(3), EINVAL);
+  ASSERT_EQ(builder.AppendParallel(geoms_in.data() + 2, 2, 2, &n), GEOARROW_GEOS_OK);
+
+  nanoarrow::UniqueArray bounds;
+  double total_bounds[4];
+  ASSERT_EQ(builder.FinishBounds(bounds.get(), total_bounds), GEOARROW_GEOS_OK);
+  ASSERT_EQ(bounds->length, 4);
+  EXPECT_EQ(bounds->null_count, 1);
+  ASSERT_EQ(bounds->n_children, 4);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<std::vector<double>> expected = {
+      {0, 1, 2, 3}, {inf, inf, -inf, -inf}, {inf, inf, -inf, -inf}, {-1, -2, 4, 5}};
+  for (int64_t i = 0; i < bounds->length; i++) {
+    if (i == 1) {
+      const uint8_t* validity = reinterpret_cast<const uint8_t*>(bounds->buffers[0]);
+      EXPECT_EQ(validity[0] & (1 << i), 0);
+      continue;
+    }
 
-  schema.reset();
-  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_WKB, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+    for (int j = 0; j < 4; j++) {
+      EXPECT_EQ(reinterpret_cast<const double*>(bounds->children[j]->buffers[1])[i],
+                expected[i][j])
+          << "feature " << i << " bound " << j;
+    }
+  }
 
-  schema.reset();
-  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+  EXPECT_EQ(std::vector<double>(total_bounds, total_bounds + 4),
+            std::vector<double>({-1, -2, 4, 5}));
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+  // The geometry output is unaffected
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+  EXPECT_EQ(array->length, 4);
 }
 
-TEST(GeoArrowGEOSTest, TestSchemaCalcZM) {
-  nanoarrow::UniqueSchema schema;
+// Compares the content of two arrays of the same type, whose offsets may be 32
+// or 64 bits wide (e.g., the same features built in one chunk and in several)
+void ExpectArrayViewsEqual(ArrowArrayView* actual, ArrowArrayView* expected) {
+  ASSERT_EQ(actual->length, expected->length);
+  EXPECT_EQ(actual->null_count, expected->null_count);
+  for (int64_t i = 0; i < actual->length; i++) {
+    EXPECT_EQ(ArrowArrayViewIsNull(actual, i), ArrowArrayViewIsNull(expected, i))
+        << "validity at index " << i;
+  }
 
-  ASSERT_EQ(SchemaFromWkbType({1, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+  switch (actual->storage_type) {
+    case NANOARROW_TYPE_LIST:
+    case NANOARROW_TYPE_LARGE_LIST:
+      for (int64_t i = 0; i <= actual->length; i++) {
+        EXPECT_EQ(ArrowArrayViewListChildOffset(actual, i),
+                  ArrowArrayViewListChildOffset(expected, i))
+            << "offset at index " << i;
+      }
+      break;
+    case NANOARROW_TYPE_BINARY:
+    case NANOARROW_TYPE_LARGE_BINARY:
+    case NANOARROW_TYPE_STRING:
+    case NANOARROW_TYPE_LARGE_STRING:
+      for (int64_t i = 0; i < actual->length; i++) {
+        ArrowBufferView actual_value = ArrowArrayViewGetBytesUnsafe(actual, i);
+        ArrowBufferView expected_value = ArrowArrayViewGetBytesUnsafe(expected, i);
+        ASSERT_EQ(actual_value.size_bytes, expected_value.size_bytes)
+            << "size at index " << i;
+        EXPECT_EQ(memcmp(actual_value.data.data, expected_value.data.data,
+                         actual_value.size_bytes),
+                  0)
+            << "value at index " << i;
+      }
+      break;
+    case NANOARROW_TYPE_DOUBLE:
+      for (int64_t i = 0; i < actual->length; i++) {
+        double actual_value = ArrowArrayViewGetDoubleUnsafe(actual, i);
+        double expected_value = ArrowArrayViewGetDoubleUnsafe(expected, i);
+        EXPECT_TRUE(actual_value == expected_value ||
+                    (std::isnan(actual_value) && std::isnan(expected_value)))
+            << "value at index " << i << ": " << actual_value
+            << " != " << expected_value;
+      }
+      break;
+    default:
+      break;
+  }
 
-  schema.reset();
-  ASSERT_EQ(SchemaFromWkbType({2001, 1}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+  ASSERT_EQ(actual->n_children, expected->n_children);
+  for (int64_t i = 0; i < actual->n_children; i++) {
+    ExpectArrayViewsEqual(actual->children[i], expected->children[i]);
+  }
+}
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({2001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+void ExpectArraysEqual(ArrowSchema* actual_schema, ArrowArray* actual,
+                       ArrowSchema* expected_schema, ArrowArray* expected) {
+  nanoarrow::UniqueArrayView actual_view;
+  nanoarrow::UniqueArrayView expected_view;
+  ArrowError error;
+  ASSERT_EQ(ArrowArrayViewInitFromSchema(actual_view.get(), actual_schema, &error),
+            NANOARROW_OK)
+      << error.message;
+  ASSERT_EQ(ArrowArrayViewInitFromSchema(expected_view.get(), expected_schema, &error),
+            NANOARROW_OK)
+      << error.message;
+  ASSERT_EQ(ArrowArrayViewSetArray(actual_view.get(), actual, &error), NANOARROW_OK)
+      << error.message;
+  ASSERT_EQ(ArrowArrayViewSetArray(expected_view.get(), expected, &error),
+            NANOARROW_OK)
+      << error.message;
+  ExpectArrayViewsEqual(actual_view.get(), expected_view.get());
+}
 
-  schema.reset();
-  ASSERT_EQ(SchemaFromWkbType({1, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+void ExpectArraysEqual(ArrowSchema* schema, ArrowArray* actual, ArrowArray* expected) {
+  ExpectArraysEqual(schema, actual, schema, expected);
+}
 
-  schema.reset();
-  ASSERT_EQ(SchemaFromWkbType({3001, 1}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-            NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+TEST_P(EncodingTestFixture, TestArrayBuilderDirect) {
+  GeoArrowGEOSEncoding encoding = GetParam();
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({3001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({3001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+  if (encoding != GEOARROW_GEOS_ENCODING_GEOARROW &&
+      encoding != GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding), GEOARROW_GEOS_OK);
+    EXPECT_EQ(builder.SetDirect(false), EINVAL);
+    return;
+  }
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({2001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+  // The direct writer and the visitor-based builder produce the same output
+  std::vector<std::pair<int32_t, std::vector<std::string>>> cases = {
+      {1, {"POINT (0 1)", "", "POINT (2 3)"}},
+      {1001, {"POINT Z (0 1 2)", "", "POINT Z (3 4 5)"}},
+      {2, {"LINESTRING (0 1, 2 3)", "", "LINESTRING EMPTY"}},
+      {3,
+       {"POLYGON ((0 0, 1 0, 0 1, 0 0), (0.1 0.1, 0.2 0.1, 0.1 0.2, 0.1 0.1))", "",
+        "POLYGON EMPTY"}},
+      {4, {"MULTIPOINT ((0 1), (2 3))", "", "MULTIPOINT EMPTY"}},
+      {1005, {"MULTILINESTRING Z ((0 1 2, 3 4 5), (6 7 8, 9 10 11))", ""}},
+      {6,
+       {"MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)), ((10 10, 11 10, 10 11, 10 10)))", "",
+        "MULTIPOLYGON EMPTY"}}};
+
+  for (const auto& item : cases) {
+    int32_t wkb_type = item.first;
+    const std::vector<std::string>& wkt = item.second;
+    geoarrow::geos::GeometryVector geoms_in(handle.handle);
+    geoms_in.resize(wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({3001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+    nanoarrow::UniqueArray arrays[2];
+    for (int direct : {0, 1}) {
+      geoarrow::geos::ArrayBuilder builder;
+      ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, wkb_type),
+                GEOARROW_GEOS_OK);
+      ASSERT_EQ(builder.SetDirect(direct), GEOARROW_GEOS_OK) << builder.GetLastError();
+      size_t n = 0;
+      ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK)
+          << builder.GetLastError();
+      EXPECT_EQ(builder.SetDirect(!direct), EINVAL);
+      ASSERT_EQ(builder.Finish(arrays[direct].get()), GEOARROW_GEOS_OK)
+          << builder.GetLastError();
+    }
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({2001, 4001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
-  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+    nanoarrow::UniqueSchema schema;
+    ASSERT_EQ(GeoArrowGEOSMakeSchema(encoding, wkb_type, schema.get()), GEOARROW_GEOS_OK);
+    SCOPED_TRACE("wkb_type = " + std::to_string(wkb_type));
+    ExpectArraysEqual(schema.get(), arrays[1].get(), arrays[0].get());
+  }
+}
 
-  schema.reset();
-  ASSERT_EQ(
-      SchemaFromWkbType({4001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
-      NANOARROW_OK);
-  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+TEST_P(EncodingTestFixture, TestCounters) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+  geoarrow::geos::ArrayBuilder builder;
+  geoarrow::geos::ArrayReader reader;
+
+  std::vector<std::string> wkt = {
+      "POLYGON ((30 10, 40 40, 20 40, 10 20, 30 10))",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))",
+      "POLYGON EMPTY", ""};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  builder.SetCollectTimings(true);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  GeoArrowGEOSCounters counters = builder.GetCounters();
+  EXPECT_EQ(counters.n_features, 4);
+  EXPECT_EQ(counters.n_coords, 14);
+  EXPECT_EQ(counters.n_geos_objects, 0);
+  EXPECT_GT(counters.bytes_produced, 0);
+  EXPECT_GT(counters.ns_total, 0);
+  EXPECT_LE(counters.ns_coords, counters.ns_total);
+
+  builder.ResetCounters();
+  counters = builder.GetCounters();
+  EXPECT_EQ(counters.n_features, 0);
+  EXPECT_EQ(counters.bytes_produced, 0);
+  EXPECT_EQ(counters.ns_total, 0);
+
+  // Without timings only counts are kept
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(wkt.size());
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK);
+
+  counters = reader.GetCounters();
+  EXPECT_EQ(counters.n_features, 4);
+  EXPECT_EQ(counters.n_coords, 14);
+  EXPECT_EQ(counters.n_geos_objects, 6);
+  EXPECT_EQ(counters.ns_total, 0);
+
+  reader.ResetCounters();
+  EXPECT_EQ(reader.GetCounters().n_features, 0);
+}
+
+// Records spans as "B name index size" / "E name index size"
+class RecordingTracer {
+ public:
+  RecordingTracer() {
+    tracer_.span_begin = &SpanBegin;
+    tracer_.span_end = &SpanEnd;
+    tracer_.release = nullptr;
+    tracer_.private_data = this;
+  }
+
+  GeoArrowGEOSTracer* get() { return &tracer_; }
+
+  std::vector<std::string> spans;
+
+ private:
+  GeoArrowGEOSTracer tracer_;
+
+  static void Record(GeoArrowGEOSTracer* tracer, const char* phase, const char* name,
+                     int64_t index, int64_t size) {
+    auto private_data = reinterpret_cast<RecordingTracer*>(tracer->private_data);
+    private_data->spans.push_back(std::string(phase) + " " + name + " " +
+                                  std::to_string(index) + " " + std::to_string(size));
+  }
+
+  static void SpanBegin(GeoArrowGEOSTracer* tracer, const char* name, int64_t index,
+                        int64_t size) {
+    Record(tracer, "B", name, index, size);
+  }
+
+  static void SpanEnd(GeoArrowGEOSTracer* tracer, const char* name, int64_t index,
+                      int64_t size) {
+    Record(tracer, "E", name, index, size);
+  }
+};
+
+TEST_P(EncodingTestFixture, TestTracer) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+  geoarrow::geos::ArrayBuilder builder;
+  geoarrow::geos::ArrayReader reader;
+  RecordingTracer tracer;
+
+  std::vector<std::string> wkt = {
+      "POLYGON ((30 10, 40 40, 20 40, 10 20, 30 10))", "",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  int result = builder.SetTracer(tracer.get(), 6);
+  if (result == ENOTSUP) {
+    GTEST_SKIP() << "built without GEOARROW_GEOS_ENABLE_TRACING";
+  }
+  ASSERT_EQ(result, GEOARROW_GEOS_OK);
+
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  // Only the second polygon has more than 6 coordinates
+  EXPECT_EQ(tracer.spans,
+            std::vector<std::string>({"B GeoArrowGEOSArrayBuilderAppend 0 3",
+                                      "B feature 2 9", "E feature 2 9",
+                                      "E GeoArrowGEOSArrayBuilderAppend 0 3"}));
+
+  // Without a threshold only the call is traced
+  tracer.spans.clear();
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  ASSERT_EQ(reader.SetTracer(tracer.get()), GEOARROW_GEOS_OK);
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(wkt.size());
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Read(array.get(), 1, 2, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(tracer.spans,
+            std::vector<std::string>({"B GeoArrowGEOSArrayReaderRead 1 2",
+                                      "E GeoArrowGEOSArrayReaderRead 1 2"}));
+
+  // With a threshold, features larger than it are read in their own span
+  // (whose size is in coordinates or, for WKB and WKT, bytes)
+  tracer.spans.clear();
+  ASSERT_EQ(reader.SetTracer(tracer.get(), 6), GEOARROW_GEOS_OK);
+  ASSERT_EQ(reader.Read(array.get(), 0, 3, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(n_out, 3);
+  if (encoding == GEOARROW_GEOS_ENCODING_GEOARROW ||
+      encoding == GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED) {
+    EXPECT_EQ(tracer.spans,
+              std::vector<std::string>({"B GeoArrowGEOSArrayReaderRead 0 3",
+                                        "B feature 2 9", "E feature 2 9",
+                                        "E GeoArrowGEOSArrayReaderRead 0 3"}));
+  } else {
+    ASSERT_EQ(tracer.spans.size(), 6);
+    EXPECT_EQ(tracer.spans[1].substr(0, 12), "B feature 0 ");
+    EXPECT_EQ(tracer.spans[3].substr(0, 12), "B feature 2 ");
+  }
+  for (size_t i = 0; i < geoms_out.size(); i++) {
+    EXPECT_EQ(geoms_out.data()[i] == nullptr, wkt[i].empty());
+  }
+
+  ASSERT_EQ(reader.SetTracer(nullptr), GEOARROW_GEOS_OK);
+}
+
+TEST(GeoArrowGEOSTest, TestChromeTracer) {
+  std::string path = ::testing::TempDir() + "geoarrow_geos_trace.json";
+  geoarrow::geos::ChromeTracer tracer;
+  ASSERT_EQ(tracer.Init(path.c_str()), GEOARROW_GEOS_OK);
+
+  GeoArrowGEOSTracer* t = tracer.get();
+  t->span_begin(t, "outer", 0, 10);
+  t->span_begin(t, "inner", 2, 3);
+  t->span_end(t, "inner", 2, 3);
+  t->span_end(t, "outer", 0, 10);
+  tracer.reset();
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::string json = contents.str();
+  std::remove(path.c_str());
+
+  ASSERT_GE(json.size(), 2);
+  EXPECT_EQ(json.front(), '[');
+  EXPECT_EQ(json.substr(json.size() - 2), "]\n");
+  EXPECT_NE(json.find(R"({"name":"outer","ph":"B","ts":)"), std::string::npos);
+  EXPECT_NE(json.find(R"("args":{"index":2,"size":3}})"), std::string::npos);
+
+  size_t n_events = 0;
+  for (size_t pos = json.find("\"ph\""); pos != std::string::npos;
+       pos = json.find("\"ph\"", pos + 1)) {
+    n_events++;
+  }
+  EXPECT_EQ(n_events, 4);
+}
+
+// Allocates aligned memory from malloc() and checks that every pointer is
+// deallocated once with the size and alignment it was allocated with
+class CountingAllocator {
+ public:
+  CountingAllocator() {
+    allocator_.allocate = &Allocate;
+    allocator_.deallocate = &Deallocate;
+    allocator_.private_data = this;
+  }
+
+  ~CountingAllocator() {
+    for (const auto& item : allocations_) {
+      std::free(item.second.raw);
+    }
+  }
+
+  GeoArrowGEOSAllocator* get() { return &allocator_; }
+
+  bool Owns(const void* ptr) { return allocations_.count(const_cast<void*>(ptr)) > 0; }
+
+  int64_t n_outstanding() { return static_cast<int64_t>(allocations_.size()); }
+
+  int64_t n_allocated = 0;
+  int64_t n_bad_deallocations = 0;
+
+ private:
+  struct Allocation {
+    void* raw;
+    int64_t size;
+    int64_t alignment;
+  };
+
+  GeoArrowGEOSAllocator allocator_;
+  std::unordered_map<void*, Allocation> allocations_;
+
+  static void* Allocate(GeoArrowGEOSAllocator* allocator, int64_t size,
+                        int64_t alignment) {
+    auto private_data = reinterpret_cast<CountingAllocator*>(allocator->private_data);
+    void* raw = std::malloc(size + alignment);
+    if (raw == nullptr) {
+      return nullptr;
+    }
+
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + alignment) &
+                        ~static_cast<uintptr_t>(alignment - 1);
+    void* ptr = reinterpret_cast<void*>(aligned);
+    private_data->allocations_[ptr] = {raw, size, alignment};
+    private_data->n_allocated++;
+    return ptr;
+  }
+
+  static void Deallocate(GeoArrowGEOSAllocator* allocator, void* ptr, int64_t size,
+                         int64_t alignment) {
+    auto private_data = reinterpret_cast<CountingAllocator*>(allocator->private_data);
+    auto item = private_data->allocations_.find(ptr);
+    if (item == private_data->allocations_.end() || item->second.size != size ||
+        item->second.alignment != alignment) {
+      private_data->n_bad_deallocations++;
+      return;
+    }
+
+    std::free(item->second.raw);
+    private_data->allocations_.erase(item);
+  }
+};
+
+// Checks that every buffer of array (and its children) came from allocator
+static void ExpectBuffersFromAllocator(CountingAllocator& allocator,
+                                       const ArrowArray* array) {
+  for (int64_t i = 0; i < array->n_buffers; i++) {
+    if (array->buffers[i] != nullptr) {
+      EXPECT_TRUE(allocator.Owns(array->buffers[i]));
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(array->buffers[i]) % GEOARROW_GEOS_ALIGNMENT,
+                0);
+    }
+  }
+
+  for (int64_t i = 0; i < array->n_children; i++) {
+    ExpectBuffersFromAllocator(allocator, array->children[i]);
+  }
+}
+
+TEST_P(EncodingTestFixture, TestAllocator) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+  CountingAllocator allocator;
+
+  std::vector<std::string> wkt = {
+      "POLYGON ((30 10, 40 40, 20 40, 10 20, 30 10))", "",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  nanoarrow::UniqueArray array;
+  {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3, allocator.get()),
+              GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+  }
+
+  // The array's buffers outlive the builder
+  ASSERT_EQ(array->length, 3);
+  ExpectBuffersFromAllocator(allocator, array.get());
+  EXPECT_GT(allocator.n_outstanding(), 0);
+
+  int64_t n_array_buffers = allocator.n_outstanding();
+  {
+    geoarrow::geos::ArrayReader reader;
+    ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3, allocator.get()),
+              GEOARROW_GEOS_OK);
+    int64_t n_allocated = allocator.n_allocated;
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(wkt.size());
+    size_t n_out = 0;
+    ASSERT_EQ(reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(),
+                          &n_out),
+              GEOARROW_GEOS_OK);
+    ASSERT_EQ(n_out, 3);
+    EXPECT_GT(allocator.n_allocated, n_allocated);
+
+    for (size_t i = 0; i < wkt.size(); i++) {
+      EXPECT_EQ(geoms_out.data()[i] == nullptr, wkt[i].empty());
+    }
+  }
+
+  // Destroying the reader returns its scratch space
+  EXPECT_EQ(allocator.n_outstanding(), n_array_buffers);
+
+  array.reset();
+  EXPECT_EQ(allocator.n_outstanding(), 0);
+  EXPECT_EQ(allocator.n_bad_deallocations, 0);
+}
+
+#if defined(GEOARROW_GEOS_HAS_MEMORY_RESOURCE)
+TEST(GeoArrowGEOSTest, TestHppMemoryResourceAllocator) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(1);
+  ASSERT_EQ(wkt_reader.Read("LINESTRING (0 1, 2 3)", geoms_in.mutable_data()),
+            GEOARROW_GEOS_OK);
+
+  std::pmr::unsynchronized_pool_resource resource;
+  geoarrow::geos::MemoryResourceAllocator allocator(&resource);
+  EXPECT_EQ(allocator.resource(), &resource);
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT, 0,
+                                     allocator.get()),
+            GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  ASSERT_EQ(array->length, 1);
+  const char* data = reinterpret_cast<const char*>(array->buffers[2]);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % GEOARROW_GEOS_ALIGNMENT, 0);
+  EXPECT_EQ(std::string(data, reinterpret_cast<const int32_t*>(array->buffers[1])[1]),
+            "LINESTRING (0 1, 2 3)");
+}
+#endif
+
+TEST_P(EncodingTestFixture, TestArrayReaderValidityRuns) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  // Null runs of varying length that cross 64-bit word boundaries
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(200);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    if ((i % 7) == 0 || (i >= 60 && i < 70) || (i >= 128 && i < 192)) {
+      continue;
+    }
+
+    std::string wkt = "POINT (" + std::to_string(i) + " 1)";
+    ASSERT_EQ(wkt_reader.Read(wkt, geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 1), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 1), GEOARROW_GEOS_OK);
+
+  for (int64_t offset : {0, 3, 63, 64}) {
+    int64_t length = array->length - offset;
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(length);
+    size_t n_out = 0;
+    ASSERT_EQ(reader.Read(array.get(), offset, length, geoms_out.mutable_data(), &n_out),
+              GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    ASSERT_EQ(n_out, length);
+
+    for (int64_t i = 0; i < length; i++) {
+      const GEOSGeometry* expected = geoms_in.borrow(offset + i);
+      if (expected == nullptr || geoms_out.borrow(i) == nullptr) {
+        EXPECT_EQ(geoms_out.borrow(i), expected) << "at index " << (offset + i);
+      } else {
+        EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected, 0), 1)
+            << "at index " << (offset + i);
+      }
+    }
+  }
+}
+
+TEST_P(EncodingTestFixture, TestArrayReaderTake) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"POLYGON ((0 0, 1 0, 0 1, 0 0))",
+                                  "",
+                                  "POLYGON EMPTY",
+                                  "POLYGON ((10 10, 11 10, 10 11, 10 10))",
+                                  "POLYGON ((20 20, 21 20, 20 21, 20 20))",
+                                  "POLYGON ((30 30, 31 30, 30 31, 30 30))"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 3), GEOARROW_GEOS_OK);
+
+  std::vector<int64_t> indices = {5, 0, 1, 2, 3, 3, 4, 0};
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(indices.size());
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Take(array.get(), indices.data(), indices.size(),
+                        geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  ASSERT_EQ(n_out, indices.size());
+
+  for (size_t i = 0; i < indices.size(); i++) {
+    const GEOSGeometry* expected = geoms_in.borrow(indices[i]);
+    if (expected == nullptr || geoms_out.borrow(i) == nullptr) {
+      EXPECT_EQ(geoms_out.borrow(i), expected) << "at index " << i;
+    } else {
+      EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected, 0), 1)
+          << "at index " << i;
+    }
+  }
+
+  indices = {0, 6};
+  geoms_out.resize(0);
+  geoms_out.resize(indices.size());
+  EXPECT_EQ(reader.Take(array.get(), indices.data(), indices.size(),
+                        geoms_out.mutable_data(), &n_out),
+            EINVAL);
+  EXPECT_STREQ(reader.GetLastError(), "[1] index 6 is out of range [0, 6)");
+}
+
+TEST_P(EncodingTestFixture, TestArrayReaderBbox) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"LINESTRING (0 0, 1 1)",
+                                  "LINESTRING (10 10, 11 11)",
+                                  "",
+                                  "LINESTRING EMPTY",
+                                  "LINESTRING (-5 0.5, 5 0.5)",
+                                  "LINESTRING (0 20, 20 20)",
+                                  "LINESTRING (0.5 -10, 0.5 -1)",
+                                  "LINESTRING (0.5 -10, 0.5 0, 0.5 10)"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 2), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, 2), GEOARROW_GEOS_OK);
+
+  double bbox[] = {0, 0, 2, 2};
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(wkt.size() - 1);
+  uint8_t selection = 0xff;
+  size_t n_out = 0;
+  ASSERT_EQ(reader.ReadBbox(array.get(), 1, wkt.size() - 1, bbox,
+                            geoms_out.mutable_data(), &selection, &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  ASSERT_EQ(n_out, wkt.size() - 1);
+
+  // Elements 4 (offset 1 + 3) and 7 (offset 1 + 6) intersect
+  EXPECT_EQ(selection, 0x48);
+  for (size_t i = 0; i < geoms_out.size(); i++) {
+    if (selection & (1 << i)) {
+      ASSERT_NE(geoms_out.borrow(i), nullptr);
+      EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i),
+                                  geoms_in.borrow(i + 1), 0),
+                1);
+    } else {
+      EXPECT_EQ(geoms_out.borrow(i), nullptr) << "at index " << (i + 1);
+    }
+  }
+}
+
+TEST_P(EncodingTestFixture, TestStreamReader) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  // Three chunks (one empty) read in windows that straddle chunk boundaries
+  std::vector<std::vector<std::string>> chunks = {
+      {"LINESTRING (0 1, 2 3)", "", "LINESTRING (4 5, 6 7)", "LINESTRING EMPTY"},
+      {},
+      {"LINESTRING (8 9, 10 11)", "", "LINESTRING (12 13, 14 15)"}};
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(GeoArrowGEOSMakeSchema(encoding, 2, schema.get()), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArrayStream stream;
+  ASSERT_EQ(ArrowBasicArrayStreamInit(stream.get(), schema.get(), chunks.size()),
+            NANOARROW_OK);
+
+  std::vector<std::string> wkt_all;
+  for (size_t i = 0; i < chunks.size(); i++) {
+    geoarrow::geos::GeometryVector geoms_in(handle.handle);
+    geoms_in.resize(chunks[i].size());
+    for (size_t j = 0; j < chunks[i].size(); j++) {
+      ASSERT_EQ(wkt_reader.Read(chunks[i][j], geoms_in.mutable_data() + j),
+                GEOARROW_GEOS_OK);
+      wkt_all.push_back(chunks[i][j]);
+    }
+
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 2), GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+    ArrowBasicArrayStreamSetArray(stream.get(), i, array.get());
+  }
+
+  geoarrow::geos::StreamReader reader;
+  ASSERT_EQ(reader.InitFromStream(handle.handle, stream.get()), GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  EXPECT_EQ(stream->release, nullptr);
+
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(3);
+  std::vector<size_t> n_outs;
+  size_t n_read = 0;
+  size_t n_out = 0;
+  do {
+    ASSERT_EQ(reader.Read(geoms_out.mutable_data(), geoms_out.size(), &n_out),
+              GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    n_outs.push_back(n_out);
+
+    for (size_t i = 0; i < n_out; i++) {
+      geoarrow::geos::GeometryVector expected(handle.handle);
+      expected.resize(1);
+      ASSERT_EQ(wkt_reader.Read(wkt_all[n_read + i], expected.mutable_data()),
+                GEOARROW_GEOS_OK);
+      if (expected.borrow(0) == nullptr || geoms_out.borrow(i) == nullptr) {
+        EXPECT_EQ(geoms_out.borrow(i), expected.borrow(0));
+      } else {
+        EXPECT_EQ(
+            GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), expected.borrow(0), 0),
+            1)
+            << "at index " << (n_read + i);
+      }
+    }
+
+    for (size_t i = 0; i < n_out; i++) {
+      geoms_out.set(i, nullptr);
+    }
+
+    n_read += n_out;
+  } while (n_out > 0);
+
+  EXPECT_EQ(n_read, wkt_all.size());
+  EXPECT_EQ(n_outs, std::vector<size_t>({3, 3, 1, 0}));
+}
+
+TEST(GeoArrowGEOSTest, TestArrayReaderParsers) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {
+      "POINT (0 1)",
+      "POINT EMPTY",
+      "POINT Z (0 1 2)",
+      "LINESTRING (0 1, 2 3)",
+      "LINESTRING EMPTY",
+      "POLYGON ((35 10, 45 45, 15 40, 10 20, 35 10), (20 30, 35 35, 30 20, 20 30))",
+      "MULTIPOINT ((10 40), (40 30), (20 20), (30 10))",
+      "MULTILINESTRING ((10 10, 20 20, 10 40), (40 40, 30 30, 40 20, 30 10))",
+      "MULTIPOLYGON (((30 20, 45 40, 10 40, 30 20)), ((15 5, 40 10, 10 20, 5 10, 15 5)))",
+      "GEOMETRYCOLLECTION (POINT (0 1), LINESTRING (0 1, 2 3))",
+      "GEOMETRYCOLLECTION EMPTY",
+      ""};
+
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  for (auto encoding : {GEOARROW_GEOS_ENCODING_WKB, GEOARROW_GEOS_ENCODING_WKT}) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding), GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+    for (auto parser : {GEOARROW_GEOS_PARSER_GEOARROW, GEOARROW_GEOS_PARSER_GEOS}) {
+      geoarrow::geos::ArrayReader reader;
+      ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding), GEOARROW_GEOS_OK);
+      ASSERT_EQ(reader.SetParser(parser), GEOARROW_GEOS_OK);
+
+      geoarrow::geos::GeometryVector geoms_out(handle.handle);
+      geoms_out.resize(wkt.size());
+      size_t n_out = 0;
+      ASSERT_EQ(
+          reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(), &n_out),
+          GEOARROW_GEOS_OK)
+          << reader.GetLastError();
+      ASSERT_EQ(n_out, wkt.size());
+
+      for (size_t i = 0; i < wkt.size(); i++) {
+        if (geoms_in.borrow(i) == nullptr || geoms_out.borrow(i) == nullptr) {
+          EXPECT_EQ(geoms_out.borrow(i), geoms_in.borrow(i));
+        } else {
+          EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i),
+                                      geoms_in.borrow(i), 0),
+                    1)
+              << "WKT: " << wkt[i] << " with parser " << parser;
+          EXPECT_EQ(GEOSGeom_getCoordinateDimension_r(handle.handle, geoms_out.borrow(i)),
+                    GEOSGeom_getCoordinateDimension_r(handle.handle, geoms_in.borrow(i)))
+              << "WKT: " << wkt[i] << " with parser " << parser;
+        }
+      }
+    }
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestArrayReaderParserError) {
+  GEOSCppHandle handle;
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(reader.SetParser(static_cast<GeoArrowGEOSParser>(100)), EINVAL);
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(GeoArrowGEOSMakeSchema(GEOARROW_GEOS_ENCODING_WKT, 0, schema.get()),
+            GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr), NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayStartAppending(array.get()), NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayAppendString(array.get(), ArrowCharView("POINT (0 1)")),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayAppendString(array.get(), ArrowCharView("POINT (0 1")),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayFinishBuildingDefault(array.get(), nullptr), NANOARROW_OK);
+
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(2);
+  size_t n_out = 0;
+  ASSERT_NE(reader.Read(array.get(), 0, 2, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(n_out, 1);
+  EXPECT_EQ(std::string(reader.GetLastError()).substr(0, 3), "[1]");
+}
+
+TEST(GeoArrowGEOSTest, TestArrayReaderOnErrorNull) {
+  GEOSCppHandle handle;
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(GeoArrowGEOSMakeSchema(GEOARROW_GEOS_ENCODING_WKT, 0, schema.get()),
+            GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr), NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayStartAppending(array.get()), NANOARROW_OK);
+  for (const char* wkt : {"POINT (0 1)", "POINT (0 1", "POINT (2 3)", "LINESTRING (0"}) {
+    ASSERT_EQ(ArrowArrayAppendString(array.get(), ArrowCharView(wkt)), NANOARROW_OK);
+  }
+  ASSERT_EQ(ArrowArrayFinishBuildingDefault(array.get(), nullptr), NANOARROW_OK);
+
+  for (auto parser : {GEOARROW_GEOS_PARSER_GEOARROW, GEOARROW_GEOS_PARSER_GEOS}) {
+    for (int n_threads : {1, 2}) {
+      geoarrow::geos::ArrayReader reader;
+      ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+                GEOARROW_GEOS_OK);
+      ASSERT_EQ(reader.SetParser(parser), GEOARROW_GEOS_OK);
+      ASSERT_EQ(reader.SetOnError(GEOARROW_GEOS_ON_ERROR_NULL), GEOARROW_GEOS_OK);
+
+      geoarrow::geos::GeometryVector geoms_out(handle.handle);
+      geoms_out.resize(3);
+      size_t n_out = 0;
+      ASSERT_EQ(reader.ReadParallel(array.get(), 1, 3, n_threads,
+                                    geoms_out.mutable_data(), &n_out),
+                GEOARROW_GEOS_OK)
+          << reader.GetLastError();
+      EXPECT_EQ(n_out, 3);
+      EXPECT_EQ(geoms_out.borrow(0), nullptr);
+      EXPECT_NE(geoms_out.borrow(1), nullptr);
+      EXPECT_EQ(geoms_out.borrow(2), nullptr);
+
+      const int64_t* indices = nullptr;
+      const char* const* messages = nullptr;
+      ASSERT_EQ(reader.GetFeatureErrors(&indices, &messages), 2);
+      EXPECT_EQ(indices[0], 0);
+      EXPECT_EQ(indices[1], 2);
+      EXPECT_NE(std::string(messages[0]), "");
+      EXPECT_NE(messages[0][0], '[');
+    }
+  }
+
+  // Without the option, the first failure fails the read
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(4);
+  size_t n_out = 0;
+  ASSERT_NE(reader.Read(array.get(), 0, 4, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(n_out, 1);
+  const int64_t* indices = nullptr;
+  const char* const* messages = nullptr;
+  EXPECT_EQ(reader.GetFeatureErrors(&indices, &messages), 0);
+
+  // A parallel read returns nothing on error, including when it reads on one
+  // thread because n_threads is 1 or larger than the number of features
+  for (int n_threads : {1, 8}) {
+    geoarrow::geos::GeometryVector geoms_parallel(handle.handle);
+    geoms_parallel.resize(4);
+    n_out = 0;
+    ASSERT_NE(reader.ReadParallel(array.get(), 0, 4, n_threads,
+                                  geoms_parallel.mutable_data(), &n_out),
+              GEOARROW_GEOS_OK);
+    EXPECT_EQ(n_out, 0);
+    for (size_t i = 0; i < geoms_parallel.size(); i++) {
+      EXPECT_EQ(geoms_parallel.borrow(i), nullptr) << "n_threads = " << n_threads;
+    }
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderOnErrorNull) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"POINT (0 1)", "LINESTRING (0 0, 1 1)", "",
+                                  "MULTIPOINT (2 3)", "POINT (4 5)"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  // Direct output is rolled back after a failed write; the visitor's output is
+  // checked before writing
+  for (bool direct : {true, false}) {
+    SCOPED_TRACE(direct ? "direct" : "visitor");
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(
+        builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_GEOARROW, 1),
+        GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetDirect(direct), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetOnError(GEOARROW_GEOS_ON_ERROR_NULL), GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK)
+        << builder.GetLastError();
+    EXPECT_EQ(n, wkt.size());
+
+    const int64_t* indices = nullptr;
+    const char* const* messages = nullptr;
+    ASSERT_EQ(builder.GetFeatureErrors(&indices, &messages), 2);
+    EXPECT_EQ(indices[0], 1);
+    EXPECT_EQ(indices[1], 3);
+    EXPECT_STREQ(messages[0],
+                 "Can't write geometry type 2 to an array of geometry type 1");
+
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+    EXPECT_EQ(array->length, wkt.size());
+    EXPECT_EQ(array->null_count, 3);
+    ASSERT_EQ(array->children[0]->length, wkt.size());
+    auto xs = reinterpret_cast<const double*>(array->children[0]->buffers[1]);
+    EXPECT_EQ(xs[0], 0);
+    EXPECT_EQ(xs[4], 4);
+    EXPECT_EQ(builder.GetFeatureErrors(&indices, &messages), 0);
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderAppendOwned) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  // GEOS geometries may be destroyed with any handle, so the vector and the
+  // builder need not share one
+  geoarrow::geos::ArrayBuilder builder;
+  GEOSCppHandle builder_handle;
+  ASSERT_EQ(builder.InitFromEncoding(builder_handle.handle,
+                                     GEOARROW_GEOS_ENCODING_GEOARROW, 1),
+            GEOARROW_GEOS_OK);
+
+  auto read_all = [&](const std::vector<std::string>& wkt,
+                      geoarrow::geos::GeometryVector* out) {
+    out->resize(wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      if (wkt[i] != "") {
+        ASSERT_EQ(wkt_reader.Read(wkt[i], out->mutable_data() + i), GEOARROW_GEOS_OK);
+      }
+    }
+  };
+
+  // Geometries are destroyed as they are written up to the first failure; the
+  // rest are destroyed with the vector (checked by the memcheck build)
+  geoarrow::geos::GeometryVector geoms_invalid(handle.handle);
+  read_all({"POINT (0 1)", "", "POINT (2 3)", "LINESTRING (0 1, 2 3)", "POINT (4 5)"},
+           &geoms_invalid);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(std::move(geoms_invalid), &n), EINVAL);
+  ASSERT_EQ(n, 3);
+
+  geoarrow::geos::GeometryVector geoms_valid(handle.handle);
+  read_all({"", "POINT (4 5)"}, &geoms_valid);
+  ASSERT_EQ(builder.Append(std::move(geoms_valid), &n), GEOARROW_GEOS_OK)
+      << builder.GetLastError();
+  EXPECT_EQ(n, 2);
+
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(array->length, 5);
+  EXPECT_EQ(array->null_count, 2);
+}
+
+// Neither the builder nor nanoarrow 0.3.0 can build union-based arrays, so
+// we assemble them by hand from raw buffers and (moved) child arrays
+struct TestArrayPrivate {
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<const void*> buffer_ptrs;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_ptrs;
+};
+
+static void ReleaseTestArray(ArrowArray* array) {
+  auto private_data = reinterpret_cast<TestArrayPrivate*>(array->private_data);
+  for (auto& child : private_data->children) {
+    if (child.release != nullptr) {
+      child.release(&child);
+    }
+  }
+
+  delete private_data;
+  array->release = nullptr;
+}
+
+template <typename T>
+std::vector<uint8_t> TestBuffer(const std::vector<T>& values) {
+  std::vector<uint8_t> out(values.size() * sizeof(T));
+  memcpy(out.data(), values.data(), out.size());
+  return out;
+}
+
+void MakeTestArray(ArrowArray* out, int64_t length, int64_t null_count,
+                   std::vector<std::vector<uint8_t>> buffers,
+                   std::vector<ArrowArray*> children) {
+  auto private_data = new TestArrayPrivate();
+  private_data->buffers = std::move(buffers);
+  for (const auto& buffer : private_data->buffers) {
+    private_data->buffer_ptrs.push_back(buffer.empty() ? nullptr : buffer.data());
+  }
+
+  private_data->children.resize(children.size());
+  for (size_t i = 0; i < children.size(); i++) {
+    ArrowArrayMove(children[i], &private_data->children[i]);
+    private_data->child_ptrs.push_back(&private_data->children[i]);
+  }
+
+  memset(out, 0, sizeof(ArrowArray));
+  out->length = length;
+  out->null_count = null_count;
+  out->n_buffers = private_data->buffer_ptrs.size();
+  out->buffers = private_data->buffer_ptrs.data();
+  out->n_children = private_data->child_ptrs.size();
+  out->children = private_data->child_ptrs.data();
+  out->private_data = private_data;
+  out->release = &ReleaseTestArray;
+}
+
+void MakeTestNativeArray(GEOSContextHandle_t handle, const std::vector<std::string>& wkt,
+                         int wkb_type, ArrowArray* out) {
+  GEOSCppWKTReader wkt_reader(handle);
+  geoarrow::geos::GeometryVector geoms(handle);
+  geoms.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle, GEOARROW_GEOS_ENCODING_GEOARROW, wkb_type),
+            GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms.data(), geoms.size(), &n), GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.Finish(out), GEOARROW_GEOS_OK);
+}
+
+void MakeTestUnionSchema(ArrowSchema* schema, const char* extension_name) {
+  ArrowSchemaInit(schema);
+  ASSERT_EQ(ArrowSchemaSetFormat(schema, "+ud:1,12"), NANOARROW_OK);
+  ASSERT_EQ(ArrowSchemaAllocateChildren(schema, 2), NANOARROW_OK);
+  ASSERT_EQ(
+      GeoArrowGEOSMakeSchema(GEOARROW_GEOS_ENCODING_GEOARROW, 1, schema->children[0]),
+      GEOARROW_GEOS_OK);
+  ASSERT_EQ(
+      GeoArrowGEOSMakeSchema(GEOARROW_GEOS_ENCODING_GEOARROW, 1002, schema->children[1]),
+      GEOARROW_GEOS_OK);
+
+  if (extension_name != nullptr) {
+    ArrowBuffer metadata;
+    ASSERT_EQ(ArrowMetadataBuilderInit(&metadata, nullptr), NANOARROW_OK);
+    ASSERT_EQ(ArrowMetadataBuilderAppend(&metadata, ArrowCharView("ARROW:extension:name"),
+                                         ArrowCharView(extension_name)),
+              NANOARROW_OK);
+    ASSERT_EQ(ArrowSchemaSetMetadata(schema, reinterpret_cast<char*>(metadata.data)),
+              NANOARROW_OK);
+    ArrowBufferReset(&metadata);
+  }
+}
+
+void MakeTestUnionArray(GEOSContextHandle_t handle, ArrowArray* out) {
+  nanoarrow::UniqueArray points;
+  MakeTestNativeArray(handle, {"POINT (0 1)", "", "POINT (2 3)"}, 1, points.get());
+  nanoarrow::UniqueArray linestrings;
+  MakeTestNativeArray(handle, {"LINESTRING Z (0 1 2, 3 4 5)", "LINESTRING Z EMPTY"}, 1002,
+                      linestrings.get());
+
+  std::vector<int8_t> type_ids = {1, 12, 1, 1, 12};
+  std::vector<int32_t> offsets = {0, 0, 1, 2, 1};
+  MakeTestArray(out, type_ids.size(), 0, {TestBuffer(type_ids), TestBuffer(offsets)},
+                {points.get(), linestrings.get()});
+}
+
+void ExpectGeometriesEqualWKT(GEOSContextHandle_t handle, GEOSGeometry** geoms,
+                              const std::vector<std::string>& wkt) {
+  GEOSCppWKTReader wkt_reader(handle);
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i].empty()) {
+      EXPECT_EQ(geoms[i], nullptr);
+      continue;
+    }
+
+    GEOSGeometry* expected = nullptr;
+    ASSERT_EQ(wkt_reader.Read(wkt[i], &expected), GEOARROW_GEOS_OK);
+    ASSERT_NE(geoms[i], nullptr) << "WKT: " << wkt[i];
+    EXPECT_EQ(GEOSEqualsExact_r(handle, geoms[i], expected, 0), 1) << "WKT: " << wkt[i];
+    EXPECT_EQ(GEOSGeom_getCoordinateDimension_r(handle, geoms[i]),
+              GEOSGeom_getCoordinateDimension_r(handle, expected))
+        << "WKT: " << wkt[i];
+    GEOSGeom_destroy_r(handle, expected);
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestArrayReaderGeometry) {
+  GEOSCppHandle handle;
+
+  nanoarrow::UniqueSchema schema;
+  MakeTestUnionSchema(schema.get(), "geoarrow.geometry");
+  nanoarrow::UniqueArray array;
+  MakeTestUnionArray(handle.handle, array.get());
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromSchema(handle.handle, schema.get()), GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(5);
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Read(array.get(), 0, 5, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  EXPECT_EQ(n_out, 5);
+  ExpectGeometriesEqualWKT(handle.handle, geoms_out.mutable_data(),
+                           {"POINT (0 1)", "LINESTRING Z (0 1 2, 3 4 5)", "",
+                            "POINT (2 3)", "LINESTRING Z EMPTY"});
+
+  // Check a slice and the parallel path
+  ASSERT_EQ(reader.Read(array.get(), 1, 3, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  EXPECT_EQ(n_out, 3);
+  ExpectGeometriesEqualWKT(handle.handle, geoms_out.mutable_data(),
+                           {"LINESTRING Z (0 1 2, 3 4 5)", "", "POINT (2 3)"});
+
+  ASSERT_EQ(reader.ReadParallel(array.get(), 0, 5, 2, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  EXPECT_EQ(n_out, 5);
+  ExpectGeometriesEqualWKT(handle.handle, geoms_out.mutable_data(),
+                           {"POINT (0 1)", "LINESTRING Z (0 1 2, 3 4 5)", "",
+                            "POINT (2 3)", "LINESTRING Z EMPTY"});
+}
+
+TEST(GeoArrowGEOSTest, TestArrayReaderGeometryCollection) {
+  GEOSCppHandle handle;
+
+  nanoarrow::UniqueSchema schema;
+  ArrowSchemaInit(schema.get());
+  ASSERT_EQ(ArrowSchemaSetFormat(schema.get(), "+l"), NANOARROW_OK);
+  ASSERT_EQ(ArrowSchemaAllocateChildren(schema.get(), 1), NANOARROW_OK);
+  MakeTestUnionSchema(schema->children[0], nullptr);
+
+  ArrowBuffer metadata;
+  ASSERT_EQ(ArrowMetadataBuilderInit(&metadata, nullptr), NANOARROW_OK);
+  ASSERT_EQ(ArrowMetadataBuilderAppend(&metadata, ArrowCharView("ARROW:extension:name"),
+                                       ArrowCharView("geoarrow.geometrycollection")),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowSchemaSetMetadata(schema.get(), reinterpret_cast<char*>(metadata.data)),
+            NANOARROW_OK);
+  ArrowBufferReset(&metadata);
+
+  nanoarrow::UniqueArray parts;
+  MakeTestUnionArray(handle.handle, parts.get());
+
+  // [parts 0-1], null (with a non-empty slot), [], [parts 3-4]
+  std::vector<uint8_t> validity = {0x0d};
+  std::vector<int32_t> offsets = {0, 2, 3, 3, 5};
+  nanoarrow::UniqueArray array;
+  MakeTestArray(array.get(), 4, 1, {validity, TestBuffer(offsets)}, {parts.get()});
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromSchema(handle.handle, schema.get()), GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(4);
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Read(array.get(), 0, 4, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  EXPECT_EQ(n_out, 4);
+  ExpectGeometriesEqualWKT(
+      handle.handle, geoms_out.mutable_data(),
+      {"GEOMETRYCOLLECTION (POINT (0 1), LINESTRING Z (0 1 2, 3 4 5))", "",
+       "GEOMETRYCOLLECTION EMPTY",
+       "GEOMETRYCOLLECTION (POINT (2 3), LINESTRING Z EMPTY)"});
+
+  // Null members of a collection can't be represented by GEOS
+  offsets = {0, 3, 3, 3, 3};
+  nanoarrow::UniqueArray parts2;
+  MakeTestUnionArray(handle.handle, parts2.get());
+  nanoarrow::UniqueArray array2;
+  MakeTestArray(array2.get(), 4, 1, {validity, TestBuffer(offsets)}, {parts2.get()});
+  EXPECT_EQ(reader.Read(array2.get(), 0, 1, geoms_out.mutable_data(), &n_out), EINVAL);
+  EXPECT_EQ(std::string(reader.GetLastError()).substr(0, 3), "[0]");
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderNativeSingleToMulti) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::vector<std::string>> cases = {
+      {"POINT (0 1)", "MULTIPOINT ((0 1))", "MULTIPOINT ((0 1), (2 3))"},
+      {"LINESTRING (0 1, 2 3)", "MULTILINESTRING ((0 1, 2 3))",
+       "MULTILINESTRING ((0 1, 2 3), (4 5, 6 7))"},
+      {"POLYGON ((0 0, 1 0, 0 1, 0 0))", "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)))",
+       "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)), ((10 10, 11 10, 10 11, 10 10)))"}};
+
+  for (const auto& wkt : cases) {
+    int wkb_type = wkt[0].substr(0, 5) == "POINT" ? 4 : (wkt[0][0] == 'L' ? 5 : 6);
+    for (auto encoding :
+         {GEOARROW_GEOS_ENCODING_GEOARROW, GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED}) {
+      geoarrow::geos::GeometryVector geoms_in(handle.handle);
+      geoms_in.resize(4);
+      ASSERT_EQ(wkt_reader.Read(wkt[0], geoms_in.mutable_data() + 0), GEOARROW_GEOS_OK);
+      ASSERT_EQ(wkt_reader.Read(wkt[2], geoms_in.mutable_data() + 2), GEOARROW_GEOS_OK);
+
+      geoarrow::geos::ArrayBuilder builder;
+      ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, wkb_type),
+                GEOARROW_GEOS_OK);
+      size_t n = 0;
+      ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK)
+          << builder.GetLastError();
+      nanoarrow::UniqueArray array;
+      ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+      ASSERT_EQ(array->length, 4);
+      EXPECT_EQ(array->null_count, 2);
+
+      geoarrow::geos::ArrayReader reader;
+      ASSERT_EQ(reader.InitFromEncoding(handle.handle, encoding, wkb_type),
+                GEOARROW_GEOS_OK);
+      geoarrow::geos::GeometryVector geoms_out(handle.handle);
+      geoms_out.resize(4);
+      size_t n_out = 0;
+      ASSERT_EQ(reader.Read(array.get(), 0, 4, geoms_out.mutable_data(), &n_out),
+                GEOARROW_GEOS_OK)
+          << reader.GetLastError();
+
+      geoarrow::geos::GeometryVector expected(handle.handle);
+      expected.resize(2);
+      ASSERT_EQ(wkt_reader.Read(wkt[1], expected.mutable_data() + 0), GEOARROW_GEOS_OK);
+      ASSERT_EQ(wkt_reader.Read(wkt[2], expected.mutable_data() + 1), GEOARROW_GEOS_OK);
+      EXPECT_EQ(
+          GEOSEqualsExact_r(handle.handle, geoms_out.borrow(0), expected.borrow(0), 0),
+          1)
+          << wkt[0];
+      EXPECT_EQ(geoms_out.borrow(1), nullptr);
+      EXPECT_EQ(
+          GEOSEqualsExact_r(handle.handle, geoms_out.borrow(2), expected.borrow(1), 0),
+          1)
+          << wkt[2];
+      EXPECT_EQ(geoms_out.borrow(3), nullptr);
+    }
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderVerifyWKB) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"POINT (0 1)",
+                                  "POINT EMPTY",
+                                  "",
+                                  "POINT Z (0 1 2)",
+                                  "LINESTRING (0 1, 2 3)",
+                                  "LINESTRING Z EMPTY",
+                                  "POLYGON ((0 0, 1 0, 0 1, 0 0), (0.1 0.1, 0.2 0.1, "
+                                  "0.1 0.2, 0.1 0.1))",
+                                  "POLYGON EMPTY",
+                                  "MULTIPOINT Z ((0 1 2), (3 4 5))",
+                                  "MULTILINESTRING ((0 1, 2 3), (4 5, 6 7))",
+                                  "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)))",
+                                  "GEOMETRYCOLLECTION (POINT (0 1), LINESTRING (0 1, "
+                                  "2 3))",
+                                  "GEOMETRYCOLLECTION EMPTY"};
+
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i] != "") {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
+  }
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKB),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.SetVerifyWKB(true), GEOARROW_GEOS_OK);
+
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK)
+      << builder.GetLastError();
+  EXPECT_EQ(builder.SetVerifyWKB(false), EINVAL);
+
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK) << builder.GetLastError();
+  ASSERT_EQ(array->length, static_cast<int64_t>(wkt.size()));
+  EXPECT_EQ(array->null_count, 1);
+
+  geoarrow::geos::ArrayReader reader;
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKB),
+            GEOARROW_GEOS_OK);
+  geoarrow::geos::GeometryVector geoms_out(handle.handle);
+  geoms_out.resize(wkt.size());
+  size_t n_out = 0;
+  ASSERT_EQ(reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(), &n_out),
+            GEOARROW_GEOS_OK)
+      << reader.GetLastError();
+  ASSERT_EQ(n_out, wkt.size());
+
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i] == "") {
+      EXPECT_EQ(geoms_out.borrow(i), nullptr);
+    } else if (wkt[i] != "POINT EMPTY") {
+      EXPECT_EQ(
+          GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i), geoms_in.borrow(i), 0), 1)
+          << wkt[i];
+    }
+  }
+
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(builder.SetVerifyWKB(true), EINVAL);
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderLargeOffsets) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {
+      "MULTIPOLYGON (((30 20, 45 40, 10 40, 30 20)), ((15 5, 40 10, 10 20, 5 10, 15 5)))",
+      "", "MULTIPOLYGON EMPTY", "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)))"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms_in.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  for (auto encoding :
+       {GEOARROW_GEOS_ENCODING_GEOARROW, GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED,
+        GEOARROW_GEOS_ENCODING_WKB, GEOARROW_GEOS_ENCODING_WKT}) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 6), GEOARROW_GEOS_OK);
+    EXPECT_EQ(builder.SetLargeOffsets(static_cast<GeoArrowGEOSLargeOffsets>(100)),
+              EINVAL);
+
+    // Nothing here would overflow, so AUTO should give 32-bit offsets
+    ASSERT_EQ(builder.SetLargeOffsets(GEOARROW_GEOS_LARGE_OFFSETS_AUTO),
+              GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK);
+    nanoarrow::UniqueSchema schema;
+    ASSERT_EQ(builder.GetSchema(schema.get()), GEOARROW_GEOS_OK);
+    EXPECT_EQ(std::string(schema->format).find_first_of("ZUL"), std::string::npos);
+    schema.reset();
+
+    ASSERT_EQ(builder.SetLargeOffsets(GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS),
+              GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.GetSchema(schema.get()), GEOARROW_GEOS_OK);
+    EXPECT_TRUE(std::string(schema->format) == "Z" ||
+                std::string(schema->format) == "U" ||
+                std::string(schema->format) == "+L")
+        << schema->format;
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK) << builder.GetLastError();
+    ASSERT_EQ(array->length, wkt.size());
+    EXPECT_EQ(array->null_count, 1);
+
+    geoarrow::geos::ArrayReader reader;
+    ASSERT_EQ(reader.InitFromSchema(handle.handle, schema.get()), GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    geoarrow::geos::GeometryVector geoms_out(handle.handle);
+    geoms_out.resize(wkt.size());
+    size_t n_out = 0;
+    ASSERT_EQ(
+        reader.Read(array.get(), 0, array->length, geoms_out.mutable_data(), &n_out),
+        GEOARROW_GEOS_OK)
+        << reader.GetLastError();
+    ASSERT_EQ(n_out, wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      if (geoms_in.borrow(i) == nullptr || geoms_out.borrow(i) == nullptr) {
+        EXPECT_EQ(geoms_out.borrow(i), geoms_in.borrow(i));
+      } else {
+        EXPECT_EQ(GEOSEqualsExact_r(handle.handle, geoms_out.borrow(i),
+                                    geoms_in.borrow(i), 0),
+                  1)
+            << "WKT: " << wkt[i] << " with encoding " << encoding;
+      }
+    }
+
+    // A builder created from a large schema produces large output
+    geoarrow::geos::ArrayBuilder builder2;
+    ASSERT_EQ(builder2.InitFromSchema(handle.handle, schema.get()), GEOARROW_GEOS_OK)
+        << builder2.GetLastError();
+    nanoarrow::UniqueSchema schema2;
+    ASSERT_EQ(builder2.GetSchema(schema2.get()), GEOARROW_GEOS_OK);
+    EXPECT_STREQ(schema2->format, schema->format);
+  }
+}
+
+TEST_P(EncodingTestFixture, TestArrayBuilderMultiChunk) {
+  GeoArrowGEOSEncoding encoding = GetParam();
+
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {
+      "MULTIPOLYGON (((30 20, 45 40, 10 40, 30 20)), ((15 5, 40 10, 10 20, 5 10, 15 5), "
+      "(20 10, 25 10, 20 15, 20 10)))",
+      "", "MULTIPOLYGON EMPTY", "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)))"};
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(20);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    if (wkt[i % wkt.size()] != "") {
+      ASSERT_EQ(wkt_reader.Read(wkt[i % wkt.size()], geoms_in.mutable_data() + i),
+                GEOARROW_GEOS_OK);
+    }
+  }
+
+  auto build = [&](GeoArrowGEOSLargeOffsets large_offsets, int64_t max_rows,
+                   int64_t max_offset, ArrowSchema* schema, ArrowArray* array) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 6), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetLargeOffsets(large_offsets), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetChunkSize(max_rows), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetMaxOffset(max_offset), GEOARROW_GEOS_OK);
+    size_t n = 0;
+    ASSERT_EQ(builder.Append(geoms_in.data(), geoms_in.size(), &n), GEOARROW_GEOS_OK)
+        << builder.GetLastError();
+    ASSERT_EQ(builder.GetSchema(schema), GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.Finish(array), GEOARROW_GEOS_OK) << builder.GetLastError();
+  };
+
+  // Everything in one chunk with 32-bit offsets
+  nanoarrow::UniqueSchema expected_schema;
+  nanoarrow::UniqueArray expected;
+  build(GEOARROW_GEOS_LARGE_OFFSETS_NEVER, 0, INT32_MAX, expected_schema.get(),
+        expected.get());
+  ASSERT_EQ(expected->length, 20);
+  EXPECT_EQ(expected->null_count, 5);
+
+  // Chunks of three features concatenated with 32-bit and with 64-bit offsets
+  for (auto large_offsets : {GEOARROW_GEOS_LARGE_OFFSETS_NEVER,
+                             GEOARROW_GEOS_LARGE_OFFSETS_AUTO,
+                             GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS}) {
+    SCOPED_TRACE("large_offsets " + std::to_string(large_offsets));
+    nanoarrow::UniqueSchema schema;
+    nanoarrow::UniqueArray array;
+    build(large_offsets, 3, INT32_MAX, schema.get(), array.get());
+    bool large = std::string(schema->format).find_first_of("ZUL") != std::string::npos;
+    EXPECT_EQ(large, large_offsets == GEOARROW_GEOS_LARGE_OFFSETS_ALWAYS)
+        << schema->format;
+    ExpectArraysEqual(schema.get(), array.get(), expected_schema.get(), expected.get());
+  }
+
+  // With a small max offset, AUTO seals chunks before it would be exceeded and
+  // switches to 64-bit offsets while NEVER fails
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+  build(GEOARROW_GEOS_LARGE_OFFSETS_AUTO, 0, 64, schema.get(), array.get());
+  EXPECT_NE(std::string(schema->format).find_first_of("ZUL"), std::string::npos)
+      << schema->format;
+  ExpectArraysEqual(schema.get(), array.get(), expected_schema.get(), expected.get());
+
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding, 6), GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.SetLargeOffsets(GEOARROW_GEOS_LARGE_OFFSETS_NEVER),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.SetMaxOffset(64), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  GeoArrowGEOSErrorCode result = builder.Append(geoms_in.data(), geoms_in.size(), &n);
+  if (result == GEOARROW_GEOS_OK) {
+    array.reset();
+    result = builder.Finish(array.get());
+  }
+  EXPECT_EQ(result, EOVERFLOW);
+  EXPECT_EQ(builder.SetMaxOffset(0), EINVAL);
+}
+
+TEST(GeoArrowGEOSTest, TestArrayBuilderMaxOffsetExact) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  geoarrow::geos::GeometryVector geoms_in(handle.handle);
+  geoms_in.resize(3);
+  for (size_t i = 0; i < geoms_in.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read("POINT (0 1)", geoms_in.mutable_data() + i),
+              GEOARROW_GEOS_OK);
+  }
+
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray expected;
+  geoarrow::geos::ArrayBuilder expected_builder;
+  ASSERT_EQ(expected_builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(expected_builder.Append(geoms_in.data(), geoms_in.size(), &n),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(expected_builder.GetSchema(schema.get()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(expected_builder.Finish(expected.get()), GEOARROW_GEOS_OK);
+  int64_t size = reinterpret_cast<const int32_t*>(expected->buffers[1])[3];
+
+  // The bound on the size of WKT output is much larger than what is written, but
+  // only the exact size of the output decides whether it overflows
+  for (int64_t max_offset : {size, size - 1}) {
+    geoarrow::geos::ArrayBuilder builder;
+    ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+              GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetLargeOffsets(GEOARROW_GEOS_LARGE_OFFSETS_NEVER),
+              GEOARROW_GEOS_OK);
+    ASSERT_EQ(builder.SetMaxOffset(max_offset), GEOARROW_GEOS_OK);
+    GeoArrowGEOSErrorCode result = builder.Append(geoms_in.data(), geoms_in.size(), &n);
+    nanoarrow::UniqueArray array;
+    if (result == GEOARROW_GEOS_OK) {
+      result = builder.Finish(array.get());
+    }
+
+    if (max_offset == size) {
+      ASSERT_EQ(result, GEOARROW_GEOS_OK) << builder.GetLastError();
+      ExpectArraysEqual(schema.get(), array.get(), expected.get());
+    } else {
+      EXPECT_EQ(result, EOVERFLOW);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(GeoArrowGEOSTest, EncodingTestFixture,
+                         ::testing::Values(GEOARROW_GEOS_ENCODING_GEOARROW,
+                                           GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED,
+                                           GEOARROW_GEOS_ENCODING_WKB,
+                                           GEOARROW_GEOS_ENCODING_WKT,
+                                           GEOARROW_GEOS_ENCODING_LARGE_WKB,
+                                           GEOARROW_GEOS_ENCODING_LARGE_WKT));
+
+TEST(GeoArrowGEOSTest, TestHppGeometryVector) {
+  GEOSCppHandle handle;
+  geoarrow::geos::GeometryVector geom(handle.handle);
+
+  geom.reserve(3);
+  geom.resize(3);
+  ASSERT_EQ(geom.size(), 3);
+  ASSERT_EQ(geom.borrow(0), nullptr);
+  ASSERT_EQ(geom.borrow(1), nullptr);
+  ASSERT_EQ(geom.borrow(2), nullptr);
+
+  geom.set(0, GEOSGeom_createEmptyPolygon_r(handle.handle));
+  geom.set(1, GEOSGeom_createEmptyLineString_r(handle.handle));
+  geom.set(2, GEOSGeom_createEmptyPoint_r(handle.handle));
+
+  geom.resize(2);
+  geom.resize(3);
+  ASSERT_NE(geom.borrow(0), nullptr);
+  ASSERT_NE(geom.borrow(1), nullptr);
+  ASSERT_EQ(geom.borrow(2), nullptr);
+
+  GEOSGeometry* geom1 = geom.take_ownership_of(1);
+  ASSERT_NE(geom1, nullptr);
+  GEOSGeom_destroy_r(handle.handle, geom1);
+  ASSERT_EQ(geom.borrow(1), nullptr);
+
+  geoarrow::geos::GeometryVector other = std::move(geom);
+  ASSERT_EQ(geom.size(), 0);
+  ASSERT_EQ(other.size(), 3);
+  ASSERT_NE(other.borrow(0), nullptr);
+  ASSERT_EQ(other.borrow(1), nullptr);
+  ASSERT_EQ(other.borrow(2), nullptr);
+}
+
+TEST(GeoArrowGEOSTest, TestHppArrayBuilder) {
+  GEOSCppHandle handle;
+  geoarrow::geos::ArrayBuilder builder;
+  EXPECT_STREQ(builder.GetLastError(), "");
+
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_UNKNOWN),
+            EINVAL);
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  EXPECT_STREQ(builder.GetLastError(), "");
+
+  geoarrow::geos::ArrayBuilder builder2 = std::move(builder);
+  nanoarrow::UniqueArray array;
+  builder2.Finish(array.get());
+  ASSERT_EQ(array->length, 0);
+  ASSERT_EQ(array->n_buffers, 3);
+}
+
+TEST(GeoArrowGEOSTest, TestHppArrayReader) {
+  GEOSCppHandle handle;
+  geoarrow::geos::ArrayReader reader;
+  EXPECT_STREQ(reader.GetLastError(), "");
+
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_UNKNOWN),
+            EINVAL);
+  ASSERT_EQ(reader.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKT),
+            GEOARROW_GEOS_OK);
+  EXPECT_STREQ(reader.GetLastError(), "");
+
+  geoarrow::geos::ArrayReader reader2 = std::move(reader);
+}
+
+GeoArrowGEOSErrorCode SchemaFromWkbType(const std::vector<int32_t>& wkb_type,
+                                        enum GeoArrowGEOSEncoding encoding,
+                                        ArrowSchema* out) {
+  geoarrow::geos::SchemaCalculator calc;
+  calc.Ingest(wkb_type.data(), wkb_type.size());
+
+  return calc.Finish(encoding, out);
+}
+
+GeoArrowGEOSErrorCode SchemaFromWKT(const std::vector<std::string>& wkt,
+                                    enum GeoArrowGEOSEncoding encoding,
+                                    ArrowSchema* out) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+  geoarrow::geos::GeometryVector geom(handle.handle);
+  geom.resize(wkt.size());
+  std::vector<int32_t> wkb_type(wkt.size());
+
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i] == "") {
+      wkb_type[i] = 0;
+      continue;
+    }
+
+    wkt_reader.Read(wkt[i], geom.mutable_data() + i);
+    wkb_type[i] = GeoArrowGEOSWKBType(handle.handle, geom.borrow(i));
+  }
+
+  return SchemaFromWkbType(wkb_type, encoding, out);
+}
+
+std::string SchemaExtensionName(ArrowSchema* schema) {
+  ArrowStringView value;
+  value.data = "";
+  value.size_bytes = 0;
+  ArrowMetadataGetValue(schema->metadata, ArrowCharView("ARROW:extension:name"), &value);
+  return std::string(value.data, value.size_bytes);
+}
+
+std::string SchemaExtensionDims(ArrowSchema* schema) {
+  if (std::string(schema->format) == "+l") {
+    return SchemaExtensionDims(schema->children[0]);
+  }
+
+  std::stringstream ss;
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    ss << schema->children[i]->name;
+  }
+
+  return ss.str();
+}
+
+TEST(GeoArrowGEOSTest, TestWKBTypes) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {"POINT (0 1)",
+                                  "",
+                                  "POINT EMPTY",
+                                  "LINESTRING Z (0 1 2, 3 4 5)",
+                                  "POLYGON EMPTY",
+                                  "MULTIPOLYGON (((0 0, 1 0, 0 1, 0 0)))",
+                                  "GEOMETRYCOLLECTION (POINT EMPTY)",
+                                  "GEOMETRYCOLLECTION (POINT EMPTY, POINT (0 1))"};
+  std::vector<int32_t> expected = {1, 0, 0, 2002, 0, 6, 0, 7};
+
+  geoarrow::geos::GeometryVector geoms(handle.handle);
+  geoms.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    if (wkt[i] != "") {
+      ASSERT_EQ(wkt_reader.Read(wkt[i], geoms.mutable_data() + i), GEOARROW_GEOS_OK);
+    }
+
+    EXPECT_EQ(GeoArrowGEOSWKBType(handle.handle, geoms.borrow(i)), expected[i]) << wkt[i];
+  }
+
+  for (int n_threads : {1, 3, 100}) {
+    std::vector<int32_t> actual(wkt.size(), -1);
+    ASSERT_EQ(GeoArrowGEOSWKBTypes(handle.handle, geoms.data(), geoms.size(), n_threads,
+                                   actual.data()),
+              GEOARROW_GEOS_OK);
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+TEST(GeoArrowGEOSTest, TestSchemaCalcEmpty) {
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_UNKNOWN, schema.get()), EINVAL);
+
+  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_WKT, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkt");
+
+  schema.reset();
+  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_WKB, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+
+  schema.reset();
+  ASSERT_EQ(SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({}, GEOARROW_GEOS_ENCODING_GEOARROW_INTERLEAVED, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+}
+
+TEST(GeoArrowGEOSTest, TestSchemaCalcStats) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::string> wkt = {
+      "POINT (0 1)",
+      "",
+      "POINT EMPTY",
+      "LINESTRING (0 1, 2 3)",
+      "POLYGON ((0 0, 1 0, 0 1, 0 0), (0.1 0.1, 0.2 0.1, 0.1 0.2, 0.1 0.1))",
+      "MULTIPOINT ((0 1), (2 3))",
+      "GEOMETRYCOLLECTION (POINT Z (0 1 2))"};
+  geoarrow::geos::GeometryVector geoms(handle.handle);
+  geoms.resize(wkt.size());
+  for (size_t i = 0; i < wkt.size(); i++) {
+    ASSERT_EQ(wkt_reader.Read(wkt[i], geoms.mutable_data() + i), GEOARROW_GEOS_OK);
+  }
+
+  geoarrow::geos::SchemaCalculator calc;
+  calc.IngestGeometry(handle.handle, geoms.data(), geoms.size());
+  EXPECT_EQ(calc.GetStats().n_features, 0);
+
+  geoarrow::geos::SchemaCalculator calc_stats;
+  calc_stats.SetCollectStats(true);
+  calc_stats.IngestGeometry(handle.handle, geoms.data(), geoms.size());
+  GeoArrowGEOSSizeStats stats = calc_stats.GetStats();
+  EXPECT_EQ(stats.n_features, 7);
+  EXPECT_EQ(stats.n_null, 1);
+  EXPECT_EQ(stats.n_parts, 7);
+  EXPECT_EQ(stats.n_rings, 2);
+  EXPECT_EQ(stats.n_coords, 15);
+  EXPECT_EQ(stats.wkb_size, 21 + 21 + 41 + 145 + 51 + 38);
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(calc_stats.Finish(GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            GEOARROW_GEOS_OK);
+  EXPECT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+
+  // A builder that reserved exactly produces the same output
+  geoarrow::geos::ArrayBuilder builder;
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_WKB),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.Reserve(stats), GEOARROW_GEOS_OK);
+  size_t n = 0;
+  ASSERT_EQ(builder.Append(geoms.data(), geoms.size(), &n), GEOARROW_GEOS_OK);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(array->length, 7);
+  EXPECT_EQ(array->null_count, 1);
+  EXPECT_EQ(reinterpret_cast<const int32_t*>(array->buffers[1])[7], stats.wkb_size);
+
+  // ...including native output
+  geoarrow::geos::SchemaCalculator calc_polygons;
+  calc_polygons.SetCollectStats(true);
+  calc_polygons.IngestGeometry(handle.handle, geoms.data() + 4, 1);
+  ASSERT_EQ(builder.InitFromEncoding(handle.handle, GEOARROW_GEOS_ENCODING_GEOARROW, 6),
+            GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.Reserve(calc_polygons.GetStats()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(builder.Append(geoms.data() + 4, 1, &n), GEOARROW_GEOS_OK);
+  array.reset();
+  ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+  ASSERT_EQ(array->length, 1);
+  ASSERT_EQ(array->children[0]->length, 1);
+  ASSERT_EQ(array->children[0]->children[0]->length, 2);
+  EXPECT_EQ(array->children[0]->children[0]->children[0]->length, 8);
+}
+
+TEST(GeoArrowGEOSTest, TestSchemaCalcZM) {
+  nanoarrow::UniqueSchema schema;
+
+  ASSERT_EQ(SchemaFromWkbType({1, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+
+  schema.reset();
+  ASSERT_EQ(SchemaFromWkbType({2001, 1}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({2001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+
+  schema.reset();
+  ASSERT_EQ(SchemaFromWkbType({1, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+
+  schema.reset();
+  ASSERT_EQ(SchemaFromWkbType({3001, 1}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({3001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({3001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xym");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({2001, 3001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({3001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({2001, 4001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
+
+  schema.reset();
+  ASSERT_EQ(
+      SchemaFromWkbType({4001, 2001}, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+      NANOARROW_OK);
+  ASSERT_EQ(SchemaExtensionName(schema.get()), "geoarrow.point");
   EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
 
   schema.reset();
@@ -572,6 +2670,110 @@ TEST(GeoArrowGEOSTest, TestSchemaCalcZM) {
   EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyzm");
 }
 
+TEST(GeoArrowGEOSTest, TestSchemaCalcLongRuns) {
+  nanoarrow::UniqueSchema schema;
+
+  // A single change after long runs of one type and nulls is still seen
+  std::vector<int32_t> wkb_type(1000, 2);
+  for (size_t i = 0; i < wkb_type.size(); i += 3) {
+    wkb_type[i] = 0;
+  }
+
+  wkb_type[998] = 5;
+  ASSERT_EQ(SchemaFromWkbType(wkb_type, GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()),
+            NANOARROW_OK);
+  EXPECT_EQ(SchemaExtensionName(schema.get()), "geoarrow.multilinestring");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xy");
+
+  // Once the result is GEOMETRY/XYZM it can't change
+  wkb_type[1] = 1;
+  wkb_type[2] = 4003;
+  schema.reset();
+  geoarrow::geos::SchemaCalculator calc;
+  calc.Ingest(wkb_type.data(), wkb_type.size());
+  calc.Ingest(wkb_type.data(), wkb_type.size());
+  ASSERT_EQ(calc.Finish(GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()), NANOARROW_OK);
+  EXPECT_EQ(SchemaExtensionName(schema.get()), "geoarrow.wkb");
+}
+
+TEST(GeoArrowGEOSTest, TestSchemaCalcMerge) {
+  geoarrow::geos::SchemaCalculator points;
+  std::vector<int32_t> point_types = {1, 0, 2001};
+  points.Ingest(point_types.data(), point_types.size());
+
+  geoarrow::geos::SchemaCalculator multipoints;
+  std::vector<int32_t> multipoint_types = {4, 4};
+  multipoints.Ingest(multipoint_types.data(), multipoint_types.size());
+
+  // Merging in memory and through the serialized state are equivalent
+  geoarrow::geos::SchemaCalculator merged;
+  merged.Merge(points);
+  ASSERT_EQ(merged.MergeState(multipoints.GetState()), GEOARROW_GEOS_OK);
+
+  nanoarrow::UniqueSchema schema;
+  ASSERT_EQ(merged.Finish(GEOARROW_GEOS_ENCODING_GEOARROW, schema.get()), NANOARROW_OK);
+  EXPECT_EQ(SchemaExtensionName(schema.get()), "geoarrow.multipoint");
+  EXPECT_EQ(SchemaExtensionDims(schema.get()), "xyz");
+
+  std::vector<uint8_t> state = merged.GetState();
+  ASSERT_EQ(state.size(), GEOARROW_GEOS_SCHEMA_CALCULATOR_STATE_SIZE);
+  EXPECT_EQ(points.MergeState(std::vector<uint8_t>(state.begin(), state.end() - 1)),
+            EINVAL);
+  state[0] = 0xff;
+  EXPECT_EQ(points.MergeState(state), EINVAL);
+}
+
+TEST(GeoArrowGEOSTest, TestSchemaCalcIngestArray) {
+  GEOSCppHandle handle;
+  GEOSCppWKTReader wkt_reader(handle.handle);
+
+  std::vector<std::vector<std::string>> cases = {
+      {"POINT (0 1)", "", "POINT EMPTY", "MULTIPOINT (0 1, 2 3)"},
+      {"LINESTRING Z (0 1 2, 3 4 5)", "LINESTRING EMPTY", "LINESTRING (0 1, 2 3)"},
+      {"POLYGON ((0 0, 1 0, 0 1, 0 0))", "GEOMETRYCOLLECTION (POINT EMPTY)"},
+      {"POINT (0 1)", "LINESTRING (0 1, 2 3)"},
+      {"", "GEOMETRYCOLLECTION EMPTY"}};
+
+  for (const auto& wkt : cases) {
+    geoarrow::geos::GeometryVector geoms(handle.handle);
+    geoms.resize(wkt.size());
+    for (size_t i = 0; i < wkt.size(); i++) {
+      if (wkt[i] != "") {
+        ASSERT_EQ(wkt_reader.Read(wkt[i], geoms.mutable_data() + i), GEOARROW_GEOS_OK);
+      }
+    }
+
+    nanoarrow::UniqueSchema expected;
+    ASSERT_EQ(SchemaFromWKT(wkt, GEOARROW_GEOS_ENCODING_GEOARROW, expected.get()),
+              NANOARROW_OK);
+
+    for (auto encoding : {GEOARROW_GEOS_ENCODING_WKB, GEOARROW_GEOS_ENCODING_WKT,
+                          GEOARROW_GEOS_ENCODING_LARGE_WKB,
+                          GEOARROW_GEOS_ENCODING_LARGE_WKT}) {
+      geoarrow::geos::ArrayBuilder builder;
+      ASSERT_EQ(builder.InitFromEncoding(handle.handle, encoding), GEOARROW_GEOS_OK);
+
+      size_t n = 0;
+      ASSERT_EQ(builder.Append(geoms.data(), geoms.size(), &n), GEOARROW_GEOS_OK);
+      nanoarrow::UniqueArray array;
+      ASSERT_EQ(builder.Finish(array.get()), GEOARROW_GEOS_OK);
+
+      geoarrow::geos::SchemaCalculator calc;
+      ASSERT_EQ(calc.IngestArray(encoding, array.get(), 2), GEOARROW_GEOS_OK);
+      nanoarrow::UniqueSchema actual;
+      ASSERT_EQ(calc.Finish(GEOARROW_GEOS_ENCODING_GEOARROW, actual.get()), NANOARROW_OK);
+      EXPECT_EQ(SchemaExtensionName(actual.get()), SchemaExtensionName(expected.get()))
+          << wkt[0] << " encoding " << encoding;
+      EXPECT_EQ(SchemaExtensionDims(actual.get()), SchemaExtensionDims(expected.get()))
+          << wkt[0] << " encoding " << encoding;
+    }
+  }
+
+  geoarrow::geos::SchemaCalculator calc;
+  nanoarrow::UniqueArray array;
+  EXPECT_EQ(calc.IngestArray(GEOARROW_GEOS_ENCODING_GEOARROW, array.get()), EINVAL);
+}
+
 class SchemaCalcFixture : public ::testing::TestWithParam<std::vector<std::string>> {
  protected:
   std::vector<std::string> params;